@@ -1,20 +1,30 @@
 #ifndef AMBULANCE_DISPATCHER_HPP
 #define AMBULANCE_DISPATCHER_HPP
-#define MAX_SHIFTS 1000
+#define DEFAULT_SHIFT_HOURS 8     // Used by rotation when an ambulance has no shift duration
+#define MAX_ROTATION_DAYS 28
+#define MAX_LISTED_GAPS 50
+#define MAX_REPORT_DAYS 366
+#define SHIFT_ID_BASE 2000     // Generated shift IDs start above SHIFT-2000
 #include <iostream>
 #include <string>
 #include "entities.hpp"
+#include "fleet_registry.hpp"
+#include "shift_log.hpp"
+#include "shift_schedule.hpp"
 
 class AmbulanceDispatcher {
 private:
-    static const int MAX_AMBULANCES = 20; // Adjust based on dataset size
-    Ambulance ambulanceQueue[MAX_AMBULANCES]; // circular queue of active-duty ambulances
-    int front; // front index of queue
-    int rear;  // rear index of queue
-    int count; // number of ambulances in queue
+    std::string scheduleFile; // ambulance_schedule.csv in the data root
+    std::string shiftFile;    // shift_history.csv in the data root
 
-    ShiftRecord shiftRecords[MAX_AMBULANCES]; // store shift history if needed
-    int shiftCount;
+    FleetRegistry fleet; // active-duty ambulances in rotation order, indexed by ambulance ID
+
+    ShiftLog shifts; // append-only shift history
+
+    ShiftSchedule schedule; // Interval tree over the shifts still in force, for coverage queries
+
+    bool scheduleDirty; // Schedule changed since it was loaded or saved
+    bool shiftsDirty;   // Shift dataset changed since it was loaded or saved
 
 public:
     AmbulanceDispatcher();
@@ -28,11 +38,25 @@ private:
     void displaySchedule();
     void updateShift();
     void viewInventory();
-    int findAmbulanceIndex(const std::string& id); // helper for updating shifts
+    void showOnDutyAt();
+    void showCoverageGaps();
+    void displayShiftReportsMenu();
+    void reportShiftsByAmbulance();
+    void reportShiftsByDriver();
+    void reportShiftsByDay();
+    void reportFleetUtilization();
+    bool promptReportRange(long long& from, long long& to);
+    void rebuildShiftSchedule();
+    void cancelScheduledShiftsFrom(long long start);
+    void addShiftRecord(Ambulance& amb, long long start, long long end, long long shiftNumber);
+    void appendLoadedShift(const ShiftRecord& sr);
+    void addLoadedAmbulance(const Ambulance& amb);
     void loadScheduleFromCSV(const std::string& filename);
     void loadShiftDatasetFromCSV(const std::string& filename);
     void saveScheduleToCSV(const std::string& filename);
     void saveShiftDatasetToCSV(const std::string& filename);
+    void saveScheduleSnapshot(const std::string& filename, unsigned long long csvSize);
+    void saveShiftSnapshot(const std::string& filename, unsigned long long csvSize);
 };
 
 #endif
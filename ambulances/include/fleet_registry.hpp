@@ -0,0 +1,90 @@
+#ifndef FLEET_REGISTRY_HPP
+#define FLEET_REGISTRY_HPP
+
+#include <string>
+#include "entities.hpp"
+#include "hash_map.hpp"
+
+/**
+ * @struct AmbulanceHandle
+ * @brief Stable reference to a registered ambulance, survives growth and other removals
+ */
+struct AmbulanceHandle {
+    int slot = -1;
+    unsigned int generation = 0;
+};
+
+/**
+ * @brief Growable registry of the ambulance fleet
+ *
+ * @details
+ * - A slot map: ambulances live in a slot array that doubles when full, removed slots are
+ *   reused through a free list and get a new generation, so stale handles are detected
+ * - Registration order (the rotation order) is kept in a separate array of slot indices
+ * - ambulance_id is indexed in a hash map, lookups by ID cost O(1)
+ * - Pointers returned by get()/find() are invalidated by add(), handles are not
+ *
+ * @usage
+ *      FleetRegistry fleet;
+ *      AmbulanceHandle handle = fleet.add(amb);
+ *      if (Ambulance* found = fleet.find("AMB001")) { ... }
+ *      for (int i = 0; i < fleet.getCount(); i++) { Ambulance& amb = fleet.at(i); ... }
+ */
+class FleetRegistry {
+private:
+    struct Slot {
+        Ambulance ambulance;
+        unsigned int generation = 0;
+        int position = -1;  /// Index in order, -1 while the slot is free
+        int nextFree = -1;
+    };
+
+    Slot* slots;
+    int slotCapacity;
+    int slotsUsed;      /// Slots ever handed out, free ones included
+    int freeHead;       /// First reusable slot, -1 if none
+
+    int* order;         /// Slot indices in registration order
+    int count;
+    int orderCapacity;
+
+    StringHashMap<AmbulanceHandle> byId;
+
+    void growSlots();
+    void growOrder();
+
+public:
+    FleetRegistry();
+    ~FleetRegistry();
+
+    FleetRegistry(const FleetRegistry&) = delete;
+    FleetRegistry& operator=(const FleetRegistry&) = delete;
+
+    /**
+     * @brief Registers an ambulance at the end of the rotation order
+     * @return Its handle, or an invalid handle (slot -1) if the ID is empty or already registered
+     */
+    AmbulanceHandle add(const Ambulance& amb);
+
+    /**
+     * @brief Unregisters an ambulance, the rest keep their order and handles
+     * @return true if the handle was still valid
+     */
+    bool remove(AmbulanceHandle handle);
+
+    Ambulance* get(AmbulanceHandle handle);
+    Ambulance* find(const std::string& ambulanceId);
+    AmbulanceHandle findHandle(const std::string& ambulanceId) const;
+    bool contains(const std::string& ambulanceId) const { return byId.contains(ambulanceId); }
+
+    /**
+     * @brief The ambulance at a position of the rotation order, 0 <= position < getCount()
+     */
+    Ambulance& at(int position) { return slots[order[position]].ambulance; }
+    const Ambulance& at(int position) const { return slots[order[position]].ambulance; }
+
+    int getCount() const { return count; }
+    void clear();
+};
+
+#endif // FLEET_REGISTRY_HPP
@@ -0,0 +1,155 @@
+#ifndef SHIFT_LOG_HPP
+#define SHIFT_LOG_HPP
+
+#include <string>
+#include "entities.hpp"
+#include "hash_map.hpp"
+
+#define SHIFT_STATUS_CANCELLED "Cancelled"
+
+/**
+ * @struct ShiftRollup
+ * @brief Running totals over a group of shifts, averages are totals divided by shifts
+ */
+struct ShiftRollup {
+    int shifts = 0;
+    double hours = 0.0;
+    int cases_handled = 0;
+    double distance_km = 0.0;
+    int oxygen_used = 0;
+    int medicine_used = 0;
+};
+
+/**
+ * @brief Append-only columnar log of ambulance shifts with incrementally maintained rollups
+ *
+ * @details
+ * - Each field of shift_history.csv is its own growable column, so reports that aggregate a
+ *   few numeric fields stream through just those arrays. Start and end are also kept as
+ *   epoch seconds next to their original text
+ * - Records are never reordered or removed, a record's index is a permanent reference to it.
+ *   Each record links to the previous shift of the same ambulance (Ambulance::latest_shift_index
+ *   is the head), so one ambulance's history is walked without scanning the log
+ * - A permutation of the indices sorted by start answers time-range queries by binary search.
+ *   Shifts usually arrive in start order, so keeping it sorted is O(1) per append
+ * - Totals per ambulance, per driver and per day (the date of shift_start) are updated on
+ *   every append and status change. Cancelled shifts are kept in the log but left out of them
+ *
+ * @usage
+ *      ShiftLog log;
+ *      amb.latest_shift_index = log.append(record, amb.latest_shift_index);
+ *      log.forEachStartingIn(from, to, [&log](int index) { ... log.getCasesHandled(index) ... });
+ *      const ShiftRollup* totals = log.getAmbulanceRollup("AMB001");
+ */
+class ShiftLog {
+private:
+    // Columns, one entry per record
+    std::string* shiftIds;
+    std::string* ambulanceIds;
+    std::string* driverNames;
+    std::string* startTexts;
+    std::string* endTexts;
+    long long* starts;          /// Epoch seconds, -1 if shift_start does not parse
+    long long* ends;
+    int* durationHours;
+    std::string* caseIds;
+    int* casesHandled;
+    double* distancesKm;
+    int* oxygenUsed;
+    int* medicineUsed;
+    std::string* statuses;
+    int* previous;              /// Earlier shift of the same ambulance, -1 if none
+
+    int* byStart;               /// Record indices in start order
+    long long longestShift;     /// Longest end - start seen, bounds overlap searches
+
+    int size;
+    int capacity;
+
+    StringHashMap<ShiftRollup> ambulanceRollups;
+    StringHashMap<ShiftRollup> driverRollups;
+    StringHashMap<ShiftRollup> dayRollups;
+
+    void grow();
+    void applyToRollups(int index, int sign);
+
+public:
+    ShiftLog();
+    ~ShiftLog();
+
+    ShiftLog(const ShiftLog&) = delete;
+    ShiftLog& operator=(const ShiftLog&) = delete;
+
+    /**
+     * @brief Appends a record
+     * @param previousIndex Index of the ambulance's previous shift, -1 if none
+     * @return Index of the new record
+     */
+    int append(const ShiftRecord& record, int previousIndex);
+
+    /**
+     * @brief Changes a record's status, moving it out of (or back into) the rollups when it
+     *        becomes (or stops being) SHIFT_STATUS_CANCELLED
+     */
+    void setStatus(int index, const std::string& status);
+
+    ShiftRecord getRecord(int index) const;
+    const std::string& getShiftId(int index) const { return shiftIds[index]; }
+    const std::string& getAmbulanceId(int index) const { return ambulanceIds[index]; }
+    const std::string& getDriverName(int index) const { return driverNames[index]; }
+    const std::string& getStartText(int index) const { return startTexts[index]; }
+    const std::string& getStatus(int index) const { return statuses[index]; }
+    long long getStart(int index) const { return starts[index]; }
+    long long getEnd(int index) const { return ends[index]; }
+    int getCasesHandled(int index) const { return casesHandled[index]; }
+    double getDistanceKm(int index) const { return distancesKm[index]; }
+    int getOxygenUsed(int index) const { return oxygenUsed[index]; }
+    int getMedicineUsed(int index) const { return medicineUsed[index]; }
+    int previousOf(int index) const { return previous[index]; }
+    bool isCancelled(int index) const { return statuses[index] == SHIFT_STATUS_CANCELLED; }
+
+    int getSize() const { return size; }
+    void clear();
+
+    /**
+     * @brief Position in start order of the first record starting at or after t
+     */
+    int lowerBoundStart(long long t) const;
+
+    /**
+     * @brief Calls visit(index) for every record with from <= start < to, in start order
+     */
+    template <typename Visitor>
+    void forEachStartingIn(long long from, long long to, Visitor visit) const {
+        for (int position = lowerBoundStart(from); position < size && starts[byStart[position]] < to; position++) {
+            visit(byStart[position]);
+        }
+    }
+
+    /**
+     * @brief Calls visit(index) for every record overlapping [from, to), in start order
+     * @details A record overlapping from starts at most longestShift earlier, the search starts there
+     */
+    template <typename Visitor>
+    void forEachOverlapping(long long from, long long to, Visitor visit) const {
+        forEachStartingIn(from - longestShift, to, [this, from, &visit](int index) {
+            if (ends[index] > from) visit(index);
+        });
+    }
+
+    const ShiftRollup* getAmbulanceRollup(const std::string& ambulanceId) const { return ambulanceRollups.find(ambulanceId); }
+    const ShiftRollup* getDriverRollup(const std::string& driverName) const { return driverRollups.find(driverName); }
+
+    /**
+     * @param day Date as "YYYY-MM-DD"
+     */
+    const ShiftRollup* getDayRollup(const std::string& day) const { return dayRollups.find(day); }
+
+    /**
+     * @brief Calls visit(driverName, rollup) for every driver, in no particular order
+     */
+    template <typename Visitor>
+    void forEachDriverRollup(Visitor visit) const { driverRollups.forEach(visit); }
+};
+
+#endif // SHIFT_LOG_HPP
@@ -0,0 +1,129 @@
+#ifndef SHIFT_SCHEDULE_HPP
+#define SHIFT_SCHEDULE_HPP
+
+#include <string>
+#include "node_pool.hpp"
+
+/**
+ * @struct ShiftInterval
+ * @brief One ambulance shift as a half-open [start, end) interval of epoch seconds
+ */
+struct ShiftInterval {
+    long long start = 0;
+    long long end = 0;
+    std::string ambulance_id;
+    std::string shift_id;
+};
+
+/**
+ * @struct CoverageGap
+ * @brief A stretch of time [start, end) with no ambulance on shift
+ */
+struct CoverageGap {
+    long long start = 0;
+    long long end = 0;
+};
+
+/**
+ * @brief Interval tree of ambulance shifts
+ *
+ * @details
+ * - An AVL tree ordered by shift start, every node also stores the latest end in its subtree,
+ *   so whole subtrees that end before a query point are skipped
+ * - Point ("who is on shift at T") and range ("who works during [A, B)") queries cost
+ *   O(log n + k) for k matching shifts, inserts and removals O(log n)
+ * - Results come back in start order through a visitor, no intermediate list is built
+ *
+ * @usage
+ *      ShiftSchedule schedule;
+ *      schedule.insert(ShiftInterval{parseDatetime("2025-11-03 08:00"), parseDatetime("2025-11-03 16:00"), "AMB001", "SHIFT-2001"});
+ *      schedule.forEachCovering(parseDatetime("2025-11-03 09:30"), [](const ShiftInterval& shift) { ... });
+ */
+class ShiftSchedule {
+private:
+    struct Node {
+        ShiftInterval shift;
+        long long max_end; /// Latest end in this subtree
+        int height;
+        Node* left;
+        Node* right;
+    };
+
+    Node* root;
+    int size;
+    NodePool<Node> nodes;
+
+    static int heightOf(const Node* node) { return node ? node->height : 0; }
+    static bool isBefore(const ShiftInterval& a, const ShiftInterval& b);
+    static void update(Node* node);
+    static Node* rotateLeft(Node* node);
+    static Node* rotateRight(Node* node);
+    static Node* rebalance(Node* node);
+
+    Node* insertAt(Node* node, const ShiftInterval& shift);
+    Node* removeAt(Node* node, const ShiftInterval& shift, bool& removed);
+    Node* detachMin(Node* node, Node*& minimum);
+    void releaseAll(Node* node);
+
+    template <typename Visitor>
+    static void visitOverlapping(const Node* node, long long from, long long to, Visitor& visit) {
+        if (!node || node->max_end <= from) return; // Everything here ends before the range
+        visitOverlapping(node->left, from, to, visit);
+        if (node->shift.start >= to) return;        // This and everything to the right starts after it
+        if (node->shift.end > from) visit(node->shift);
+        visitOverlapping(node->right, from, to, visit);
+    }
+
+public:
+    ShiftSchedule();
+    ~ShiftSchedule();
+
+    ShiftSchedule(const ShiftSchedule&) = delete;
+    ShiftSchedule& operator=(const ShiftSchedule&) = delete;
+
+    /**
+     * @brief Adds a shift, empty or inverted intervals are ignored
+     * @return true if the shift was added
+     */
+    bool insert(const ShiftInterval& shift);
+
+    /**
+     * @brief Removes the shift with the same start, ambulance and shift ID
+     * @return true if it was found
+     */
+    bool remove(const ShiftInterval& shift);
+
+    void clear();
+    int getSize() const { return size; }
+
+    /**
+     * @brief Calls visit(shift) for every shift with start <= t < end, in start order
+     */
+    template <typename Visitor>
+    void forEachCovering(long long t, Visitor visit) const {
+        visitOverlapping(root, t, t + 1, visit);
+    }
+
+    /**
+     * @brief Calls visit(shift) for every shift overlapping [from, to), in start order
+     */
+    template <typename Visitor>
+    void forEachOverlapping(long long from, long long to, Visitor visit) const {
+        visitOverlapping(root, from, to, visit);
+    }
+
+    /**
+     * @brief Number of shifts covering instant t
+     */
+    int countCovering(long long t) const;
+
+    /**
+     * @brief Finds every stretch of [from, to) that no shift covers
+     * @param gaps Output array
+     * @param maxGaps Capacity of gaps
+     * @return Number of gaps found, may exceed maxGaps (only the first maxGaps are stored)
+     */
+    int findGaps(long long from, long long to, CoverageGap* gaps, int maxGaps) const;
+};
+
+#endif // SHIFT_SCHEDULE_HPP
@@ -1,22 +1,30 @@
 #include "ambulance_dispatcher.hpp"
+#include "durable_writer.hpp"
+#include "id_allocator.hpp"
+#include "path_utils.hpp"
+#include "snapshot.hpp"
+#include "time_utils.hpp"
 #include <fstream>
 #include <iomanip>
 #include <ctime>
 #include <sstream>
 #include <iostream>
+#include <filesystem>
+#include <limits>
 
 // Constructor
 AmbulanceDispatcher::AmbulanceDispatcher() {
-    front = 0;
-    rear = -1;
-    count = 0;
-    shiftCount = 0;
+    scheduleFile = getDataFilePath("ambulance_schedule.csv");
+    shiftFile = getDataFilePath("shift_history.csv");
+    IdAllocator::instance().observe(SHIFT_ID_NAMESPACE, SHIFT_ID_BASE);
+    scheduleDirty = false;
+    shiftsDirty = false;
 }
 
 // Main loop
 void AmbulanceDispatcher::run() {
-    loadScheduleFromCSV("data/ambulance_schedule.csv");
-    loadShiftDatasetFromCSV("data/shift_history.csv");
+    loadScheduleFromCSV(scheduleFile);
+    loadShiftDatasetFromCSV(shiftFile);
 
     int choice;
     do {
@@ -25,19 +33,25 @@ void AmbulanceDispatcher::run() {
         std::cin >> choice;
         std::cin.ignore(); // consume newline
         switch(choice) {
-            case 1: registerAmbulance(); saveScheduleToCSV("data/ambulance_schedule.csv"); break;
-            case 2: rotateShift(); saveScheduleToCSV("data/ambulance_schedule.csv"); break;
+            case 1: registerAmbulance(); saveScheduleToCSV(scheduleFile); break;
+            case 2: rotateShift(); saveScheduleToCSV(scheduleFile); break;
             case 3: displaySchedule(); break;
-            case 4: updateShift(); saveScheduleToCSV("data/ambulance_schedule.csv"); break;
+            case 4: updateShift(); saveScheduleToCSV(scheduleFile); break;
             case 5: viewInventory(); break;
-            case 6:
-                saveScheduleToCSV("data/ambulance_schedule.csv");
-                saveShiftDatasetToCSV("data/shift_history.csv");
+            case 6: showOnDutyAt(); break;
+            case 7: showCoverageGaps(); break;
+            case 8: displayShiftReportsMenu(); break;
+            case 9:
+                // Both files are published by one group commit, each one atomically
+                DurableWriter::beginGroup();
+                saveScheduleToCSV(scheduleFile);
+                saveShiftDatasetToCSV(shiftFile);
+                DurableWriter::commitGroup();
                 std::cout << "Exiting Ambulance Dispatcher...\n";
                 break;
             default: std::cout << "Invalid choice. Try again.\n";
         }
-    } while(choice != 6);
+    } while(choice != 9);
 }
 
 // Display menu
@@ -48,21 +62,26 @@ void AmbulanceDispatcher::displayMenu() {
     std::cout << "3. Display Ambulance Schedule\n";
     std::cout << "4. Update Ambulance Shift\n";
     std::cout << "5. View Ambulance Inventory\n";
-    std::cout << "6. Exit\n";
+    std::cout << "6. Who Is On Duty At...\n";
+    std::cout << "7. Find Coverage Gaps\n";
+    std::cout << "8. Shift Reports\n";
+    std::cout << "9. Exit\n";
 }
 
 // Register a new ambulance
 void AmbulanceDispatcher::registerAmbulance() {
-    if (count >= MAX_AMBULANCES) {
-        std::cout << "Maximum ambulance limit reached.\n";
-        return;
-    }
-
-    rear = (rear + 1) % MAX_AMBULANCES;
-    Ambulance &amb = ambulanceQueue[rear];
+    Ambulance amb;
 
     std::cout << "Enter Ambulance ID: ";
     std::getline(std::cin, amb.ambulance_id);
+    if (amb.ambulance_id.empty()) {
+        std::cout << "Ambulance ID cannot be empty.\n";
+        return;
+    }
+    if (fleet.contains(amb.ambulance_id)) {
+        std::cout << "Ambulance " << amb.ambulance_id << " is already registered.\n";
+        return;
+    }
     std::cout << "Enter Driver Name: ";
     std::getline(std::cin, amb.driver_name);
     std::cout << "Enter Shift Start (YYYY-MM-DD HH:MM): ";
@@ -82,70 +101,93 @@ void AmbulanceDispatcher::registerAmbulance() {
     amb.next_rotation_time = amb.shift_end;
     amb.location = "Unknown";
 
-    count++;
+    fleet.add(amb);
+    scheduleDirty = true;
     std::cout << "Ambulance registered successfully!\n";
 }
 
-// Rotate all ambulance shifts for 24-hour coverage
+// Rotate ambulance shifts back to back over one or more days, in queue order
 void AmbulanceDispatcher::rotateShift() {
+    const int count = fleet.getCount();
     if (count <= 1) {
         std::cout << "Not enough ambulances to rotate.\n";
         return;
     }
 
-    int currHour = 0, currMin = 0;
-    for (int i = 0; i < count; i++) {
-        int idx = (front + i) % MAX_AMBULANCES;
-        Ambulance &amb = ambulanceQueue[idx];
-
-        char buf[64];
-        #ifdef _WIN32
-            sprintf_s(buf, sizeof(buf), "2025-11-03 %02d:%02d", currHour, currMin);
-        #else
-            snprintf(buf, sizeof(buf), "2025-11-03 %02d:%02d", currHour, currMin);
-        #endif
-        amb.shift_start = buf;
-
-        int endHour = currHour + amb.shift_duration;
-        int endDay = 0;
-        if (endHour >= 24) {
-            endHour -= 24;
-            endDay = 1;
-        }
+    std::string startInput;
+    std::cout << "Enter Rotation Start (YYYY-MM-DD HH:MM, blank for the next full hour): ";
+    std::getline(std::cin, startInput);
+    long long start;
+    if (startInput.empty()) {
+        const long long now = static_cast<long long>(std::time(nullptr));
+        start = parseDatetime(formatDatetime(now).substr(0, 13) + ":00") + 3600;
+    } else {
+        start = parseDatetime(startInput);
+    }
+    if (start < 0) {
+        std::cout << "Invalid datetime. Use YYYY-MM-DD HH:MM.\n";
+        return;
+    }
 
-        #ifdef _WIN32
-            sprintf_s(buf, sizeof(buf), "2025-11-%02d %02d:%02d", 3 + endDay, endHour, currMin);
-        #else
-            snprintf(buf, sizeof(buf), "2025-11-%02d %02d:%02d", 3 + endDay, endHour, currMin);
-        #endif
-        amb.shift_end = buf;
-        amb.next_rotation_time = amb.shift_end;
+    int days;
+    std::cout << "Enter Number of Days to Cover (1-" << MAX_ROTATION_DAYS << "): ";
+    std::cin >> days;
+    std::cin.ignore();
+    if (days < 1 || days > MAX_ROTATION_DAYS) {
+        std::cout << "Number of days must be between 1 and " << MAX_ROTATION_DAYS << ".\n";
+        return;
+    }
+    const long long horizon = start + static_cast<long long>(days) * 24 * 3600;
 
-        if (i == 0) {
-            amb.driver_status = "On Duty";
-            amb.ambulance_status = "On Duty";
-        } else {
-            amb.driver_status = "Available";
-            amb.ambulance_status = "Available";
+    // A new rotation replaces whatever was still scheduled from its start on
+    cancelScheduledShiftsFrom(start);
+
+    // Count the shifts first so their IDs are claimed as one block
+    long long planned = 0;
+    for (long long at = start; at < horizon; planned++) {
+        const Ambulance &amb = fleet.at(static_cast<int>(planned % count));
+        at += static_cast<long long>(amb.shift_duration > 0 ? amb.shift_duration : DEFAULT_SHIFT_HOURS) * 3600;
+    }
+    const long long firstShiftNumber = IdAllocator::instance().reserve(SHIFT_ID_NAMESPACE, planned);
+
+    long long current = start;
+    int generated = 0;
+    while (current < horizon) {
+        Ambulance &amb = fleet.at(generated % count);
+        const int hours = amb.shift_duration > 0 ? amb.shift_duration : DEFAULT_SHIFT_HOURS;
+        const long long end = current + static_cast<long long>(hours) * 3600;
+
+        addShiftRecord(amb, current, end, firstShiftNumber + generated);
+
+        // Each ambulance's schedule row shows its first shift of the rotation
+        if (generated < count) {
+            amb.shift_start = formatDatetime(current);
+            amb.shift_end = formatDatetime(end);
+            amb.next_rotation_time = amb.shift_end;
+            amb.driver_status = generated == 0 ? "On Duty" : "Available";
+            amb.ambulance_status = amb.driver_status;
         }
 
-        currHour = endHour;
+        current = end;
+        generated++;
     }
+    scheduleDirty = true;
+    shiftsDirty = true;
 
-    std::cout << "All ambulance shifts rotated for 24-hour coverage successfully.\n";
+    std::cout << "Generated " << generated << " shifts covering " << formatDatetime(start)
+              << " to " << formatDatetime(current) << " (" << days << " day(s)).\n";
 }
 
 // Display schedule
 void AmbulanceDispatcher::displaySchedule() {
-    if (count == 0) {
+    if (fleet.getCount() == 0) {
         std::cout << "No ambulances in schedule.\n";
         return;
     }
 
     std::cout << "\n=== Current Ambulance Schedule ===\n";
-    for (int i = 0; i < count; i++) {
-        int idx = (front + i) % MAX_AMBULANCES;
-        Ambulance &amb = ambulanceQueue[idx];
+    for (int i = 0; i < fleet.getCount(); i++) {
+        Ambulance &amb = fleet.at(i);
         std::cout << amb.ambulance_id << " | " << amb.driver_name
                   << " | " << amb.shift_start << " - " << amb.shift_end
                   << " | Duration: " << amb.shift_duration
@@ -153,63 +195,41 @@ void AmbulanceDispatcher::displaySchedule() {
     }
 }
 
-// Helper: add hours safely
-std::string addHoursToDatetime(const std::string& datetime, int hours) {
-    std::tm tm = {};
-    std::istringstream ss(datetime);
-    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M");
-    if (ss.fail()) return datetime;
-
-    std::time_t t = std::mktime(&tm);
-    t += hours * 3600;
-
-    std::tm newTm = {};
-    #ifdef _WIN32
-    localtime_s(&newTm, &t);
-    #else
-        localtime_r(&t, &newTm);
-    #endif
-
-    char buf[64];
-    #ifdef _WIN32
-        sprintf_s(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d",
-              newTm.tm_year + 1900, newTm.tm_mon + 1, newTm.tm_mday,
-              newTm.tm_hour, newTm.tm_min);
-    #else
-        snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d",
-              newTm.tm_year + 1900, newTm.tm_mon + 1, newTm.tm_mday,
-              newTm.tm_hour, newTm.tm_min);
-    #endif
-
-    return std::string(buf);
-}
-
-// Update all ambulance shifts sequentially and refresh shiftRecords
+// Update all ambulance shifts sequentially, superseding the shifts still scheduled
 void AmbulanceDispatcher::updateShift() {
     std::string startDatetime;
-    int newDuration;
+    int newDuration = 0;
 
     std::cout << "Enter new Shift Start (YYYY-MM-DD HH:MM) for the first ambulance: ";
     std::getline(std::cin, startDatetime);
     std::cout << "Enter new Shift Duration (hours): ";
-    std::cin >> newDuration;
-    std::cin.ignore();
-
-    std::string currentStart = startDatetime;
+    if (!(std::cin >> newDuration)) {
+        std::cin.clear();
+        newDuration = 0;
+    }
+    std::cin.ignore(1000, '\n');
 
-    // Clear previous shift records for this update
-    shiftCount = 0;
+    long long currentStart = parseDatetime(startDatetime);
+    if (currentStart < 0) {
+        std::cout << "Invalid datetime. Use YYYY-MM-DD HH:MM.\n";
+        return;
+    }
+    if (newDuration <= 0) {
+        std::cout << "Shift duration must be at least 1 hour.\n";
+        return;
+    }
 
-    for (int i = 0; i < count; i++) {
-        int idx = (front + i) % MAX_AMBULANCES;
-        Ambulance &amb = ambulanceQueue[idx];
+    // The new plan supersedes every shift that has not been worked yet
+    cancelScheduledShiftsFrom(std::numeric_limits<long long>::min());
 
-        // Save old shift to history
-        amb.shift_history.appendArray(amb.shift_start + " - " + amb.shift_end);
+    const long long firstShiftNumber = IdAllocator::instance().reserve(SHIFT_ID_NAMESPACE, fleet.getCount());
+    for (int i = 0; i < fleet.getCount(); i++) {
+        Ambulance &amb = fleet.at(i);
 
         // Assign new shift
-        amb.shift_start = currentStart;
-        amb.shift_end = addHoursToDatetime(currentStart, newDuration);
+        const long long end = currentStart + static_cast<long long>(newDuration) * 3600;
+        amb.shift_start = formatDatetime(currentStart);
+        amb.shift_end = formatDatetime(end);
         amb.shift_duration = newDuration;
         amb.next_rotation_time = amb.shift_end;
 
@@ -222,23 +242,13 @@ void AmbulanceDispatcher::updateShift() {
         }
 
         // Add new shift record
-        ShiftRecord &sr = shiftRecords[shiftCount++];
-        sr.shift_id = "SHIFT-" + std::to_string(2000 + shiftCount); // unique ID
-        sr.ambulance_id = amb.ambulance_id;
-        sr.driver_name = amb.driver_name;
-        sr.shift_start = amb.shift_start;
-        sr.shift_end = amb.shift_end;
-        sr.shift_duration_hours = amb.shift_duration;
-        sr.assigned_case_id = amb.assigned_case_id.empty() ? "-" : amb.assigned_case_id;
-        sr.cases_handled = 0;
-        sr.total_distance_km = 0.0;
-        sr.oxygen_used = 0;
-        sr.medicine_used = 0;
-        sr.status_at_end = "Scheduled";
+        addShiftRecord(amb, currentStart, end, firstShiftNumber + i);
 
         // Prepare start time for next ambulance
-        currentStart = amb.shift_end;
+        currentStart = end;
     }
+    scheduleDirty = true;
+    shiftsDirty = true;
 
     std::cout << "All ambulance shifts updated successfully (schedule + shift dataset refreshed).\n";
 }
@@ -246,32 +256,168 @@ void AmbulanceDispatcher::updateShift() {
 
 // View inventory
 void AmbulanceDispatcher::viewInventory() {
-    if (count == 0) {
+    if (fleet.getCount() == 0) {
         std::cout << "No ambulances available.\n";
         return;
     }
 
     std::cout << "\n=== Ambulance Inventory ===\n";
-    for (int i = 0; i < count; i++) {
-        int idx = (front + i) % MAX_AMBULANCES;
-        Ambulance &amb = ambulanceQueue[idx];
+    for (int i = 0; i < fleet.getCount(); i++) {
+        Ambulance &amb = fleet.at(i);
         std::cout << amb.ambulance_id << " | Oxygen: " << amb.oxygen_tank
                   << " | First Aid Kits: " << amb.first_aid_kit
                   << " | Medicine Units: " << amb.medicine_units << "\n";
     }
 }
 
-// Find ambulance
-int AmbulanceDispatcher::findAmbulanceIndex(const std::string& id) {
-    for (int i = 0; i < count; i++) {
-        int idx = (front + i) % MAX_AMBULANCES;
-        if (ambulanceQueue[idx].ambulance_id == id) return idx;
+// Appends a "Scheduled" shift record to the log and indexes it in the interval tree
+void AmbulanceDispatcher::addShiftRecord(Ambulance& amb, long long start, long long end, long long shiftNumber) {
+    ShiftRecord sr;
+    sr.shift_id = IdAllocator::format(SHIFT_ID_NAMESPACE, shiftNumber); // Claimed from the allocator by the caller
+    sr.ambulance_id = amb.ambulance_id;
+    sr.driver_name = amb.driver_name;
+    sr.shift_start = formatDatetime(start);
+    sr.shift_end = formatDatetime(end);
+    sr.shift_duration_hours = static_cast<int>((end - start) / 3600);
+    sr.assigned_case_id = amb.assigned_case_id.empty() ? "-" : amb.assigned_case_id;
+    sr.cases_handled = 0;
+    sr.total_distance_km = 0.0;
+    sr.oxygen_used = 0;
+    sr.medicine_used = 0;
+    sr.status_at_end = "Scheduled";
+
+    amb.latest_shift_index = shifts.append(sr, amb.latest_shift_index);
+    schedule.insert(ShiftInterval{start, end, sr.ambulance_id, sr.shift_id});
+}
+
+// Appends a shift read from the dataset, chained to its ambulance's earlier shifts
+void AmbulanceDispatcher::appendLoadedShift(const ShiftRecord& sr) {
+    Ambulance* amb = fleet.find(sr.ambulance_id);
+    const int index = shifts.append(sr, amb ? amb->latest_shift_index : -1);
+    if (amb) amb->latest_shift_index = index;
+}
+
+// Marks "Scheduled" shifts starting at or after start as cancelled, the log keeps them
+void AmbulanceDispatcher::cancelScheduledShiftsFrom(long long start) {
+    shifts.forEachStartingIn(start, std::numeric_limits<long long>::max(), [this](int index) {
+        if (shifts.getStatus(index) != "Scheduled") return;
+
+        schedule.remove(ShiftInterval{shifts.getStart(index), shifts.getEnd(index), shifts.getAmbulanceId(index), shifts.getShiftId(index)});
+        shifts.setStatus(index, SHIFT_STATUS_CANCELLED);
+        shiftsDirty = true;
+    });
+}
+
+// Re-indexes every shift still in force and keeps the allocator past every loaded SHIFT-xxxx number
+void AmbulanceDispatcher::rebuildShiftSchedule() {
+    IdAllocator &ids = IdAllocator::instance();
+    schedule.clear();
+    for (int i = 0; i < shifts.getSize(); i++) {
+        const std::string &shiftId = shifts.getShiftId(i);
+        if (!shifts.isCancelled(i)) schedule.insert(ShiftInterval{shifts.getStart(i), shifts.getEnd(i), shifts.getAmbulanceId(i), shiftId});
+        ids.observeId(SHIFT_ID_NAMESPACE, shiftId);
+    }
+}
+
+// Lists every ambulance whose shift covers a given instant
+void AmbulanceDispatcher::showOnDutyAt() {
+    std::string input;
+    std::cout << "Enter Date and Time (YYYY-MM-DD HH:MM, blank for now): ";
+    std::getline(std::cin, input);
+    const long long at = input.empty() ? static_cast<long long>(std::time(nullptr)) : parseDatetime(input);
+    if (at < 0) {
+        std::cout << "Invalid datetime. Use YYYY-MM-DD HH:MM.\n";
+        return;
+    }
+
+    std::cout << "\n=== On Duty At " << formatDatetime(at) << " ===\n";
+    int found = 0;
+    schedule.forEachCovering(at, [this, &found](const ShiftInterval& shift) {
+        const Ambulance* amb = fleet.find(shift.ambulance_id);
+        std::cout << shift.ambulance_id << " | " << (amb ? amb->driver_name : "-")
+                  << " | " << formatDatetime(shift.start) << " - " << formatDatetime(shift.end)
+                  << " | " << shift.shift_id << "\n";
+        found++;
+    });
+    if (found == 0) {
+        std::cout << "No ambulance is on shift at that time.\n";
+    }
+}
+
+// Lists the stretches of a horizon that no shift covers
+void AmbulanceDispatcher::showCoverageGaps() {
+    std::string input;
+    std::cout << "Enter Horizon Start (YYYY-MM-DD HH:MM, blank for now): ";
+    std::getline(std::cin, input);
+    const long long from = input.empty() ? static_cast<long long>(std::time(nullptr)) : parseDatetime(input);
+    if (from < 0) {
+        std::cout << "Invalid datetime. Use YYYY-MM-DD HH:MM.\n";
+        return;
+    }
+
+    int days;
+    std::cout << "Enter Number of Days to Check (1-" << MAX_ROTATION_DAYS << "): ";
+    std::cin >> days;
+    std::cin.ignore();
+    if (days < 1 || days > MAX_ROTATION_DAYS) {
+        std::cout << "Number of days must be between 1 and " << MAX_ROTATION_DAYS << ".\n";
+        return;
+    }
+    const long long to = from + static_cast<long long>(days) * 24 * 3600;
+
+    CoverageGap gaps[MAX_LISTED_GAPS];
+    const int found = schedule.findGaps(from, to, gaps, MAX_LISTED_GAPS);
+
+    std::cout << "\n=== Coverage Gaps " << formatDatetime(from) << " - " << formatDatetime(to) << " ===\n";
+    if (found == 0) {
+        std::cout << "Fully covered, no gaps.\n";
+        return;
+    }
+    for (int i = 0; i < found && i < MAX_LISTED_GAPS; i++) {
+        std::cout << formatDatetime(gaps[i].start) << " - " << formatDatetime(gaps[i].end)
+                  << " | " << (gaps[i].end - gaps[i].start) / 60 << " min uncovered\n";
+    }
+    if (found > MAX_LISTED_GAPS) {
+        std::cout << "... and " << (found - MAX_LISTED_GAPS) << " more.\n";
+    }
+}
+
+// Registers an ambulance read from the schedule, a repeated ID keeps its first row
+void AmbulanceDispatcher::addLoadedAmbulance(const Ambulance& amb) {
+    if (fleet.add(amb).slot == -1) {
+        std::cout << "Warning: Skipping duplicate ambulance " << amb.ambulance_id << " in schedule.\n";
     }
-    return -1;
 }
 
 // Load schedule from CSV
 void AmbulanceDispatcher::loadScheduleFromCSV(const std::string& filename) {
+    // An up-to-date snapshot is used as is, no per-row parsing
+    SnapshotReader snapshot(filename, AMBULANCE_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        fleet.clear();
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            Ambulance amb;
+            amb.ambulance_id = snapshot.getString(row, 0);
+            amb.driver_name = snapshot.getString(row, 1);
+            amb.driver_status = snapshot.getString(row, 2);
+            amb.shift_start = snapshot.getString(row, 3);
+            amb.shift_end = snapshot.getString(row, 4);
+            amb.shift_duration = static_cast<int>(snapshot.getInt(row, 5));
+            amb.next_rotation_time = snapshot.getString(row, 6);
+            amb.assigned_case_id = snapshot.getString(row, 7);
+            amb.ambulance_status = snapshot.getString(row, 8);
+            amb.oxygen_tank = static_cast<int>(snapshot.getInt(row, 9));
+            amb.first_aid_kit = static_cast<int>(snapshot.getInt(row, 10));
+            amb.medicine_units = static_cast<int>(snapshot.getInt(row, 11));
+            amb.last_service_date = snapshot.getString(row, 12);
+            amb.location = snapshot.getString(row, 13);
+
+            addLoadedAmbulance(amb);
+        }
+        std::cout << "Loaded " << fleet.getCount() << " ambulances from " << filename << ".\n";
+        return;
+    }
+
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cout << "Warning: Unable to open " << filename << ". Starting empty.\n";
@@ -280,7 +426,7 @@ void AmbulanceDispatcher::loadScheduleFromCSV(const std::string& filename) {
 
     std::string line;
     std::getline(file, line); // skip header
-    count = 0; front = 0; rear = -1;
+    fleet.clear();
 
     while (std::getline(file, line)) {
         if (line.empty()) continue;
@@ -303,17 +449,45 @@ void AmbulanceDispatcher::loadScheduleFromCSV(const std::string& filename) {
         std::getline(ss, amb.last_service_date, ',');
         std::getline(ss, amb.location, ',');
 
-        rear = (rear + 1) % MAX_AMBULANCES;
-        ambulanceQueue[rear] = amb;
-        count++;
+        addLoadedAmbulance(amb);
     }
 
     file.close();
-    std::cout << "Loaded " << count << " ambulances from " << filename << ".\n";
+    std::cout << "Loaded " << fleet.getCount() << " ambulances from " << filename << ".\n";
+
+    std::error_code ec;
+    const uintmax_t csvSize = std::filesystem::file_size(filename, ec);
+    if (!ec) {
+        saveScheduleSnapshot(filename, static_cast<unsigned long long>(csvSize));
+    }
 }
 
 // Load shift records
 void AmbulanceDispatcher::loadShiftDatasetFromCSV(const std::string& filename) {
+    SnapshotReader snapshot(filename, SHIFT_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        shifts.clear();
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            ShiftRecord sr;
+            sr.shift_id = snapshot.getString(row, 0);
+            sr.ambulance_id = snapshot.getString(row, 1);
+            sr.driver_name = snapshot.getString(row, 2);
+            sr.shift_start = snapshot.getString(row, 3);
+            sr.shift_end = snapshot.getString(row, 4);
+            sr.shift_duration_hours = static_cast<int>(snapshot.getInt(row, 5));
+            sr.assigned_case_id = snapshot.getString(row, 6);
+            sr.cases_handled = static_cast<int>(snapshot.getInt(row, 7));
+            sr.total_distance_km = snapshot.getDouble(row, 8);
+            sr.oxygen_used = static_cast<int>(snapshot.getInt(row, 9));
+            sr.medicine_used = static_cast<int>(snapshot.getInt(row, 10));
+            sr.status_at_end = snapshot.getString(row, 11);
+            appendLoadedShift(sr);
+        }
+        std::cout << "Loaded " << shifts.getSize() << " shift records from " << filename << ".\n";
+        rebuildShiftSchedule();
+        return;
+    }
+
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cout << "Warning: Unable to open " << filename << ". Starting empty.\n";
@@ -322,7 +496,7 @@ void AmbulanceDispatcher::loadShiftDatasetFromCSV(const std::string& filename) {
 
     std::string line;
     std::getline(file, line); // skip header
-    shiftCount = 0;
+    shifts.clear();
 
     while (std::getline(file, line)) {
         if (line.empty()) continue;
@@ -343,28 +517,35 @@ void AmbulanceDispatcher::loadShiftDatasetFromCSV(const std::string& filename) {
         std::getline(ss, token, ','); sr.medicine_used = std::stoi(token);
         std::getline(ss, sr.status_at_end, ',');
 
-        shiftRecords[shiftCount++] = sr;
+        appendLoadedShift(sr);
     }
 
     file.close();
-    std::cout << "Loaded " << shiftCount << " shift records from " << filename << ".\n";
+    std::cout << "Loaded " << shifts.getSize() << " shift records from " << filename << ".\n";
+    rebuildShiftSchedule();
+
+    std::error_code ec;
+    const uintmax_t csvSize = std::filesystem::file_size(filename, ec);
+    if (!ec) {
+        saveShiftSnapshot(filename, static_cast<unsigned long long>(csvSize));
+    }
 }
 
 // Save schedule to CSV
 void AmbulanceDispatcher::saveScheduleToCSV(const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "Error: Unable to open " << filename << " for saving.\n";
-        return;
+    if (!scheduleDirty) return; // Nothing changed since the last load or save
+
+    DurableWriter file(filename); // Replaces the file atomically on commit
+    if (!file.isOpen()) {
+        return; // DurableWriter reported the failure
     }
 
     file << "Ambulance_ID,Driver_Name,Driver_Status,Shift_Start,Shift_End,Shift_Duration_Hours,"
             "Next_Rotation_Time,Assigned_Case_ID,Ambulance_Status,OxygenTank,FirstAidKit,"
             "MedicineUnits,Last_Service_Date,Location\n";
 
-    for (int i = 0; i < count; i++) {
-        int idx = (front + i) % MAX_AMBULANCES;
-        Ambulance &amb = ambulanceQueue[idx];
+    for (int i = 0; i < fleet.getCount(); i++) {
+        Ambulance &amb = fleet.at(i);
 
         file << amb.ambulance_id << ","
              << amb.driver_name << ","
@@ -382,29 +563,67 @@ void AmbulanceDispatcher::saveScheduleToCSV(const std::string& filename) {
              << amb.location << "\n";
     }
 
-    file.close();
+    const unsigned long long csvSize = file.bytesWritten();
+    if (!file.commit()) {
+        return; // DurableWriter reported the failure, the previous schedule is kept
+    }
+    scheduleDirty = false;
+    saveScheduleSnapshot(filename, csvSize);
     std::cout << "Schedule saved to " << filename << " successfully.\n";
 }
 
 // Save shift dataset
 void AmbulanceDispatcher::saveShiftDatasetToCSV(const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "Error: Unable to open " << filename << " for saving.\n";
-        return;
+    if (!shiftsDirty) return; // Nothing changed since the last load or save
+
+    DurableWriter file(filename); // Replaces the file atomically on commit
+    if (!file.isOpen()) {
+        return; // DurableWriter reported the failure
     }
 
     file << "Shift_ID,Ambulance_ID,Driver_Name,Shift_Start,Shift_End,Shift_Duration_Hours,"
             "Assigned_Case_ID,Cases_Handled,Total_Distance_km,OxygenUsed,MedicineUsed,Status_At_End\n";
 
-    for (int i = 0; i < shiftCount; i++) {
-        const ShiftRecord &s = shiftRecords[i];
+    for (int i = 0; i < shifts.getSize(); i++) {
+        const ShiftRecord s = shifts.getRecord(i);
         file << s.shift_id << "," << s.ambulance_id << "," << s.driver_name << ","
              << s.shift_start << "," << s.shift_end << "," << s.shift_duration_hours << ","
              << s.assigned_case_id << "," << s.cases_handled << "," << s.total_distance_km << ","
              << s.oxygen_used << "," << s.medicine_used << "," << s.status_at_end << "\n";
     }
 
-    file.close();
+    const unsigned long long csvSize = file.bytesWritten();
+    if (!file.commit()) {
+        return; // DurableWriter reported the failure, the previous shift dataset is kept
+    }
+    shiftsDirty = false;
+    saveShiftSnapshot(filename, csvSize);
     std::cout << "Shift dataset saved to " << filename << " successfully.\n";
 }
+
+// Write the binary snapshot of the schedule, in the same column order as the CSV
+void AmbulanceDispatcher::saveScheduleSnapshot(const std::string& filename, unsigned long long csvSize) {
+    SnapshotWriter snapshot(AMBULANCE_SNAPSHOT_COLUMNS);
+    for (int i = 0; i < fleet.getCount(); i++) {
+        const Ambulance &amb = fleet.at(i);
+        snapshot.addString(amb.ambulance_id).addString(amb.driver_name).addString(amb.driver_status)
+                .addString(amb.shift_start).addString(amb.shift_end).addInt(amb.shift_duration)
+                .addString(amb.next_rotation_time).addString(amb.assigned_case_id).addString(amb.ambulance_status)
+                .addInt(amb.oxygen_tank).addInt(amb.first_aid_kit).addInt(amb.medicine_units)
+                .addString(amb.last_service_date).addString(amb.location);
+    }
+    snapshot.save(filename, csvSize);
+}
+
+// Write the binary snapshot of the shift dataset
+void AmbulanceDispatcher::saveShiftSnapshot(const std::string& filename, unsigned long long csvSize) {
+    SnapshotWriter snapshot(SHIFT_SNAPSHOT_COLUMNS);
+    for (int i = 0; i < shifts.getSize(); i++) {
+        const ShiftRecord s = shifts.getRecord(i);
+        snapshot.addString(s.shift_id).addString(s.ambulance_id).addString(s.driver_name)
+                .addString(s.shift_start).addString(s.shift_end).addInt(s.shift_duration_hours)
+                .addString(s.assigned_case_id).addInt(s.cases_handled).addDouble(s.total_distance_km)
+                .addInt(s.oxygen_used).addInt(s.medicine_used).addString(s.status_at_end);
+    }
+    snapshot.save(filename, csvSize);
+}
@@ -0,0 +1,112 @@
+#include "fleet_registry.hpp"
+
+#include <utility>
+
+#define FLEET_INITIAL_CAPACITY 16
+
+FleetRegistry::FleetRegistry()
+    : slots(new Slot[FLEET_INITIAL_CAPACITY]), slotCapacity(FLEET_INITIAL_CAPACITY), slotsUsed(0), freeHead(-1),
+      order(new int[FLEET_INITIAL_CAPACITY]), count(0), orderCapacity(FLEET_INITIAL_CAPACITY) {}
+
+FleetRegistry::~FleetRegistry() {
+    delete[] slots;
+    delete[] order;
+}
+
+void FleetRegistry::growSlots() {
+    const int newCapacity = slotCapacity * 2;
+    Slot* newSlots = new Slot[newCapacity];
+    for (int i = 0; i < slotsUsed; i++) {
+        newSlots[i] = std::move(slots[i]);
+    }
+    delete[] slots;
+    slots = newSlots;
+    slotCapacity = newCapacity;
+}
+
+void FleetRegistry::growOrder() {
+    const int newCapacity = orderCapacity * 2;
+    int* newOrder = new int[newCapacity];
+    for (int i = 0; i < count; i++) {
+        newOrder[i] = order[i];
+    }
+    delete[] order;
+    order = newOrder;
+    orderCapacity = newCapacity;
+}
+
+AmbulanceHandle FleetRegistry::add(const Ambulance& amb) {
+    if (amb.ambulance_id.empty() || byId.contains(amb.ambulance_id)) {
+        return AmbulanceHandle{};
+    }
+
+    int slot;
+    if (freeHead != -1) {
+        slot = freeHead;
+        freeHead = slots[slot].nextFree;
+    } else {
+        if (slotsUsed == slotCapacity) growSlots();
+        slot = slotsUsed++;
+    }
+    if (count == orderCapacity) growOrder();
+
+    Slot& s = slots[slot];
+    s.ambulance = amb;
+    s.position = count;
+    s.nextFree = -1;
+    order[count++] = slot;
+
+    const AmbulanceHandle handle{slot, s.generation};
+    byId.insertOrAssign(amb.ambulance_id, handle);
+    return handle;
+}
+
+bool FleetRegistry::remove(AmbulanceHandle handle) {
+    if (!get(handle)) return false;
+
+    Slot& s = slots[handle.slot];
+    byId.erase(s.ambulance.ambulance_id);
+
+    // Removal is rare, the rotation order is closed up to keep it stable
+    for (int i = s.position; i < count - 1; i++) {
+        order[i] = order[i + 1];
+        slots[order[i]].position = i;
+    }
+    count--;
+
+    s.generation++; // Outstanding handles to this slot stop resolving
+    s.position = -1;
+    s.nextFree = freeHead;
+    freeHead = handle.slot;
+    return true;
+}
+
+Ambulance* FleetRegistry::get(AmbulanceHandle handle) {
+    if (handle.slot < 0 || handle.slot >= slotsUsed) return nullptr;
+    Slot& s = slots[handle.slot];
+    if (s.position == -1 || s.generation != handle.generation) return nullptr;
+    return &s.ambulance;
+}
+
+Ambulance* FleetRegistry::find(const std::string& ambulanceId) {
+    const AmbulanceHandle* handle = byId.find(ambulanceId);
+    return handle ? &slots[handle->slot].ambulance : nullptr;
+}
+
+AmbulanceHandle FleetRegistry::findHandle(const std::string& ambulanceId) const {
+    const AmbulanceHandle* handle = byId.find(ambulanceId);
+    return handle ? *handle : AmbulanceHandle{};
+}
+
+void FleetRegistry::clear() {
+    byId.clear();
+    freeHead = -1;
+    for (int i = slotsUsed - 1; i >= 0; i--) {
+        Slot& s = slots[i];
+        if (s.position != -1) s.generation++;
+        s.position = -1;
+        s.nextFree = freeHead;
+        freeHead = i;
+    }
+    count = 0;
+}
@@ -0,0 +1,180 @@
+#include "shift_log.hpp"
+#include "time_utils.hpp"
+
+#include <utility>
+
+#define SHIFT_LOG_INITIAL_CAPACITY 64
+
+// Moves the first size entries of a column into a bigger array
+template <typename T>
+static void growColumn(T*& column, int size, int newCapacity) {
+    T* grown = new T[newCapacity];
+    for (int i = 0; i < size; i++) {
+        grown[i] = std::move(column[i]);
+    }
+    delete[] column;
+    column = grown;
+}
+
+ShiftLog::ShiftLog()
+    : shiftIds(new std::string[SHIFT_LOG_INITIAL_CAPACITY]),
+      ambulanceIds(new std::string[SHIFT_LOG_INITIAL_CAPACITY]),
+      driverNames(new std::string[SHIFT_LOG_INITIAL_CAPACITY]),
+      startTexts(new std::string[SHIFT_LOG_INITIAL_CAPACITY]),
+      endTexts(new std::string[SHIFT_LOG_INITIAL_CAPACITY]),
+      starts(new long long[SHIFT_LOG_INITIAL_CAPACITY]),
+      ends(new long long[SHIFT_LOG_INITIAL_CAPACITY]),
+      durationHours(new int[SHIFT_LOG_INITIAL_CAPACITY]),
+      caseIds(new std::string[SHIFT_LOG_INITIAL_CAPACITY]),
+      casesHandled(new int[SHIFT_LOG_INITIAL_CAPACITY]),
+      distancesKm(new double[SHIFT_LOG_INITIAL_CAPACITY]),
+      oxygenUsed(new int[SHIFT_LOG_INITIAL_CAPACITY]),
+      medicineUsed(new int[SHIFT_LOG_INITIAL_CAPACITY]),
+      statuses(new std::string[SHIFT_LOG_INITIAL_CAPACITY]),
+      previous(new int[SHIFT_LOG_INITIAL_CAPACITY]),
+      byStart(new int[SHIFT_LOG_INITIAL_CAPACITY]),
+      longestShift(0),
+      size(0),
+      capacity(SHIFT_LOG_INITIAL_CAPACITY) {}
+
+ShiftLog::~ShiftLog() {
+    delete[] shiftIds;
+    delete[] ambulanceIds;
+    delete[] driverNames;
+    delete[] startTexts;
+    delete[] endTexts;
+    delete[] starts;
+    delete[] ends;
+    delete[] durationHours;
+    delete[] caseIds;
+    delete[] casesHandled;
+    delete[] distancesKm;
+    delete[] oxygenUsed;
+    delete[] medicineUsed;
+    delete[] statuses;
+    delete[] previous;
+    delete[] byStart;
+}
+
+void ShiftLog::grow() {
+    const int newCapacity = capacity * 2;
+    growColumn(shiftIds, size, newCapacity);
+    growColumn(ambulanceIds, size, newCapacity);
+    growColumn(driverNames, size, newCapacity);
+    growColumn(startTexts, size, newCapacity);
+    growColumn(endTexts, size, newCapacity);
+    growColumn(starts, size, newCapacity);
+    growColumn(ends, size, newCapacity);
+    growColumn(durationHours, size, newCapacity);
+    growColumn(caseIds, size, newCapacity);
+    growColumn(casesHandled, size, newCapacity);
+    growColumn(distancesKm, size, newCapacity);
+    growColumn(oxygenUsed, size, newCapacity);
+    growColumn(medicineUsed, size, newCapacity);
+    growColumn(statuses, size, newCapacity);
+    growColumn(previous, size, newCapacity);
+    growColumn(byStart, size, newCapacity);
+    capacity = newCapacity;
+}
+
+// Adds (sign 1) or takes back (sign -1) one record's figures in its three rollups
+void ShiftLog::applyToRollups(int index, int sign) {
+    ShiftRollup* groups[] = {
+        &ambulanceRollups.getOrInsert(ambulanceIds[index]),
+        &driverRollups.getOrInsert(driverNames[index]),
+        &dayRollups.getOrInsert(startTexts[index].substr(0, 10)),
+    };
+    for (ShiftRollup* rollup : groups) {
+        rollup->shifts += sign;
+        rollup->hours += sign * durationHours[index];
+        rollup->cases_handled += sign * casesHandled[index];
+        rollup->distance_km += sign * distancesKm[index];
+        rollup->oxygen_used += sign * oxygenUsed[index];
+        rollup->medicine_used += sign * medicineUsed[index];
+    }
+}
+
+int ShiftLog::append(const ShiftRecord& record, int previousIndex) {
+    if (size == capacity) grow();
+
+    const int index = size;
+    shiftIds[index] = record.shift_id;
+    ambulanceIds[index] = record.ambulance_id;
+    driverNames[index] = record.driver_name;
+    startTexts[index] = record.shift_start;
+    endTexts[index] = record.shift_end;
+    starts[index] = parseDatetime(record.shift_start);
+    ends[index] = parseDatetime(record.shift_end);
+    durationHours[index] = record.shift_duration_hours;
+    caseIds[index] = record.assigned_case_id;
+    casesHandled[index] = record.cases_handled;
+    distancesKm[index] = record.total_distance_km;
+    oxygenUsed[index] = record.oxygen_used;
+    medicineUsed[index] = record.medicine_used;
+    statuses[index] = record.status_at_end;
+    previous[index] = previousIndex;
+
+    if (ends[index] - starts[index] > longestShift) {
+        longestShift = ends[index] - starts[index];
+    }
+
+    // Insert after every record with the same or an earlier start, usually the last position
+    int position = size;
+    while (position > 0 && starts[byStart[position - 1]] > starts[index]) {
+        byStart[position] = byStart[position - 1];
+        position--;
+    }
+    byStart[position] = index;
+    size++;
+
+    if (!isCancelled(index)) applyToRollups(index, 1);
+    return index;
+}
+
+void ShiftLog::setStatus(int index, const std::string& status) {
+    const bool wasCancelled = isCancelled(index);
+    statuses[index] = status;
+    const bool cancelled = isCancelled(index);
+
+    if (cancelled && !wasCancelled) applyToRollups(index, -1);
+    if (!cancelled && wasCancelled) applyToRollups(index, 1);
+}
+
+ShiftRecord ShiftLog::getRecord(int index) const {
+    ShiftRecord sr;
+    sr.shift_id = shiftIds[index];
+    sr.ambulance_id = ambulanceIds[index];
+    sr.driver_name = driverNames[index];
+    sr.shift_start = startTexts[index];
+    sr.shift_end = endTexts[index];
+    sr.shift_duration_hours = durationHours[index];
+    sr.assigned_case_id = caseIds[index];
+    sr.cases_handled = casesHandled[index];
+    sr.total_distance_km = distancesKm[index];
+    sr.oxygen_used = oxygenUsed[index];
+    sr.medicine_used = medicineUsed[index];
+    sr.status_at_end = statuses[index];
+    return sr;
+}
+
+void ShiftLog::clear() {
+    size = 0;
+    longestShift = 0;
+    ambulanceRollups.clear();
+    driverRollups.clear();
+    dayRollups.clear();
+}
+
+int ShiftLog::lowerBoundStart(long long t) const {
+    int low = 0;
+    int high = size;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (starts[byStart[mid]] < t) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
@@ -0,0 +1,203 @@
+#include "ambulance_dispatcher.hpp"
+#include "hash_map.hpp"
+#include "time_utils.hpp"
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Column widths shared by every rollup table
+static const int wKey = 22, wShifts = 8, wHours = 8, wCases = 8, wAvgCases = 11, wKm = 10, wAvgKm = 10, wOxygen = 8, wMedicine = 10;
+
+static void printRollupHeader(const std::string& keyTitle) {
+    std::cout << "\n" << std::left
+              << std::setw(wKey) << keyTitle
+              << std::setw(wShifts) << "Shifts"
+              << std::setw(wHours) << "Hours"
+              << std::setw(wCases) << "Cases"
+              << std::setw(wAvgCases) << "Avg Cases"
+              << std::setw(wKm) << "Km"
+              << std::setw(wAvgKm) << "Avg Km"
+              << std::setw(wOxygen) << "Oxygen"
+              << std::setw(wMedicine) << "Medicine" << "\n";
+    std::cout << std::string(wKey + wShifts + wHours + wCases + wAvgCases + wKm + wAvgKm + wOxygen + wMedicine, '-') << "\n";
+}
+
+static void printRollupRow(const std::string& key, const ShiftRollup& rollup) {
+    const double avgCases = rollup.shifts > 0 ? static_cast<double>(rollup.cases_handled) / rollup.shifts : 0.0;
+    const double avgKm = rollup.shifts > 0 ? rollup.distance_km / rollup.shifts : 0.0;
+
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(wKey) << key
+              << std::setw(wShifts) << rollup.shifts
+              << std::setw(wHours) << rollup.hours
+              << std::setw(wCases) << rollup.cases_handled
+              << std::setw(wAvgCases) << avgCases
+              << std::setw(wKm) << rollup.distance_km
+              << std::setw(wAvgKm) << avgKm
+              << std::setw(wOxygen) << rollup.oxygen_used
+              << std::setw(wMedicine) << rollup.medicine_used << "\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Shift reports menu
+void AmbulanceDispatcher::displayShiftReportsMenu() {
+    int choice;
+    do {
+        std::cout << "\n=== Shift Reports ===\n";
+        std::cout << "1. Totals per Ambulance\n";
+        std::cout << "2. Totals per Driver\n";
+        std::cout << "3. Daily Totals for a Date Range\n";
+        std::cout << "4. Fleet Utilization for a Date Range\n";
+        std::cout << "5. Back\n";
+        std::cout << "Enter choice: ";
+        if (!(std::cin >> choice)) {
+            std::cin.clear();
+            std::cin.ignore(1000, '\n');
+            std::cout << "Invalid choice. Try again.\n";
+            continue;
+        }
+        std::cin.ignore();
+        switch (choice) {
+            case 1: reportShiftsByAmbulance(); break;
+            case 2: reportShiftsByDriver(); break;
+            case 3: reportShiftsByDay(); break;
+            case 4: reportFleetUtilization(); break;
+            case 5: break;
+            default: std::cout << "Invalid choice. Try again.\n";
+        }
+    } while (choice != 5);
+}
+
+// Reads a report start date and a number of days into [from, to)
+bool AmbulanceDispatcher::promptReportRange(long long& from, long long& to) {
+    std::string input;
+    std::cout << "Enter From Date (YYYY-MM-DD): ";
+    std::getline(std::cin, input);
+    from = parseDatetime(input);
+    if (from < 0) {
+        std::cout << "Invalid date. Use YYYY-MM-DD.\n";
+        return false;
+    }
+
+    int days;
+    std::cout << "Enter Number of Days (1-" << MAX_REPORT_DAYS << "): ";
+    std::cin >> days;
+    std::cin.ignore();
+    if (days < 1 || days > MAX_REPORT_DAYS) {
+        std::cout << "Number of days must be between 1 and " << MAX_REPORT_DAYS << ".\n";
+        return false;
+    }
+    to = from + static_cast<long long>(days) * 24 * 3600;
+    return true;
+}
+
+// All-time totals and averages per ambulance, read straight from the rollups
+void AmbulanceDispatcher::reportShiftsByAmbulance() {
+    if (fleet.getCount() == 0) {
+        std::cout << "No ambulances available.\n";
+        return;
+    }
+
+    printRollupHeader("Ambulance");
+    for (int i = 0; i < fleet.getCount(); i++) {
+        const std::string &id = fleet.at(i).ambulance_id;
+        const ShiftRollup* rollup = shifts.getAmbulanceRollup(id);
+        printRollupRow(id, rollup ? *rollup : ShiftRollup{});
+    }
+}
+
+// All-time totals and averages per driver, alphabetically
+void AmbulanceDispatcher::reportShiftsByDriver() {
+    int count = 0;
+    shifts.forEachDriverRollup([&count](const std::string&, const ShiftRollup& rollup) {
+        if (rollup.shifts > 0) count++;
+    });
+    if (count == 0) {
+        std::cout << "No shifts recorded.\n";
+        return;
+    }
+
+    // Drivers are few, an insertion sort keeps the listing stable
+    std::string* names = new std::string[count];
+    int filled = 0;
+    shifts.forEachDriverRollup([names, &filled](const std::string& name, const ShiftRollup& rollup) {
+        if (rollup.shifts <= 0) return;
+        int i = filled++;
+        while (i > 0 && names[i - 1] > name) {
+            names[i] = names[i - 1];
+            i--;
+        }
+        names[i] = name;
+    });
+
+    printRollupHeader("Driver");
+    for (int i = 0; i < count; i++) {
+        printRollupRow(names[i], *shifts.getDriverRollup(names[i]));
+    }
+    delete[] names;
+}
+
+// One rollup row per day that has shifts starting in the range
+void AmbulanceDispatcher::reportShiftsByDay() {
+    long long from, to;
+    if (!promptReportRange(from, to)) return;
+
+    printRollupHeader("Day");
+    std::string lastDay;
+    int days = 0;
+    shifts.forEachStartingIn(from, to, [this, &lastDay, &days](int index) {
+        const std::string day = shifts.getStartText(index).substr(0, 10);
+        if (day == lastDay) return;
+        lastDay = day;
+
+        const ShiftRollup* rollup = shifts.getDayRollup(day);
+        if (rollup && rollup->shifts > 0) {
+            printRollupRow(day, *rollup);
+            days++;
+        }
+    });
+    if (days == 0) {
+        std::cout << "No shifts in this range.\n";
+    }
+}
+
+// Share of the range each ambulance spends on shift, partial shifts at the edges are clipped
+void AmbulanceDispatcher::reportFleetUtilization() {
+    long long from, to;
+    if (!promptReportRange(from, to)) return;
+
+    StringHashMap<long long> secondsOnShift;
+    StringHashMap<int> shiftsInRange;
+    shifts.forEachOverlapping(from, to, [this, from, to, &secondsOnShift, &shiftsInRange](int index) {
+        if (shifts.isCancelled(index)) return;
+
+        const long long start = shifts.getStart(index) > from ? shifts.getStart(index) : from;
+        const long long end = shifts.getEnd(index) < to ? shifts.getEnd(index) : to;
+        secondsOnShift.getOrInsert(shifts.getAmbulanceId(index)) += end - start;
+        shiftsInRange.getOrInsert(shifts.getAmbulanceId(index))++;
+    });
+
+    const double rangeHours = static_cast<double>(to - from) / 3600.0;
+    double fleetHours = 0.0;
+
+    std::cout << "\n=== Fleet Utilization " << formatDatetime(from) << " - " << formatDatetime(to) << " ===\n";
+    std::cout << std::left << std::setw(12) << "Ambulance" << std::setw(22) << "Driver"
+              << std::setw(8) << "Shifts" << std::setw(10) << "Hours" << "Utilization\n";
+    std::cout << std::string(64, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (int i = 0; i < fleet.getCount(); i++) {
+        const Ambulance &amb = fleet.at(i);
+        const long long* seconds = secondsOnShift.find(amb.ambulance_id);
+        const int* count = shiftsInRange.find(amb.ambulance_id);
+        const double hours = seconds ? static_cast<double>(*seconds) / 3600.0 : 0.0;
+        fleetHours += hours;
+
+        std::cout << std::setw(12) << amb.ambulance_id << std::setw(22) << amb.driver_name
+                  << std::setw(8) << (count ? *count : 0) << std::setw(10) << hours
+                  << (100.0 * hours / rangeHours) << "%\n";
+    }
+    std::cout << "Coverage hours scheduled: " << fleetHours << " of " << rangeHours << " range hours\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
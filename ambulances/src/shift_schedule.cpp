@@ -0,0 +1,162 @@
+#include "shift_schedule.hpp"
+
+ShiftSchedule::ShiftSchedule() : root(nullptr), size(0) {}
+
+// Nodes belong to the pool and are freed with it
+ShiftSchedule::~ShiftSchedule() = default;
+
+// Start time first; ambulance and shift ID break ties so equal starts keep a fixed order
+bool ShiftSchedule::isBefore(const ShiftInterval& a, const ShiftInterval& b) {
+    if (a.start != b.start) return a.start < b.start;
+    if (a.ambulance_id != b.ambulance_id) return a.ambulance_id < b.ambulance_id;
+    return a.shift_id < b.shift_id;
+}
+
+void ShiftSchedule::update(Node* node) {
+    const int leftHeight = heightOf(node->left);
+    const int rightHeight = heightOf(node->right);
+    node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+
+    node->max_end = node->shift.end;
+    if (node->left && node->left->max_end > node->max_end) node->max_end = node->left->max_end;
+    if (node->right && node->right->max_end > node->max_end) node->max_end = node->right->max_end;
+}
+
+ShiftSchedule::Node* ShiftSchedule::rotateLeft(Node* node) {
+    Node* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    update(node);
+    update(pivot);
+    return pivot;
+}
+
+ShiftSchedule::Node* ShiftSchedule::rotateRight(Node* node) {
+    Node* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    update(node);
+    update(pivot);
+    return pivot;
+}
+
+// Restores the AVL height invariant after one insert or removal below node
+ShiftSchedule::Node* ShiftSchedule::rebalance(Node* node) {
+    update(node);
+    const int balance = heightOf(node->left) - heightOf(node->right);
+    if (balance > 1) {
+        if (heightOf(node->left->left) < heightOf(node->left->right)) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        if (heightOf(node->right->right) < heightOf(node->right->left)) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+ShiftSchedule::Node* ShiftSchedule::insertAt(Node* node, const ShiftInterval& shift) {
+    if (!node) {
+        Node* created = nodes.acquire();
+        created->shift = shift;
+        created->max_end = shift.end;
+        created->height = 1;
+        created->left = nullptr;
+        created->right = nullptr;
+        return created;
+    }
+    if (isBefore(shift, node->shift)) {
+        node->left = insertAt(node->left, shift);
+    } else {
+        node->right = insertAt(node->right, shift);
+    }
+    return rebalance(node);
+}
+
+ShiftSchedule::Node* ShiftSchedule::detachMin(Node* node, Node*& minimum) {
+    if (!node->left) {
+        minimum = node;
+        return node->right;
+    }
+    node->left = detachMin(node->left, minimum);
+    return rebalance(node);
+}
+
+ShiftSchedule::Node* ShiftSchedule::removeAt(Node* node, const ShiftInterval& shift, bool& removed) {
+    if (!node) return nullptr;
+
+    if (isBefore(shift, node->shift)) {
+        node->left = removeAt(node->left, shift, removed);
+    } else if (isBefore(node->shift, shift)) {
+        node->right = removeAt(node->right, shift, removed);
+    } else {
+        removed = true;
+        Node* left = node->left;
+        Node* right = node->right;
+        nodes.release(node);
+        if (!right) return left;
+
+        // The in-order successor takes the removed node's place
+        Node* successor = nullptr;
+        Node* rest = detachMin(right, successor);
+        successor->left = left;
+        successor->right = rest;
+        return rebalance(successor);
+    }
+    return rebalance(node);
+}
+
+bool ShiftSchedule::insert(const ShiftInterval& shift) {
+    if (shift.end <= shift.start) return false;
+    root = insertAt(root, shift);
+    size++;
+    return true;
+}
+
+bool ShiftSchedule::remove(const ShiftInterval& shift) {
+    bool removed = false;
+    root = removeAt(root, shift, removed);
+    if (removed) size--;
+    return removed;
+}
+
+void ShiftSchedule::releaseAll(Node* node) {
+    if (!node) return;
+    releaseAll(node->left);
+    releaseAll(node->right);
+    nodes.release(node);
+}
+
+void ShiftSchedule::clear() {
+    releaseAll(root);
+    root = nullptr;
+    size = 0;
+}
+
+int ShiftSchedule::countCovering(long long t) const {
+    int covering = 0;
+    forEachCovering(t, [&covering](const ShiftInterval&) { covering++; });
+    return covering;
+}
+
+// Overlapping shifts arrive in start order, so everything before the furthest end seen so far is covered
+int ShiftSchedule::findGaps(long long from, long long to, CoverageGap* gaps, int maxGaps) const {
+    int found = 0;
+    long long coveredUntil = from;
+    forEachOverlapping(from, to, [&](const ShiftInterval& shift) {
+        if (shift.start > coveredUntil) {
+            if (found < maxGaps) gaps[found] = CoverageGap{coveredUntil, shift.start};
+            found++;
+        }
+        if (shift.end > coveredUntil) coveredUntil = shift.end;
+    });
+    if (coveredUntil < to) {
+        if (found < maxGaps) gaps[found] = CoverageGap{coveredUntil, to};
+        found++;
+    }
+    return found;
+}
@@ -4,10 +4,10 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <filesystem>
 
 #include "message_handler.hpp"
-
-#define MAX_USERS 100 // Maximum number of users supported
+#include "hash_map.hpp"
 
 /**
  * @struct UserCredential
@@ -26,15 +26,22 @@ struct UserCredential {
  */
 class Login {
 private:
-    UserCredential users[MAX_USERS];
-    int user_count;
+    StringHashMap<UserCredential> users; /// Credentials keyed by username
     std::string credentials_file;
+    std::filesystem::file_time_type loaded_time; /// Modification time of the file when it was last loaded
+    std::uintmax_t loaded_size;                  /// Size of the file when it was last loaded
+    bool loaded;
 
     /**
-     * @brief Load user credentials from CSV into array
+     * @brief Load user credentials from CSV into the username index
      */
     void loadCredentials();
 
+    /**
+     * @brief Reloads the credentials only if the file changed since it was last loaded
+     */
+    void refreshCredentials();
+
     /**
      * @brief Attempt login for a user
      * @param username Input username
@@ -7,12 +7,19 @@
  * @class SessionManager
  * @brief Handles user session flow including logout and re-login loop
  *
+ * @details
+ * - start() owns a single Login for the whole program run, credentials are parsed once and
+ *   only reloaded when the file changes
+ * - The session loop is iterative: a role menu returns to it, so any number of logins and
+ *   logouts runs in constant stack depth
+ *
  * @usage
  * For all role classes
  * 1. Include this header: #include "session_manager.hpp"
  * 2. When the user selects "Logout" in their menu:
  *      @code
  *      SessionManager::logout(credentials_file);
+ *      return; // Back to the login loop
  *      @encode
  *
  */
@@ -28,7 +35,8 @@ public:
 
     /**
      * @brief Handles logout for any role
-     * @details Displays a message and triggers re-login by calling start();
+     * @details Displays the logout message only, the caller returns from its menu and the
+     *          running start() loop prompts for the next login
      */
     static void logout(const std::string& credentials_path);
 };
@@ -17,15 +17,15 @@
  * @brief Constructor for Login
  * @param filepath Path to the user credentials CSV file
  */
-Login::Login(const std::string& filepath) {
-    credentials_file = filepath;
-    user_count = 0;
-    loadCredentials();
+Login::Login(const std::string& filepath) : credentials_file(filepath), loaded_size(0), loaded(false) {
+    refreshCredentials();
 }
 
 /**
- * @brief Load user credentials from CSV into static array
- * @details Supports a maximum of MAX_USERS
+ * @brief Load user credentials from CSV into the username index
+ * @details
+ * - No fixed user limit, lookups stay O(1) however large the roster is
+ * - If a username appears more than once, the first row wins
  */
 void Login::loadCredentials() {
     std::ifstream file(credentials_file.c_str());
@@ -34,10 +34,11 @@ void Login::loadCredentials() {
         return;
     }
 
+    users.clear();
     std::string line;
     std::getline(file, line); // Skip CSV header
 
-    while (std::getline(file, line) && user_count < MAX_USERS) {
+    while (std::getline(file, line)) {
         std::stringstream ss(line);
         std::string username, password, role;
 
@@ -49,15 +50,39 @@ void Login::loadCredentials() {
         password = trim(password);
         role     = trim(role);
 
-        users[user_count].username = username;
-        users[user_count].password = password;
-        users[user_count].role = role;
-
-        user_count++;
+        if (users.contains(username)) {
+            MessageHandler::warning("Duplicate username in credentials file ignored: " + username);
+            continue;
+        }
+        users.insertOrAssign(username, UserCredential{username, password, role});
     }
     file.close();
 }
 
+/**
+ * @brief Reloads the credentials when the file's modification time or size changed
+ * @details Called before every login prompt, so roster edits apply without restarting
+ *          while an unchanged file costs one stat instead of a full parse
+ */
+void Login::refreshCredentials() {
+    std::error_code ec;
+    const std::filesystem::file_time_type time = std::filesystem::last_write_time(credentials_file, ec);
+    if (ec) {
+        if (!loaded) loadCredentials(); // Reports the missing file
+        loaded = true;
+        return;
+    }
+    const std::uintmax_t size = std::filesystem::file_size(credentials_file, ec);
+    if (loaded && !ec && time == loaded_time && size == loaded_size) {
+        return;
+    }
+
+    loadCredentials();
+    loaded_time = time;
+    loaded_size = ec ? 0 : size;
+    loaded = true;
+}
+
 /**
  * @brief Attempt login with given username and password
  * @param username Input username
@@ -65,10 +90,9 @@ void Login::loadCredentials() {
  * @return Role string if login successful, empty string if failed
  */
 std::string Login::attemptLogin(const std::string &username, const std::string &password) {
-    for (int i = 0; i < user_count; i++) {
-        if (users[i].username == username && users[i].password == password) {
-            return users[i].role;
-        }
+    const UserCredential* user = users.find(username);
+    if (user != nullptr && user->password == password) {
+        return user->role;
     }
     return ""; // Login failed
 }
@@ -86,6 +110,8 @@ bool Login::promptLogin() {
     std::string username, password;
 
     while (true) {
+        refreshCredentials();
+
         std::cout << "Please enter your username (or enter 'exit', 'quit', or 'q' to quit): ";
         std::cout.flush();
         std::getline(std::cin, username);
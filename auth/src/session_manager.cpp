@@ -15,11 +15,11 @@ void SessionManager::start(const std::string& credentials_path) {
 }
 
 /**
- * @brief Handles logout and re-login
+ * @brief Handles logout, re-login is left to the loop in start()
  * @param credentials_path Path to user credentials file
  */
 void SessionManager::logout(const std::string &credentials_path) {
+    (void)credentials_path; // Kept for existing callers, the login loop already knows the file
     MessageHandler::info("Logging out...");
     MessageHandler::info("Returning to login...");
-    start(credentials_path);
 }
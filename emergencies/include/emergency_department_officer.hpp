@@ -15,10 +15,13 @@ private:
 
     void displayMenu();
     void viewCases();
+    void searchCases();
     void addCase();
     void processHighestPriorityCase();
 
     void completeProcessingCase();
+    void viewReports();
+    void viewRollup(int option);
 
 public:
     EmergencyDepartmentOfficer();
@@ -1,5 +1,6 @@
 #ifndef EMERGENCY_MANAGER_HPP
 #define EMERGENCY_MANAGER_HPP
+#define CASE_ID_BASE 3350 // Generated case IDs start above CASE-3350
 
 #include <iostream>
 #include <string>
@@ -7,6 +8,48 @@
 #include "message_handler.hpp"
 #include "string_utils.hpp"
 #include "path_utils.hpp"
+#include "paging.hpp"
+#include "node_arena.hpp"
+#include "hash_map.hpp"
+#include "response_analytics.hpp"
+
+/**
+ * @brief Sort orders supported by EmergencyManager::queryCases
+ */
+enum CaseSortKey {
+    SORT_CASES_BY_PRIORITY,    /// Priority, then status (Pending, Processing, Completed), then logged time
+    SORT_CASES_BY_LOGGED_TIME, /// Oldest logged first
+    SORT_CASES_BY_CASE_ID      /// Ascending case number
+};
+
+/**
+ * @struct CaseQuery
+ * @brief Filter and ordering used for paged case listings
+ *
+ * @details
+ * Empty strings mean "any" for that field. Dates are "YYYY-MM-DD" and are
+ * compared (inclusive) against the date part of Timestamp_Logged
+ */
+struct CaseQuery {
+    std::string status;         /// "Pending", "Processing", "Completed" or "" for any
+    std::string emergency_type; /// Emergency type (case-insensitive) or "" for any
+    int min_priority = 1;
+    int max_priority = 5;
+    std::string date_from;
+    std::string date_to;
+    CaseSortKey sort_key = SORT_CASES_BY_PRIORITY;
+};
+
+/**
+ * @struct CasePage
+ * @brief One materialized page of a case query
+ */
+struct CasePage {
+    EmergencyCase items[LIST_PAGE_SIZE];
+    int count = 0;
+    bool has_more = false;
+    std::string next_cursor; /// Opaque token, pass it back to queryCases to resume after this page
+};
 
 class EmergencyManager {
 private:
@@ -43,8 +86,14 @@ private:
         std::string supplyID;   // Supply_Batch_ID
         std::string supplyName;
         std::string supplyType;
-        int stockQuantity;
+        int stockQuantity;      // On hand per medical_supply.csv, the supply manager deducts from it
+        std::string expiryDate; // "YYYY-MM-DD"
+        int reservedQuantity;   // Logged for cases this session, not yet deducted by the supply manager
+        bool inFefoHeap;        // Still allocatable through consumeSupplyFEFO
         SupplyNode* next;
+
+        // Units still free to log, the figure every listing and check uses
+        int availableUnits() const { return stockQuantity - reservedQuantity; }
     };
 
     struct AmbulanceNode {
@@ -60,6 +109,55 @@ private:
     SupplyNode* supplyHead = nullptr;
     AmbulanceNode* ambHead = nullptr;
 
+    ResponseAnalytics analytics; // Latency digests, fed as cases load and change status
+
+    // Each list's nodes live in their own arena: a full load is a handful of chunk
+    // allocations and teardown frees chunks rather than walking every list
+    NodeArena<Node> caseNodes;
+    NodeArena<PatientNode> patientNodes;
+    NodeArena<TypeNode> typeNodes;
+    NodeArena<SupplyTypeNode> supplyTypeNodes;
+    NodeArena<UniqueSupplyNode> uniqueSupplyNodes;
+    NodeArena<SupplyNode> supplyNodes;
+    NodeArena<AmbulanceNode> ambulanceNodes;
+
+    // Supply catalog index, built once by loadSupplyData. Each menu level is a slice of a
+    // flat array in the same order the lists are printed, so picking entry i is O(1)
+    struct CatalogRange {
+        int first = 0;
+        int count = 0;
+        int units = 0; // FEFO heaps only: units left to allocate across the heap
+    };
+    SupplyTypeNode** catalogTypes = nullptr;        // Type menu
+    int catalogTypeCount = 0;
+    UniqueSupplyNode** catalogNames = nullptr;      // Name menus, grouped by type
+    SupplyNode** catalogBatches = nullptr;          // Batch menus, grouped by supply name
+    int catalogBatchCount = 0;
+    StringHashMap<CatalogRange> namesByType;        // Also the set of known supply types
+    StringHashMap<CatalogRange> batchesByName;
+    StringHashMap<bool> knownUniqueSupplies;        // "name|type" pairs already in the name list
+
+    // First-expiry-first-out allocation: per supply name, a binary min-heap of its
+    // unexpired batches keyed by expiry date, stored as a slice of fefoHeaps
+    SupplyNode** fefoHeaps = nullptr;
+    StringHashMap<CatalogRange> fefoByName;
+
+    // Dirty tracking: saveToCSV only touches the file when the case list changed since the last save
+    unsigned long generation = 0;      // Bumped on every change to the case list
+    unsigned long savedGeneration = 0; // Generation last loaded from or written to disk
+    bool needsFullRewrite = false;     // Existing rows changed or the file has the legacy layout, appending is not enough
+    DynamicArray unsavedCaseIDs;       // Cases added since the last save
+    std::string poppedCaseID;          // Taken out by popHighestPriorityPendingCase(), re-added by updateCase()
+    bool loading = false;              // Cases inserted by loadFromCSV are already on disk
+    StringHashMap<int> pendingArrivals; // "hour bucket|type" arrival deltas, journaled once the cases are saved
+
+    // Writes the binary snapshot of the case list next to the CSV
+    void saveSnapshot(const std::string& filename, unsigned long long csvSize) const;
+
+    // Arrival rollups follow the case file: deltas wait here until saveToCSV has written the cases
+    void stageArrival(const std::string& timestampLogged, const std::string& type, int delta);
+    void journalPendingArrivals();
+
     // Private helper to add a patient to the list
     void addPatient(const std::string& id, const std::string& name);
     void addType(const std::string& type);
@@ -67,7 +165,14 @@ private:
     // Private helpers for supply management
     void addSupplyType(const std::string& type);
     void addUniqueSupply(const std::string& name, const std::string& type);
-    void addSupply(const std::string& id, const std::string& name, const std::string& type, int stockQty);
+    void addSupply(const std::string& id, const std::string& name, const std::string& type, int stockQty,
+                   const std::string& expiryDate);
+    void buildSupplyCatalog();
+    void buildFefoHeaps();
+    static bool expiresBefore(const SupplyNode* a, const SupplyNode* b);
+    static void siftDownFefo(SupplyNode** heap, int count, int index);
+    void popFefo(CatalogRange& heap);
+    void clearSupplyCatalog();
 
     // Private helper to add an ambulance to the list
     void addAmbulance(const Ambulance& amb);
@@ -76,7 +181,7 @@ private:
 
 public:
     EmergencyManager() = default;
-    ~EmergencyManager(); // Updated to clear all lists
+    ~EmergencyManager(); // The arenas free every list, only the catalog index is freed by hand
 
     // Managing patient data
     void loadPatientData(const std::string& patientDataFile);
@@ -93,6 +198,23 @@ public:
     
     void printAllCases() const;
     void printCasesByStatus(const std::string& status) const;
+
+    /**
+     * @brief Materializes one page of cases matching a query
+     * @param query Filter and sort key
+     * @param cursor "" for the first page, otherwise the next_cursor of the previous page
+     * @return Up to LIST_PAGE_SIZE cases that sort after the cursor
+     *
+     * @details
+     * Keyset pagination: a single pass over the list keeps only the best LIST_PAGE_SIZE
+     * candidates, so memory stays flat no matter how many cases exist
+     */
+    CasePage queryCases(const CaseQuery& query, const std::string& cursor) const;
+
+    /**
+     * @brief Prints the results of a query page by page, prompting between pages
+     */
+    void printCasesPaged(const CaseQuery& query, const std::string& title) const;
     
     int printSuppliesByType(const std::string& type) const;
     SupplyNode* getSupplyByTypeAndIndex(const std::string& type, int index) const;
@@ -103,6 +225,28 @@ public:
     EmergencyCase popHighestPriorityPendingCase();
 
     void updateCase(const EmergencyCase& ec);
+
+    /**
+     * @brief Records that a case obtained through getCaseByID() was modified in place
+     */
+    void markCaseModified();
+
+    /**
+     * @brief Feeds a case that just moved to "Processing" or "Completed" to the response analytics
+     * @details addCase() already records loaded and re-inserted cases, callers that change the
+     *          status of a case in place call this
+     */
+    void recordCaseTransition(const EmergencyCase& ec) { analytics.record(ec); }
+
+    /**
+     * @brief Prints the response-time dashboard, no case is rescanned
+     */
+    void printResponseDashboard() { analytics.printDashboard(); }
+
+    /**
+     * @brief Checks if the case list changed since it was last loaded or saved
+     */
+    bool hasUnsavedChanges() const { return generation != savedGeneration || needsFullRewrite; }
     std::string generateNextCaseID();
     bool isEmpty() const { return head == nullptr; }
 
@@ -131,6 +275,27 @@ public:
 
     EmergencyCase* getCaseByID(const std::string& caseID);
     void logSupplyUsage(const EmergencyCase& ec, const std::string& supplyID, const std::string& supplyName, int quantity);
+
+    /**
+     * @brief Logs usage of a batch the officer picked by hand and reserves those units
+     */
+    void logBatchUsage(const EmergencyCase& ec, SupplyNode* batch, int quantity);
+
+    /**
+     * @brief Units of a supply that consumeSupplyFEFO can still allocate
+     */
+    int getFefoAvailableUnits(const std::string& supplyName) const;
+
+    /**
+     * @brief Uses quantity units of a supply, earliest-expiring batches first
+     * @return Units actually allocated, less than quantity only if stock ran out
+     *
+     * @details
+     * - The request is split across batches automatically, one usage log row per batch
+     * - Each step is O(log batches): the heap top is used up, then popped
+     * - Batches that expired since load, or have nothing left, are dropped from the heap
+     */
+    int consumeSupplyFEFO(const EmergencyCase& ec, const std::string& supplyName, int quantity);
 };
 
 #endif // EMERGENCY_MANAGER_HPP
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef RESPONSE_ANALYTICS_HPP
+#define RESPONSE_ANALYTICS_HPP
+
+#include <string>
+#include "entities.hpp"
+#include "hash_map.hpp"
+#include "tdigest.hpp"
+
+#define ANALYTICS_PRIORITY_LEVELS 5 // Priorities 1 (critical) to 5, anything else is counted as 5
+
+/**
+ * @brief Which transition a latency measures
+ */
+enum class ResponseStage { Dispatch, Completion };
+
+/**
+ * @struct LatencyStats
+ * @brief Latency distribution of one group of cases, in minutes
+ */
+struct LatencyStats {
+    TDigest minutes;
+    long long breaches = 0; /// Cases slower than their priority's SLA target
+};
+
+/**
+ * @brief Incremental response-time analytics per priority and per emergency type
+ *
+ * @details
+ * - Dispatch latency runs from Timestamp_Logged to the move to "Processing", completion
+ *   latency from Timestamp_Logged to "Completed"
+ * - Each case is recorded once per transition, while the case file loads and when an officer
+ *   moves it on, into a t-digest per (stage, priority) and per (stage, emergency type). The
+ *   dashboard reads the digests and never rescans the cases
+ * - SLA targets depend on the priority, see dispatchTargetMinutes() / completionTargetMinutes()
+ * - The case file keeps only the latest transition time, so a case completed in an earlier
+ *   session contributes its completion latency only
+ *
+ * @usage
+ *      ResponseAnalytics analytics;
+ *      analytics.record(emergencyCase);        // Status "Processing" or "Completed"
+ *      analytics.printDashboard();
+ */
+class ResponseAnalytics {
+private:
+    LatencyStats dispatchByPriority[ANALYTICS_PRIORITY_LEVELS];
+    LatencyStats completionByPriority[ANALYTICS_PRIORITY_LEVELS];
+    StringHashMap<LatencyStats> dispatchByType;
+    StringHashMap<LatencyStats> completionByType;
+
+    static int priorityIndex(int priority);
+    static long long parseTimestamp(const std::string& timestamp);
+    void printStage(ResponseStage stage);
+
+public:
+    /**
+     * @brief Records the latency of the transition a case just made
+     * @return false if the case is pending or its timestamps cannot be read
+     */
+    bool record(const EmergencyCase& ec);
+
+    /**
+     * @brief Latency distribution of one priority
+     */
+    LatencyStats& byPriority(ResponseStage stage, int priority);
+
+    /**
+     * @brief Latency distribution of one emergency type, nullptr if no case of that type was recorded
+     */
+    LatencyStats* byType(ResponseStage stage, const std::string& emergencyType);
+
+    static double dispatchTargetMinutes(int priority);
+    static double completionTargetMinutes(int priority);
+
+    /**
+     * @brief Prints p50/p90/p99, max and SLA breaches for both stages, per priority and per type
+     */
+    void printDashboard();
+};
+
+#endif // RESPONSE_ANALYTICS_HPP
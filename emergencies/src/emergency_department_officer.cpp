@@ -3,6 +3,8 @@
 #include "message_handler.hpp"
 #include "path_utils.hpp"
 #include "time_utils.hpp"
+#include "hospital_reports.hpp"
+#include "rollup_store.hpp"
 #include <cstdlib> // For rand()
 #include <string>
 #include <ctime>
@@ -96,7 +98,8 @@ void EmergencyDepartmentOfficer::displayMenu() {
         std::cout << "2. Add new emergency case\n";
         std::cout << "3. Process highest priority case\n";
         std::cout << "4. Complete a 'Processing' case\n";
-        std::cout << "5. Exit\n";
+        std::cout << "5. Reports\n";
+        std::cout << "6. Exit\n";
         std::cout << "Select an option: ";
 
         std::string choice;
@@ -106,7 +109,8 @@ void EmergencyDepartmentOfficer::displayMenu() {
         else if (choice == "2") addCase();
         else if (choice == "3") processHighestPriorityCase();
         else if (choice == "4") completeProcessingCase();
-        else if (choice == "5") {
+        else if (choice == "5") viewReports();
+        else if (choice == "6") {
             manager.saveToCSV(dataFile);
             MessageHandler::info("Exiting Emergency Department Officer menu...\n");
             break;
@@ -116,6 +120,88 @@ void EmergencyDepartmentOfficer::displayMenu() {
     }
 }
 
+// Prints one materialized rollup view over a day range, read from the rollups, no file is scanned
+void EmergencyDepartmentOfficer::viewRollup(int option) {
+    std::string input;
+    std::cout << "Enter From Date (YYYY-MM-DD): ";
+    std::getline(std::cin, input);
+    const long long from = parseDatetime(trim(input));
+    if (from < 0) {
+        MessageHandler::warning("Invalid date. Use YYYY-MM-DD.");
+        return;
+    }
+    const int days = getValidatedInt("Enter Number of Days (1-366): ", 1, 366);
+    const std::string fromBucket = formatDatetime(from).substr(0, 10);
+    const std::string toBucket = formatDatetime(from + static_cast<long long>(days) * 24 * 3600 + 12 * 3600).substr(0, 10);
+
+    RollupStore &rollups = RollupStore::instance();
+    if (option == 6) {
+        std::cout << "\n=== Hourly Case Arrivals by Type ===\n";
+        rollups.printView(ROLLUP_CASE_ARRIVALS, fromBucket, toBucket, "Hour", "Cases");
+    } else if (option == 7) {
+        std::cout << "\n=== Daily Supply Burn by Item (units used on cases) ===\n";
+        rollups.printView(ROLLUP_SUPPLY_BURN, fromBucket, toBucket, "Day", "Units");
+        std::cout << "\n=== Daily Stock Deductions by Item ===\n";
+        rollups.printView(ROLLUP_SUPPLY_DEDUCTED, fromBucket, toBucket, "Day", "Units");
+    } else {
+        std::cout << "\n=== Daily Admissions and Discharges ===\n";
+        rollups.printView(ROLLUP_QUEUE_DAILY, fromBucket, toBucket, "Day", "Patients");
+    }
+}
+
+// Reports menu, joins the case file with patients, supply usage and ambulances
+void EmergencyDepartmentOfficer::viewReports() {
+    // Reports read the files, pending cases must be on disk first
+    manager.saveToCSV(dataFile);
+    HospitalReports reports;
+
+    while (true) {
+        std::cout << "\n--- Reports ---\n";
+        std::cout << "1. Supply consumption per emergency type\n";
+        std::cout << "2. Cases of one emergency type with supplies and ambulance\n";
+        std::cout << "3. Patient case history\n";
+        std::cout << "4. Case load per ambulance\n";
+        std::cout << "5. Response time dashboard\n";
+        std::cout << "6. Hourly case arrivals by type\n";
+        std::cout << "7. Daily supply burn by item\n";
+        std::cout << "8. Daily admissions and discharges\n";
+        std::cout << "9. Back to Main Menu\n";
+        std::cout << "Select an option: ";
+
+        std::string choice;
+        std::getline(std::cin, choice);
+
+        if (choice == "1") {
+            reports.supplyConsumptionByEmergencyType();
+        } else if (choice == "2") {
+            std::string type;
+            std::cout << "Enter Emergency Type (e.g., CARDIAC ARREST): ";
+            std::getline(std::cin, type);
+            type = trim(type);
+            if (type.empty()) {
+                MessageHandler::warning("Emergency type cannot be empty.");
+                continue;
+            }
+            reports.caseSuppliesForType(type);
+        } else if (choice == "3") {
+            std::string patientId;
+            std::cout << "Enter Patient ID (blank for the patients with the most cases): ";
+            std::getline(std::cin, patientId);
+            reports.patientCaseHistory(trim(patientId));
+        } else if (choice == "4") {
+            reports.ambulanceCaseLoad();
+        } else if (choice == "5") {
+            manager.printResponseDashboard();
+        } else if (choice == "6" || choice == "7" || choice == "8") {
+            viewRollup(choice[0] - '0');
+        } else if (choice == "9") {
+            break;
+        } else {
+            MessageHandler::warning("Invalid option. Please try again.");
+        }
+    }
+}
+
 // View cases
 void EmergencyDepartmentOfficer::viewCases() {
     while (true) {
@@ -124,7 +210,8 @@ void EmergencyDepartmentOfficer::viewCases() {
         std::cout << "2. View Processing Cases\n";
         std::cout << "3. View Completed Cases\n";
         std::cout << "4. View All Cases\n";
-        std::cout << "5. Back to Main Menu\n";
+        std::cout << "5. Search Cases\n";
+        std::cout << "6. Back to Main Menu\n";
         std::cout << "Select an option: ";
 
         std::string choice;
@@ -139,12 +226,60 @@ void EmergencyDepartmentOfficer::viewCases() {
         else if (choice == "4")
             manager.printAllCases();
         else if (choice == "5")
+            searchCases();
+        else if (choice == "6")
             break;
         else
             MessageHandler::warning("Invalid option. Please try again.");
     }
 }
 
+// Search cases with filters, results are shown page by page
+void EmergencyDepartmentOfficer::searchCases() {
+    CaseQuery query;
+
+    std::cout << "\n--- Search Emergency Cases ---\n";
+    std::cout << "(Leave a field empty to skip that filter)\n";
+
+    std::cout << "Status (Pending/Processing/Completed): ";
+    std::getline(std::cin, query.status);
+    query.status = trim(query.status);
+    if (!query.status.empty()) {
+        // Normalise to the capitalisation used in the dataset
+        std::string upper = toUpper(query.status);
+        if (upper == "PENDING") query.status = "Pending";
+        else if (upper == "PROCESSING") query.status = "Processing";
+        else if (upper == "COMPLETED") query.status = "Completed";
+    }
+
+    std::cout << "Emergency type: ";
+    std::getline(std::cin, query.emergency_type);
+    query.emergency_type = trim(query.emergency_type);
+
+    query.min_priority = getValidatedInt("Minimum priority (1-5): ", 1, 5);
+    query.max_priority = getValidatedInt("Maximum priority (" + std::to_string(query.min_priority) + "-5): ",
+                                         query.min_priority, 5);
+
+    std::cout << "Logged from date (YYYY-MM-DD): ";
+    std::getline(std::cin, query.date_from);
+    query.date_from = trim(query.date_from);
+
+    std::cout << "Logged to date (YYYY-MM-DD): ";
+    std::getline(std::cin, query.date_to);
+    query.date_to = trim(query.date_to);
+
+    std::cout << "\nSort by:\n";
+    std::cout << "1. Priority\n";
+    std::cout << "2. Logged time\n";
+    std::cout << "3. Case ID\n";
+    int sortChoice = getValidatedInt("Select an option (1-3): ", 1, 3);
+    if (sortChoice == 2) query.sort_key = SORT_CASES_BY_LOGGED_TIME;
+    else if (sortChoice == 3) query.sort_key = SORT_CASES_BY_CASE_ID;
+    else query.sort_key = SORT_CASES_BY_PRIORITY;
+
+    manager.printCasesPaged(query, "Search Results");
+}
+
 void EmergencyDepartmentOfficer::addCase() {
     EmergencyCase ec;
     ec.case_id = manager.generateNextCaseID();
@@ -431,21 +566,41 @@ void EmergencyDepartmentOfficer::completeProcessingCase() {
 
         // MENU BLOCK FOR BATCH ID SELECTION
         std::cout << "\nSelect Batch ID for " << selectedName << ":\n";
+        std::cout << "0. Automatic (earliest expiry first)\n";
         int batchCount = manager.printBatchesForSupply(selectedName);
         if (batchCount == 0) { 
             MessageHandler::error("No batches found for " + selectedName);
             continue;
         }
-        std::string batchPrompt = "Select an option (1-" + std::to_string(batchCount) + "): ";
-        int batchChoice = getValidatedInt(batchPrompt, 1, batchCount);
-        auto selectedSupply = manager.getBatchBySupplyNameAndIndex(selectedName, batchChoice);
+        std::string batchPrompt = "Select an option (0-" + std::to_string(batchCount) + "): ";
+        int batchChoice = getValidatedInt(batchPrompt, 0, batchCount);
+
+        // Option 0 lets the FEFO allocator split the quantity across batches
+        const bool automatic = batchChoice == 0;
+        auto selectedSupply = automatic ? nullptr : manager.getBatchBySupplyNameAndIndex(selectedName, batchChoice);
 
-        if (selectedSupply == nullptr) {
+        if (!automatic && selectedSupply == nullptr) {
              MessageHandler::error("Error selecting batch. Please try again.");
              continue;
         }
-        
-        MessageHandler::info("Selected: " + selectedSupply->supplyName + " (ID: " + selectedSupply->supplyID + ")");
+
+        const int availableQuantity = automatic ? manager.getFefoAvailableUnits(selectedName)
+                                                : selectedSupply->availableUnits();
+        if (automatic) {
+            if (availableQuantity <= 0) {
+                MessageHandler::warning("No unexpired stock left for " + selectedName + ".");
+                continue;
+            }
+            MessageHandler::info("Selected: " + selectedName + " (earliest expiry first, " +
+                                 std::to_string(availableQuantity) + " available)");
+        } else {
+            if (availableQuantity <= 0) {
+                MessageHandler::warning("Batch " + selectedSupply->supplyID + " has no stock left.");
+                continue;
+            }
+            MessageHandler::info("Selected: " + selectedSupply->supplyName + " (ID: " + selectedSupply->supplyID + ", " +
+                                 std::to_string(availableQuantity) + " available)");
+        }
 
         // GET QUANTITY
         int quantity = 0; // Declare quantity up here
@@ -470,8 +625,8 @@ void EmergencyDepartmentOfficer::completeProcessingCase() {
                          MessageHandler::warning("Invalid input. Please enter a valid number without extra characters.");
                     } else if (quantity <= 0) {
                         MessageHandler::warning("Invalid quantity. Please enter a whole number greater than 0.");
-                    } else if (quantity > selectedSupply->stockQuantity) {
-                        MessageHandler::warning("Not enough stock. Only " + std::to_string(selectedSupply->stockQuantity) + " available.");
+                    } else if (quantity > availableQuantity) {
+                        MessageHandler::warning("Not enough stock. Only " + std::to_string(availableQuantity) + " available.");
                     } else {
                         // Quantity is valid AND stock is sufficient
                         break; 
@@ -487,7 +642,16 @@ void EmergencyDepartmentOfficer::completeProcessingCase() {
         if (quantity == 0) continue;
 
         // LOG IT
-        manager.logSupplyUsage(*ec, selectedSupply->supplyID, selectedSupply->supplyName, quantity);
+        if (automatic) {
+            // Batches can expire or be used up after the list was shown, the case may get fewer units
+            const int allocated = manager.consumeSupplyFEFO(*ec, selectedName, quantity);
+            if (allocated < quantity) {
+                MessageHandler::warning("Only " + std::to_string(allocated) + " of the " + std::to_string(quantity) + " " +
+                                        selectedName + " requested could be logged, the remaining batches have expired or run out.");
+            }
+            continue;
+        }
+        manager.logBatchUsage(*ec, selectedSupply, quantity);
         MessageHandler::info("Logged " + std::to_string(quantity) + " of " + selectedSupply->supplyName + ".");
 
         // // This deducts the stock from the in-memory list
@@ -501,6 +665,8 @@ void EmergencyDepartmentOfficer::completeProcessingCase() {
     // Finalize the case
     ec->status = "Completed";
     ec->timestamp_processed = getCurrentTimestamp(); 
+    manager.markCaseModified();
+    manager.recordCaseTransition(*ec);
 
     manager.saveToCSV(dataFile);
     
@@ -1,10 +1,16 @@
 #include <sstream>
 #include <fstream>
+#include <filesystem>
 #include <iostream>
 #include <iomanip>
 
 #include "emergency_manager.hpp"
 #include "path_utils.hpp"
+#include "durable_writer.hpp"
+#include "id_allocator.hpp"
+#include "rollup_store.hpp"
+#include "snapshot.hpp"
+#include "time_utils.hpp"
 
 namespace Color {
     const std::string RESET   = "\033[0m";
@@ -14,60 +20,12 @@ namespace Color {
 }
 
 EmergencyManager::~EmergencyManager() {
-    // Clear the emergency case list
-    Node* current = head;
-    while (current) {
-        Node* tmp = current;
-        current = current->next;
-        delete tmp;
-    }
-
-    // Clear the patient data list
-    PatientNode* pCurrent = patientHead;
-    while (pCurrent) {
-        PatientNode* pTmp = pCurrent;
-        pCurrent = pCurrent->next;
-        delete pTmp;
-    }
-
-    // Clear the emergency type list
-    TypeNode* tCurrent = typeHead;
-    while (tCurrent) {
-        TypeNode* tTmp = tCurrent;
-        tCurrent = tCurrent->next;
-        delete tTmp;
-    }
-
-    // Clear the supply type list
-    SupplyTypeNode* stCurrent = supplyTypeHead;
-    while (stCurrent) {
-        SupplyTypeNode* stTmp = stCurrent;
-        stCurrent = stCurrent->next;
-        delete stTmp;
-    }
-
-    // Clear the unique supply name list
-    UniqueSupplyNode* usCurrent = uniqueSupplyHead;
-    while (usCurrent) {
-        UniqueSupplyNode* usTmp = usCurrent;
-        usCurrent = usCurrent->next;
-        delete usTmp;
-    }
-
-    // Clear the supply data list
-    SupplyNode* sCurrent = supplyHead;
-    while (sCurrent) {
-        SupplyNode* sTmp = sCurrent;
-        sCurrent = sCurrent->next;
-        delete sTmp;
-    }
-
-    clearAmbulanceList();
+    clearSupplyCatalog();
 }
 
 // Adds a new patient to the front of the patient list
 void EmergencyManager::addPatient(const std::string& id, const std::string& name) {
-    PatientNode* newNode = new PatientNode;
+    PatientNode* newNode = patientNodes.allocate();
     newNode->patientID = id;
     newNode->patientName = name;
     newNode->next = patientHead; // Add to front
@@ -76,6 +34,18 @@ void EmergencyManager::addPatient(const std::string& id, const std::string& name
 
 // Loads patient data into the list *once*
 void EmergencyManager::loadPatientData(const std::string& patientDataFile) {
+    SnapshotReader snapshot(patientDataFile, PATIENT_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            std::string patientID = snapshot.getString(row, 0);
+            std::string patientName = snapshot.getString(row, 1);
+            if (!patientID.empty() && !patientName.empty()) {
+                addPatient(patientID, patientName);
+            }
+        }
+        return;
+    }
+
     std::ifstream file(patientDataFile);
     if (!file.is_open()) {
         MessageHandler::warning("Patient data CSV not found: " + patientDataFile);
@@ -134,7 +104,7 @@ void EmergencyManager::addType(const std::string& type) {
         return;
     }
 
-    TypeNode* newNode = new TypeNode;
+    TypeNode* newNode = typeNodes.allocate();
     newNode->typeName = upperType;
     newNode->next = nullptr;
 
@@ -183,6 +153,27 @@ std::string EmergencyManager::getTypeByIndex(int index) const {
 
 // Load from CSV
 void EmergencyManager::loadFromCSV(const std::string& filename) {
+    // An up-to-date snapshot is used as is, no per-row parsing
+    SnapshotReader snapshot(filename, CASE_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        loading = true;
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            EmergencyCase ec;
+            ec.case_id = snapshot.getString(row, 0);
+            ec.patient_id = snapshot.getString(row, 1);
+            ec.patient_name = getPatientName(ec.patient_id);
+            ec.emergency_type = snapshot.getString(row, 2);
+            ec.priority_level = static_cast<int>(snapshot.getInt(row, 3));
+            ec.status = snapshot.getString(row, 4);
+            ec.timestamp_logged = snapshot.getString(row, 5);
+            ec.timestamp_processed = snapshot.getString(row, 6);
+            ec.ambulance_id = snapshot.getString(row, 7);
+            addCase(ec);
+        }
+        loading = false;
+        return;
+    }
+
     std::ifstream file(filename);
     if (!file.is_open()) {
         MessageHandler::warning("Emergency CSV not found, starting empty.");
@@ -193,6 +184,7 @@ void EmergencyManager::loadFromCSV(const std::string& filename) {
     std::getline(file, line);
 
     bool hasNameColumn = (line.find("Patient_Name") != std::string::npos);
+    loading = true;
 
     while (std::getline(file, line)) {
         std::stringstream ss(line);
@@ -232,11 +224,68 @@ void EmergencyManager::loadFromCSV(const std::string& filename) {
         addCase(ec); // insert in priority order
     }
     file.close();
+    loading = false;
+
+    // Legacy files with a Patient_Name column are rewritten in the current layout on the next
+    // save, appending 8-column rows under their 9-column header would misalign them
+    if (hasNameColumn) {
+        needsFullRewrite = true;
+    } else {
+        std::error_code ec;
+        const uintmax_t csvSize = std::filesystem::file_size(filename, ec);
+        if (!ec) {
+            saveSnapshot(filename, static_cast<unsigned long long>(csvSize));
+        }
+    }
 }
 
 // Save to CSV
+// - Nothing is written if the case list did not change since it was loaded or saved
+// - If cases were only added, just the new rows are appended
+// - Otherwise the file is rewritten to a temp file and atomically renamed over the original
 void EmergencyManager::saveToCSV(const std::string& filename) {
-    std::ofstream file(filename);
+    if (!hasUnsavedChanges()) {
+        return;
+    }
+
+    bool fileExists = false;
+    {
+        std::ifstream checker(filename);
+        fileExists = checker.good();
+    }
+
+    if (!needsFullRewrite && fileExists) {
+        std::ostringstream newRows;
+        Node* current = head;
+        while (current) {
+            const EmergencyCase& ec = current->data;
+            if (unsavedCaseIDs.isInArray(ec.case_id)) {
+                newRows << ec.case_id << "," << ec.patient_id << ","
+                        << ec.emergency_type << "," << ec.priority_level << ","
+                        << ec.status << "," << ec.timestamp_logged << ","
+                        << ec.timestamp_processed << "," << ec.ambulance_id << "\n";
+            }
+            current = current->next;
+        }
+        if (appendDurably(filename, newRows.str())) {
+            savedGeneration = generation;
+            unsavedCaseIDs.clearArray();
+            journalPendingArrivals();
+            std::error_code ec;
+            const uintmax_t csvSize = std::filesystem::file_size(filename, ec);
+            if (!ec) {
+                saveSnapshot(filename, static_cast<unsigned long long>(csvSize));
+            }
+        } else {
+            MessageHandler::error("Failed to append new cases to " + filename);
+        }
+        return;
+    }
+
+    DurableWriter file(filename);
+    if (!file.isOpen()) {
+        return;
+    }
     file << "Case_ID,Patient_ID,Emergency_Type,Priority_Level,Status,Timestamp_Logged,Timestamp_Processed,Ambulance_ID\n";
 
     Node* current = head;
@@ -248,7 +297,47 @@ void EmergencyManager::saveToCSV(const std::string& filename) {
              << ec.timestamp_processed << "," << ec.ambulance_id << "\n";
         current = current->next;
     }
-    file.close();
+    const unsigned long long csvSize = file.bytesWritten();
+    if (file.commit()) {
+        savedGeneration = generation;
+        needsFullRewrite = false;
+        unsavedCaseIDs.clearArray();
+        journalPendingArrivals();
+        saveSnapshot(filename, csvSize);
+    }
+}
+
+void EmergencyManager::stageArrival(const std::string& timestampLogged, const std::string& type, int delta) {
+    pendingArrivals.getOrInsert(RollupStore::hourBucket(timestampLogged) + "|" + type) += delta;
+}
+
+// Hour buckets never contain '|', so the first one separates the bucket from the type
+void EmergencyManager::journalPendingArrivals() {
+    pendingArrivals.forEach([](const std::string& key, int delta) {
+        if (delta == 0) return;
+        const std::size_t separator = key.find('|');
+        RollupStore::instance().add(ROLLUP_CASE_ARRIVALS, key.substr(0, separator), key.substr(separator + 1), delta);
+    });
+    pendingArrivals.clear();
+}
+
+// Writes the binary snapshot used for fast loading, in the same column order as the CSV
+void EmergencyManager::saveSnapshot(const std::string& filename, unsigned long long csvSize) const {
+    SnapshotWriter snapshot(CASE_SNAPSHOT_COLUMNS);
+    Node* current = head;
+    while (current) {
+        const EmergencyCase& ec = current->data;
+        snapshot.addString(ec.case_id)
+                .addString(ec.patient_id)
+                .addString(ec.emergency_type)
+                .addInt(ec.priority_level)
+                .addString(ec.status)
+                .addString(ec.timestamp_logged)
+                .addString(ec.timestamp_processed)
+                .addString(ec.ambulance_id);
+        current = current->next;
+    }
+    snapshot.save(filename, csvSize);
 }
 
 // Helper function to print a single case row
@@ -282,14 +371,8 @@ void printCaseRow(const EmergencyCase& ec) {
     std::cout << "\n";
 }
 
-void EmergencyManager::printAllCases() const {
-    if (!head) {
-        MessageHandler::info("No emergency cases available.");
-        return;
-    }
-
-    std::cout << "\n--- All Emergency Cases ---\n";
-
+// Prints the column header shared by every case listing
+static void printCaseHeader() {
     std::cout << std::left
               << std::setw(13)  << "Case_ID"
               << std::setw(13) << "Patient_ID"
@@ -302,90 +385,176 @@ void EmergencyManager::printAllCases() const {
               << std::setw(10) << "Ambulance"
               << "\n";
     std::cout << std::string(151, '-') << "\n";
+}
 
-    Node* current = nullptr;
-    bool casesFound = false;
+// Ranks statuses so Pending sorts before Processing before Completed
+static char statusRank(const std::string& status) {
+    if (status == "Pending") return '0';
+    if (status == "Processing") return '1';
+    if (status == "Completed") return '2';
+    return '3';
+}
 
- // Loop for each priority level from 1 to 5
-    for (int priority = 1; priority <= 5; ++priority) {
+// Zero-pads a number so string comparison matches numeric comparison
+static std::string padNumber(long long value, int width) {
+    std::ostringstream oss;
+    oss << std::setw(width) << std::setfill('0') << value;
+    return oss.str();
+}
 
-        // "Pending" 
-        current = head; // Reset pointer to the start of the list
-        while (current) {
-            if (current->data.priority_level == priority && current->data.status == "Pending") {
-                printCaseRow(current->data);
-                casesFound = true;
+// Builds the total-order sort key of a case for the given sort order
+// The case ID is always the last component so keys are unique
+static std::string buildCaseSortKey(const EmergencyCase& ec, CaseSortKey sortKey) {
+    switch (sortKey) {
+        case SORT_CASES_BY_LOGGED_TIME:
+            return ec.timestamp_logged + "|" + ec.case_id;
+        case SORT_CASES_BY_CASE_ID: {
+            long long num = 0;
+            if (ec.case_id.rfind("CASE-", 0) == 0) {
+                try {
+                    num = std::stoll(ec.case_id.substr(5));
+                } catch (...) {}
             }
+            return padNumber(num, 12) + "|" + ec.case_id;
+        }
+        case SORT_CASES_BY_PRIORITY:
+        default:
+            return padNumber(ec.priority_level, 4) + statusRank(ec.status) + "|" +
+                   ec.timestamp_logged + "|" + ec.case_id;
+    }
+}
+
+// Checks a case against every filter of the query
+static bool caseMatchesQuery(const EmergencyCase& ec, const CaseQuery& query) {
+    if (!query.status.empty() && ec.status != query.status) return false;
+    if (!query.emergency_type.empty() && toUpper(ec.emergency_type) != toUpper(query.emergency_type)) return false;
+    if (ec.priority_level < query.min_priority || ec.priority_level > query.max_priority) return false;
+
+    std::string loggedDate = ec.timestamp_logged.substr(0, 10);
+    if (!query.date_from.empty() && loggedDate < query.date_from) return false;
+    if (!query.date_to.empty() && loggedDate > query.date_to) return false;
+    return true;
+}
+
+// Materializes one page of cases sorted after the cursor
+CasePage EmergencyManager::queryCases(const CaseQuery& query, const std::string& cursor) const {
+    CasePage page;
+    std::string keys[LIST_PAGE_SIZE]; // Sort keys of the page items, kept in ascending order
+
+    // The cursor is "<sort key id>:<last key>", a cursor from another ordering restarts the listing
+    std::string sortPrefix = std::to_string(static_cast<int>(query.sort_key)) + ":";
+    std::string afterKey;
+    if (cursor.rfind(sortPrefix, 0) == 0) {
+        afterKey = cursor.substr(sortPrefix.size());
+    }
+
+    int matchesAfterCursor = 0;
+    Node* current = head;
+    while (current) {
+        const EmergencyCase& ec = current->data;
+        if (!caseMatchesQuery(ec, query)) {
             current = current->next;
+            continue;
         }
 
-        // "Processing"
-        current = head; // Reset pointer to the start of the list
-        while (current) {
-            if (current->data.priority_level == priority && current->data.status == "Processing") {
-                printCaseRow(current->data);
-                casesFound = true;
-            }
+        std::string key = buildCaseSortKey(ec, query.sort_key);
+        if (!afterKey.empty() && key <= afterKey) {
             current = current->next;
+            continue;
         }
+        matchesAfterCursor++;
 
-        // "Completed" 
-        current = head; // Reset pointer to the start of the list
-        while (current) {
-            if (current->data.priority_level == priority && current->data.status == "Completed") {
-                printCaseRow(current->data);
-                casesFound = true;
-            }
+        // Bounded insertion: keep only the smallest LIST_PAGE_SIZE keys
+        if (page.count == LIST_PAGE_SIZE && key >= keys[page.count - 1]) {
             current = current->next;
+            continue;
         }
+
+        int pos = (page.count < LIST_PAGE_SIZE) ? page.count : LIST_PAGE_SIZE - 1;
+        while (pos > 0 && keys[pos - 1] > key) {
+            keys[pos] = keys[pos - 1];
+            page.items[pos] = page.items[pos - 1];
+            pos--;
+        }
+        keys[pos] = key;
+        page.items[pos] = ec;
+        if (page.count < LIST_PAGE_SIZE) page.count++;
+
+        current = current->next;
     }
-    
-    if (!casesFound) {
-         std::cout << "(No emergency cases found)\n";
+
+    page.has_more = matchesAfterCursor > page.count;
+    if (page.has_more) {
+        page.next_cursor = sortPrefix + keys[page.count - 1];
     }
+    return page;
 }
 
-// Print cases by status
-void EmergencyManager::printCasesByStatus(const std::string& status) const {
+// Prints the query results one page at a time
+void EmergencyManager::printCasesPaged(const CaseQuery& query, const std::string& title) const {
     if (!head) {
         MessageHandler::info("No emergency cases available.");
         return;
     }
 
-    std::cout << "\n--- " << status << " Cases ---\n";
+    std::cout << "\n--- " << title << " ---\n";
 
-    std::cout << std::left
-              << std::setw(13)  << "Case_ID"
-              << std::setw(13) << "Patient_ID"
-              << std::setw(19) << "Patient_Name"
-              << std::setw(29) << "Emergency_Type"
-              << std::setw(10) << "Priority"
-              << std::setw(12) << "Status"
-              << std::setw(22) << "Logged"
-              << std::setw(22) << "Processed"
-              << std::setw(10) << "Ambulance"
-              << "\n";
-    std::cout << std::string(151, '-') << "\n"; 
+    std::string cursor;
+    int shown = 0;
+    while (true) {
+        CasePage page = queryCases(query, cursor);
+        if (page.count == 0) break;
 
-    Node* current = head;
-    bool found = false;
-    while (current) {
-        if (current->data.status == status) {
-            printCaseRow(current->data);
-            found = true;
+        printCaseHeader();
+        for (int i = 0; i < page.count; ++i) {
+            printCaseRow(page.items[i]);
         }
-        current = current->next;
+        shown += page.count;
+
+        if (!promptNextPage(page.has_more)) break;
+        cursor = page.next_cursor;
     }
 
-    if (!found)
-        std::cout << "(No " << status << " cases found)\n";
+    if (shown == 0) {
+        std::cout << "(No matching cases found)\n";
+    }
+}
+
+void EmergencyManager::printAllCases() const {
+    CaseQuery query;
+    query.sort_key = SORT_CASES_BY_PRIORITY;
+    printCasesPaged(query, "All Emergency Cases");
+}
+
+// Print cases by status
+void EmergencyManager::printCasesByStatus(const std::string& status) const {
+    CaseQuery query;
+    query.status = status;
+    query.sort_key = SORT_CASES_BY_PRIORITY;
+    printCasesPaged(query, status + " Cases");
 }
 
 // Add case (insert by priority)
 void EmergencyManager::addCase(const EmergencyCase& ec) {
-    Node* newNode = new Node{ec, nullptr};
+    Node* newNode = caseNodes.allocate();
+    newNode->data = ec;
+    newNode->next = nullptr;
 
     addType(ec.emergency_type);
+    IdAllocator::instance().observeId(CASE_ID_NAMESPACE, ec.case_id);
+    analytics.record(ec); // Loaded cases and cases re-inserted after a status change, pending ones are skipped
+
+    if (!loading) {
+        generation++;
+        unsavedCaseIDs.appendArray(ec.case_id);
+
+        // A case coming back from popHighestPriorityPendingCase() was counted when it arrived
+        if (ec.case_id == poppedCaseID) {
+            poppedCaseID.clear();
+        } else {
+            stageArrival(ec.timestamp_logged, ec.emergency_type, 1);
+        }
+    }
 
     // Empty list or higher priority than head
     if (!head || ec.priority_level < head->data.priority_level) {
@@ -445,9 +614,12 @@ EmergencyCase EmergencyManager::popHighestPriorityPendingCase() {
         prev->next = current->next; // Unlink the node
     }
 
-    // Save the data, delete the node and return the data
+    // Save the data, recycle the node and return the data
     EmergencyCase ec = current->data;
-    delete current;
+    poppedCaseID = ec.case_id;
+    caseNodes.recycle(current);
+    generation++;
+    needsFullRewrite = true;
     return ec;
 }
 
@@ -456,7 +628,14 @@ void EmergencyManager::updateCase(const EmergencyCase& ec) {
     Node* current = head;
     while (current) {
         if (current->data.case_id == ec.case_id) {
+            // An edited type or arrival time moves the case to another arrivals cell
+            if (RollupStore::hourBucket(current->data.timestamp_logged) != RollupStore::hourBucket(ec.timestamp_logged)
+                || current->data.emergency_type != ec.emergency_type) {
+                stageArrival(current->data.timestamp_logged, current->data.emergency_type, -1);
+                stageArrival(ec.timestamp_logged, ec.emergency_type, 1);
+            }
             current->data = ec;
+            markCaseModified();
             return;
         }
         current = current->next;
@@ -464,37 +643,25 @@ void EmergencyManager::updateCase(const EmergencyCase& ec) {
     addCase(ec);
 }
 
-// Generate next Case ID
-std::string EmergencyManager::generateNextCaseID() {
-    int maxID = 3350; // Start from a base, CASE-3101
-    Node* current = head;
-
-    while (current) {
-        const std::string& id = current->data.case_id;
-        if (id.rfind("CASE-", 0) == 0) {
-            try {
-                int num = std::stoi(id.substr(5)); // Get number after "CASE-"
-                if (num > maxID) maxID = num;
-            } catch (...) {}
-        }
-
-        current = current->next;
-    }
+// Marks the case list as changed so the next save rewrites the file
+void EmergencyManager::markCaseModified() {
+    generation++;
+    needsFullRewrite = true;
+}
 
-    std::ostringstream oss;
-    oss << "CASE-" << (maxID + 1);
-    return oss.str();
+// Generate next Case ID, numbers continue past every case loaded or issued in earlier runs
+std::string EmergencyManager::generateNextCaseID() {
+    IdAllocator &ids = IdAllocator::instance();
+    ids.observe(CASE_ID_NAMESPACE, CASE_ID_BASE);
+    return IdAllocator::format(CASE_ID_NAMESPACE, ids.next(CASE_ID_NAMESPACE));
 }
 
 // Adds a unique supply type to the list
 void EmergencyManager::addSupplyType(const std::string& type) {
-    if (type.empty()) return;
-    SupplyTypeNode* current = supplyTypeHead;
-    while (current) {
-        if (current->typeName == type) return; // Already exists
-        current = current->next;
-    }
-    SupplyTypeNode* newNode = new SupplyTypeNode;
+    if (type.empty() || namesByType.contains(type)) return; // Already exists
+    namesByType.getOrInsert(type);
+
+    SupplyTypeNode* newNode = supplyTypeNodes.allocate();
     newNode->typeName = type;
     newNode->next = supplyTypeHead;
     supplyTypeHead = newNode;
@@ -503,14 +670,11 @@ void EmergencyManager::addSupplyType(const std::string& type) {
 // Adds a unique supply NAME to the list
 void EmergencyManager::addUniqueSupply(const std::string& name, const std::string& type) {
     if (name.empty() || type.empty()) return;
-    UniqueSupplyNode* current = uniqueSupplyHead;
-    while (current) {
-        if (current->supplyName == name && current->supplyType == type) {
-            return; // Already exists
-        }
-        current = current->next;
-    }
-    UniqueSupplyNode* newNode = new UniqueSupplyNode;
+    const std::string key = name + "|" + type;
+    if (knownUniqueSupplies.contains(key)) return; // Already exists
+    knownUniqueSupplies.insertOrAssign(key, true);
+
+    UniqueSupplyNode* newNode = uniqueSupplyNodes.allocate();
     newNode->supplyName = name;
     newNode->supplyType = type;
     newNode->next = uniqueSupplyHead;
@@ -518,18 +682,203 @@ void EmergencyManager::addUniqueSupply(const std::string& name, const std::strin
 }
 
 // Adds a supply item to the main supply list
-void EmergencyManager::addSupply(const std::string& id, const std::string& name, const std::string& type, int stockQty) {
-    SupplyNode* newNode = new SupplyNode;
+void EmergencyManager::addSupply(const std::string& id, const std::string& name, const std::string& type, int stockQty,
+                                 const std::string& expiryDate) {
+    SupplyNode* newNode = supplyNodes.allocate();
     newNode->supplyID = id;
     newNode->supplyName = name;
     newNode->supplyType = type;
     newNode->stockQuantity = stockQty;
+    newNode->expiryDate = expiryDate;
+    newNode->reservedQuantity = 0;
+    newNode->inFefoHeap = false;
     newNode->next = supplyHead; // Add to front
     supplyHead = newNode;
 }
 
+void EmergencyManager::clearSupplyCatalog() {
+    delete[] catalogTypes;
+    delete[] catalogNames;
+    delete[] catalogBatches;
+    delete[] fefoHeaps;
+    catalogTypes = nullptr;
+    catalogNames = nullptr;
+    catalogBatches = nullptr;
+    fefoHeaps = nullptr;
+    catalogTypeCount = 0;
+}
+
+// Lays the three supply lists out as flat menu arrays, O(types + names + batches)
+void EmergencyManager::buildSupplyCatalog() {
+    clearSupplyCatalog();
+
+    // Types, in list order
+    for (SupplyTypeNode* current = supplyTypeHead; current; current = current->next) {
+        catalogTypeCount++;
+    }
+    catalogTypes = new SupplyTypeNode*[catalogTypeCount];
+    int position = 0;
+    for (SupplyTypeNode* current = supplyTypeHead; current; current = current->next) {
+        catalogTypes[position++] = current;
+    }
+
+    // Names: count per type, give every type a slice, then fill the slices in list order
+    int nameCount = 0;
+    namesByType.forEach([](const std::string&, CatalogRange& range) { range = CatalogRange{}; });
+    for (UniqueSupplyNode* current = uniqueSupplyHead; current; current = current->next) {
+        namesByType.getOrInsert(current->supplyType).count++;
+        nameCount++;
+    }
+    position = 0;
+    namesByType.forEach([&position](const std::string&, CatalogRange& range) {
+        range.first = position;
+        position += range.count;
+        range.count = 0;
+    });
+    catalogNames = new UniqueSupplyNode*[nameCount];
+    for (UniqueSupplyNode* current = uniqueSupplyHead; current; current = current->next) {
+        CatalogRange& range = namesByType.getOrInsert(current->supplyType);
+        catalogNames[range.first + range.count++] = current;
+    }
+
+    // Batches, the same way per supply name
+    catalogBatchCount = 0;
+    batchesByName.clear();
+    for (SupplyNode* current = supplyHead; current; current = current->next) {
+        batchesByName.getOrInsert(current->supplyName).count++;
+        catalogBatchCount++;
+    }
+    position = 0;
+    batchesByName.forEach([&position](const std::string&, CatalogRange& range) {
+        range.first = position;
+        position += range.count;
+        range.count = 0;
+    });
+    catalogBatches = new SupplyNode*[catalogBatchCount];
+    for (SupplyNode* current = supplyHead; current; current = current->next) {
+        CatalogRange& range = batchesByName.getOrInsert(current->supplyName);
+        catalogBatches[range.first + range.count++] = current;
+    }
+
+    buildFefoHeaps();
+}
+
+// Orders batches by expiry date, then batch ID so equal dates allocate deterministically
+bool EmergencyManager::expiresBefore(const SupplyNode* a, const SupplyNode* b) {
+    if (a->expiryDate != b->expiryDate) return a->expiryDate < b->expiryDate;
+    return a->supplyID < b->supplyID;
+}
+
+void EmergencyManager::siftDownFefo(SupplyNode** heap, int count, int index) {
+    while (true) {
+        int smallest = index;
+        int left = index * 2 + 1;
+        int right = left + 1;
+        if (left < count && expiresBefore(heap[left], heap[smallest])) smallest = left;
+        if (right < count && expiresBefore(heap[right], heap[smallest])) smallest = right;
+        if (smallest == index) return;
+        SupplyNode* tmp = heap[index];
+        heap[index] = heap[smallest];
+        heap[smallest] = tmp;
+        index = smallest;
+    }
+}
+
+// One heap per supply name over its unexpired, non-empty batches, heapified in O(batches)
+void EmergencyManager::buildFefoHeaps() {
+    fefoByName.clear();
+    fefoHeaps = new SupplyNode*[catalogBatchCount];
+
+    int position = 0;
+    batchesByName.forEach([this, &position](const std::string& name, const CatalogRange& batches) {
+        CatalogRange& heap = fefoByName.getOrInsert(name);
+        heap.first = position;
+        for (int i = 0; i < batches.count; i++) {
+            SupplyNode* batch = catalogBatches[batches.first + i];
+            batch->inFefoHeap = batch->availableUnits() > 0 && !isDateExpired(batch->expiryDate);
+            if (batch->inFefoHeap) {
+                fefoHeaps[position++] = batch;
+                heap.units += batch->availableUnits();
+            }
+        }
+        heap.count = position - heap.first;
+        for (int i = heap.count / 2 - 1; i >= 0; i--) {
+            siftDownFefo(fefoHeaps + heap.first, heap.count, i);
+        }
+    });
+}
+
+// Removes the earliest-expiring batch of a heap
+void EmergencyManager::popFefo(CatalogRange& heap) {
+    SupplyNode** batches = fefoHeaps + heap.first;
+    SupplyNode* top = batches[0];
+    heap.units -= top->availableUnits();
+    top->inFefoHeap = false;
+    batches[0] = batches[--heap.count];
+    siftDownFefo(batches, heap.count, 0);
+}
+
+int EmergencyManager::getFefoAvailableUnits(const std::string& supplyName) const {
+    const CatalogRange* heap = fefoByName.find(supplyName);
+    return heap ? heap->units : 0;
+}
+
+int EmergencyManager::consumeSupplyFEFO(const EmergencyCase& ec, const std::string& supplyName, int quantity) {
+    CatalogRange* heap = fefoByName.find(supplyName);
+    if (!heap) return 0;
+
+    int remaining = quantity;
+    while (remaining > 0 && heap->count > 0) {
+        SupplyNode* top = fefoHeaps[heap->first];
+        const int available = top->availableUnits();
+        if (available <= 0 || isDateExpired(top->expiryDate)) {
+            popFefo(*heap); // Used up by hand or expired since load
+            continue;
+        }
+
+        const int used = available < remaining ? available : remaining;
+        logSupplyUsage(ec, top->supplyID, top->supplyName, used);
+        MessageHandler::info("Logged " + std::to_string(used) + " of " + top->supplyName +
+                             " from batch " + top->supplyID + " (expires " + top->expiryDate + ").");
+        top->reservedQuantity += used;
+        heap->units -= used;
+        remaining -= used;
+
+        if (used == available) {
+            popFefo(*heap);
+        }
+    }
+    return quantity - remaining;
+}
+
+void EmergencyManager::logBatchUsage(const EmergencyCase& ec, SupplyNode* batch, int quantity) {
+    logSupplyUsage(ec, batch->supplyID, batch->supplyName, quantity);
+    batch->reservedQuantity += quantity;
+    if (batch->inFefoHeap) {
+        // The batch stays in its heap, consumeSupplyFEFO drops it once nothing is left
+        fefoByName.getOrInsert(batch->supplyName).units -= quantity;
+    }
+}
+
 // Loads all supply data from medical_supply.csv
 void EmergencyManager::loadSupplyData(const std::string& supplyDataFile) {
+    SnapshotReader snapshot(supplyDataFile, SUPPLY_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            std::string supplyID = snapshot.getString(row, 0);
+            std::string supplyName = snapshot.getString(row, 1);
+            std::string supplyType = snapshot.getString(row, 2);
+            if (!supplyID.empty() && !supplyName.empty() && !supplyType.empty()) {
+                addSupply(supplyID, supplyName, supplyType, static_cast<int>(snapshot.getInt(row, 3)),
+                          snapshot.getString(row, 7));
+                addSupplyType(supplyType);
+                addUniqueSupply(supplyName, supplyType);
+            }
+        }
+        buildSupplyCatalog();
+        return;
+    }
+
     std::ifstream file(supplyDataFile);
     if (!file.is_open()) {
         MessageHandler::warning("Medical supply CSV not found: " + supplyDataFile);
@@ -539,16 +888,21 @@ void EmergencyManager::loadSupplyData(const std::string& supplyDataFile) {
     std::getline(file, line); // Skip header
     while (std::getline(file, line)) {
         std::stringstream ss(line);
-        std::string supplyID, supplyName, supplyType, stockQtyStr;
+        std::string supplyID, supplyName, supplyType, stockQtyStr, skipped, expiryDate;
         std::getline(ss, supplyID, ',');   
         std::getline(ss, supplyName, ','); 
         std::getline(ss, supplyType, ','); 
         std::getline(ss, stockQtyStr, ',');
+        std::getline(ss, skipped, ',');    // Status
+        std::getline(ss, skipped, ',');    // Supplier_Name
+        std::getline(ss, skipped, ',');    // Timestamp_Added
+        std::getline(ss, expiryDate, ',');
         if (!supplyID.empty() && !supplyName.empty() && !supplyType.empty()) {
             trim(supplyID); 
             trim(supplyName);
             trim(supplyType);
             trim(stockQtyStr);
+            expiryDate = trim(expiryDate);
 
             int stockQty = 0;
             try {
@@ -558,104 +912,76 @@ void EmergencyManager::loadSupplyData(const std::string& supplyDataFile) {
             } catch (const std::invalid_argument&) {
                 MessageHandler::warning("Invalid stock quantity for supply ID: " + supplyID + ". Defaulting to 0.");
             }
-            addSupply(supplyID, supplyName, supplyType, stockQty);
+            addSupply(supplyID, supplyName, supplyType, stockQty, expiryDate);
             addSupplyType(supplyType);
             addUniqueSupply(supplyName, supplyType); 
         }
     }
     file.close();
+    buildSupplyCatalog();
 }
 
 // Prints a numbered menu of unique supply types
 int EmergencyManager::printSupplyTypes() const {
-    SupplyTypeNode* current = supplyTypeHead;
-    int i = 0;
-    while (current) {
-        i++;
+    for (int i = 0; i < catalogTypeCount; i++) {
+        const std::string& typeName = catalogTypes[i]->typeName;
         std::string fullName; // Variable to hold the pretty name
 
-        if (current->typeName == "MED") {
+        if (typeName == "MED") {
             fullName = "Medication (MED)";
-        } else if (current->typeName == "EQP") {
+        } else if (typeName == "EQP") {
             fullName = "Equipment (EQP)";
-        } else if (current->typeName == "PPE") {
+        } else if (typeName == "PPE") {
             fullName = "Personal Protective Equipment (PPE)";
         } else {
-            fullName = current->typeName; // Fallback for any other types
+            fullName = typeName; // Fallback for any other types
         }
-        std::cout << i << ". " << fullName << "\n";
-        current = current->next;
+        std::cout << i + 1 << ". " << fullName << "\n";
     }
-    return i; 
+    return catalogTypeCount;
 }
 
 // Gets the string name of a supply type by its menu index
 std::string EmergencyManager::getSupplyTypeByIndex(int index) const {
-    SupplyTypeNode* current = supplyTypeHead;
-    int i = 0;
-    while (current) {
-        i++;
-        if (i == index) return current->typeName;
-        current = current->next;
-    }
-    return "Unknown";
+    if (index < 1 || index > catalogTypeCount) return "Unknown";
+    return catalogTypes[index - 1]->typeName;
 }
 
 // Prints a menu of unique supply NAMES for a given type
 int EmergencyManager::printUniqueSuppliesByType(const std::string& type) const {
-    UniqueSupplyNode* current = uniqueSupplyHead;
-    int i = 0;
-    while (current) {
-        if (current->supplyType == type) {
-            i++;
-            std::cout << i << ". " << current->supplyName << "\n";
-        }
-        current = current->next;
+    const CatalogRange* range = namesByType.find(type);
+    if (!range) return 0;
+    for (int i = 0; i < range->count; i++) {
+        std::cout << i + 1 << ". " << catalogNames[range->first + i]->supplyName << "\n";
     }
-    return i; // Return the count
+    return range->count; // Return the count
 }
 
 // Gets the string NAME of a unique supply
 std::string EmergencyManager::getUniqueSupplyNameByTypeAndIndex(const std::string& type, int index) const {
-    UniqueSupplyNode* current = uniqueSupplyHead;
-    int i = 0;
-    while (current) {
-        if (current->supplyType == type) {
-            i++;
-            if (i == index) return current->supplyName;
-        }
-        current = current->next;
-    }
-    return "Unknown";
+    const CatalogRange* range = namesByType.find(type);
+    if (!range || index < 1 || index > range->count) return "Unknown";
+    return catalogNames[range->first + index - 1]->supplyName;
 }
 
 // Prints a menu of all BATCHES for a given supply NAME
 int EmergencyManager::printBatchesForSupply(const std::string& supplyName) const {
-    SupplyNode* current = supplyHead;
-    int i = 0;
-    while (current) {
-        if (current->supplyName == supplyName) {
-            i++;
-            std::cout << i << ". " << current->supplyName 
-                      << " (ID: " << current->supplyID << ")\n";
-        }
-        current = current->next;
+    const CatalogRange* range = batchesByName.find(supplyName);
+    if (!range) return 0;
+    for (int i = 0; i < range->count; i++) {
+        const SupplyNode* batch = catalogBatches[range->first + i];
+        std::cout << i + 1 << ". " << batch->supplyName
+                  << " (ID: " << batch->supplyID << ", " << batch->availableUnits() << " available, expires "
+                  << batch->expiryDate << ")\n";
     }
-    return i; // Return the count
+    return range->count; // Return the count
 }
 
 // Gets a pointer to a specific BATCH
 EmergencyManager::SupplyNode* EmergencyManager::getBatchBySupplyNameAndIndex(const std::string& supplyName, int index) const {
-    SupplyNode* current = supplyHead;
-    int i = 0;
-    while (current) {
-        if (current->supplyName == supplyName) {
-            i++;
-            if (i == index) return current;
-        }
-        current = current->next;
-    }
-    return nullptr;
+    const CatalogRange* range = batchesByName.find(supplyName);
+    if (!range || index < 1 || index > range->count) return nullptr;
+    return catalogBatches[range->first + index - 1];
 }
 
 // Finds a case by its ID and returns a pointer
@@ -680,36 +1006,59 @@ void EmergencyManager::logSupplyUsage(const EmergencyCase& ec, const std::string
         std::ifstream checker(logFilePath);
         if (checker.good()) fileExists = true;
     }
-    std::ofstream logFile(logFilePath, std::ios::app);
-    if (!logFile.is_open()) {
-        MessageHandler::error("FATAL: Could not open supply usage log file at: " + logFilePath);
-        return;
-    }
+
+    std::ostringstream logLine;
     if (!fileExists) {
-        logFile << "Case_ID,Patient_ID,Supply_Batch_ID,Supply_Name,Quantity_Used,Status\n";
+        logLine << "Case_ID,Patient_ID,Supply_Batch_ID,Supply_Name,Quantity_Used,Status\n";
     }
-    logFile << ec.case_id << ","
+    logLine << ec.case_id << ","
             << ec.patient_id << ","
             << supplyID << ","
             << supplyName << ","
             << quantity << ","
             << "Not Deducted" << "\n";
-    logFile.close();
+
+    if (!appendDurably(logFilePath, logLine.str())) {
+        MessageHandler::error("FATAL: Could not write supply usage log file at: " + logFilePath);
+        return;
+    }
+    RollupStore::instance().add(ROLLUP_SUPPLY_BURN, RollupStore::todayBucket(), supplyName, quantity);
 }
 
 void EmergencyManager::clearAmbulanceList() {
-    AmbulanceNode* current = ambHead;
-    while (current) {
-        AmbulanceNode* tmp = current;
-        current = current->next;
-        delete tmp;
-    }
+    ambulanceNodes.reset(); // Every node goes at once, the chunks are kept for the reload
     ambHead = nullptr;
 }
 
 void EmergencyManager::loadAmbulanceData(const std::string& filename) {
     clearAmbulanceList(); // Clear old data first
-    
+
+    SnapshotReader snapshot(filename, AMBULANCE_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            Ambulance amb;
+            amb.ambulance_id = snapshot.getString(row, 0);
+            amb.driver_name = snapshot.getString(row, 1);
+            amb.driver_status = snapshot.getString(row, 2);
+            amb.assigned_case_id = snapshot.getString(row, 7);
+            amb.ambulance_status = snapshot.getString(row, 8);
+
+            // The snapshot mirrors the raw CSV cells, trimmed the same way as the CSV path below
+            trim(amb.ambulance_id);
+            trim(amb.driver_name);
+            trim(amb.driver_status);
+            trim(amb.assigned_case_id);
+            trim(amb.ambulance_status);
+
+            // Add to our list (to the front)
+            AmbulanceNode* newNode = ambulanceNodes.allocate();
+            newNode->data = amb;
+            newNode->next = ambHead;
+            ambHead = newNode;
+        }
+        return;
+    }
+
     std::ifstream file(filename);
     if (!file.is_open()) {
         MessageHandler::warning("Ambulance schedule CSV not found: " + filename);
@@ -741,7 +1090,8 @@ void EmergencyManager::loadAmbulanceData(const std::string& filename) {
         trim(amb.ambulance_status);
 
         // Add to our list (to the front)
-        AmbulanceNode* newNode = new AmbulanceNode{amb, nullptr};
+        AmbulanceNode* newNode = ambulanceNodes.allocate();
+        newNode->data = amb;
         newNode->next = ambHead;
         ambHead = newNode;
     }
@@ -0,0 +1,137 @@
+#include "response_analytics.hpp"
+#include "time_utils.hpp"
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// SLA targets in minutes, index 0 is priority 1
+static const double DISPATCH_TARGET_MINUTES[ANALYTICS_PRIORITY_LEVELS] = {10, 20, 30, 60, 120};
+static const double COMPLETION_TARGET_MINUTES[ANALYTICS_PRIORITY_LEVELS] = {60, 120, 240, 480, 720};
+
+int ResponseAnalytics::priorityIndex(int priority) {
+    if (priority < 1 || priority > ANALYTICS_PRIORITY_LEVELS) return ANALYTICS_PRIORITY_LEVELS - 1;
+    return priority - 1;
+}
+
+double ResponseAnalytics::dispatchTargetMinutes(int priority) {
+    return DISPATCH_TARGET_MINUTES[priorityIndex(priority)];
+}
+
+double ResponseAnalytics::completionTargetMinutes(int priority) {
+    return COMPLETION_TARGET_MINUTES[priorityIndex(priority)];
+}
+
+// "YYYY-MM-DD HH:MM:SS" to epoch seconds, the seconds are optional, -1 if unreadable
+long long ResponseAnalytics::parseTimestamp(const std::string& timestamp) {
+    const long long seconds = parseDatetime(timestamp);
+    if (seconds < 0) return -1;
+    if (timestamp.size() >= 19 && timestamp[16] == ':' && std::isdigit(static_cast<unsigned char>(timestamp[17]))
+        && std::isdigit(static_cast<unsigned char>(timestamp[18]))) {
+        return seconds + (timestamp[17] - '0') * 10 + (timestamp[18] - '0');
+    }
+    return seconds;
+}
+
+LatencyStats& ResponseAnalytics::byPriority(ResponseStage stage, int priority) {
+    return stage == ResponseStage::Dispatch ? dispatchByPriority[priorityIndex(priority)]
+                                            : completionByPriority[priorityIndex(priority)];
+}
+
+LatencyStats* ResponseAnalytics::byType(ResponseStage stage, const std::string& emergencyType) {
+    return stage == ResponseStage::Dispatch ? dispatchByType.find(emergencyType) : completionByType.find(emergencyType);
+}
+
+bool ResponseAnalytics::record(const EmergencyCase& ec) {
+    ResponseStage stage;
+    if (ec.status == "Processing") stage = ResponseStage::Dispatch;
+    else if (ec.status == "Completed") stage = ResponseStage::Completion;
+    else return false;
+
+    const long long logged = parseTimestamp(ec.timestamp_logged);
+    const long long reached = parseTimestamp(ec.timestamp_processed);
+    if (logged < 0 || reached < logged) return false;
+
+    const double minutes = static_cast<double>(reached - logged) / 60.0;
+    const double target = stage == ResponseStage::Dispatch ? dispatchTargetMinutes(ec.priority_level)
+                                                           : completionTargetMinutes(ec.priority_level);
+    const bool breached = minutes > target;
+
+    LatencyStats &priorityStats = byPriority(stage, ec.priority_level);
+    priorityStats.minutes.add(minutes);
+    if (breached) priorityStats.breaches++;
+
+    LatencyStats &typeStats = stage == ResponseStage::Dispatch ? dispatchByType.getOrInsert(ec.emergency_type)
+                                                               : completionByType.getOrInsert(ec.emergency_type);
+    typeStats.minutes.add(minutes);
+    if (breached) typeStats.breaches++;
+    return true;
+}
+
+static void printStatsHeader(const std::string& keyTitle) {
+    std::cout << std::left << std::setw(28) << keyTitle << std::setw(8) << "Cases" << std::setw(10) << "p50"
+              << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "Max" << "SLA Breaches\n";
+    std::cout << std::string(90, '-') << "\n";
+}
+
+static void printStatsRow(const std::string& key, LatencyStats& stats) {
+    TDigest &digest = stats.minutes;
+    std::cout << std::setw(28) << key << std::setw(8) << digest.count();
+    if (digest.count() == 0) {
+        std::cout << std::setw(10) << "-" << std::setw(10) << "-" << std::setw(10) << "-" << std::setw(10) << "-" << "-\n";
+        return;
+    }
+    std::cout << std::setw(10) << digest.quantile(0.50) << std::setw(10) << digest.quantile(0.90)
+              << std::setw(10) << digest.quantile(0.99) << std::setw(10) << digest.max()
+              << stats.breaches << " (" << (100.0 * stats.breaches / digest.count()) << "%)\n";
+}
+
+void ResponseAnalytics::printStage(ResponseStage stage) {
+    const bool dispatch = stage == ResponseStage::Dispatch;
+    std::cout << "\n=== " << (dispatch ? "Dispatch Latency (Logged -> Processing)" : "Completion Latency (Logged -> Completed)")
+              << ", minutes ===\n";
+
+    // Per priority, then every priority merged into one digest
+    printStatsHeader("Priority (SLA target)");
+    LatencyStats all;
+    for (int priority = 1; priority <= ANALYTICS_PRIORITY_LEVELS; priority++) {
+        LatencyStats &stats = byPriority(stage, priority);
+        std::ostringstream label;
+        label << priority << " (" << (dispatch ? dispatchTargetMinutes(priority) : completionTargetMinutes(priority)) << " min)";
+        printStatsRow(label.str(), stats);
+        all.minutes.merge(stats.minutes);
+        all.breaches += stats.breaches;
+    }
+    printStatsRow("All", all);
+
+    // Per emergency type, alphabetically
+    StringHashMap<LatencyStats> &types = dispatch ? dispatchByType : completionByType;
+    const int count = types.getSize();
+    if (count == 0) return;
+
+    std::string* names = new std::string[count];
+    int filled = 0;
+    types.forEach([names, &filled](const std::string& name, const LatencyStats&) {
+        int i = filled++;
+        while (i > 0 && names[i - 1] > name) {
+            names[i] = names[i - 1];
+            i--;
+        }
+        names[i] = name;
+    });
+
+    std::cout << "\n";
+    printStatsHeader("Emergency Type");
+    for (int i = 0; i < count; i++) {
+        printStatsRow(names[i], *types.find(names[i]));
+    }
+    delete[] names;
+}
+
+void ResponseAnalytics::printDashboard() {
+    std::cout << std::fixed << std::setprecision(1);
+    printStage(ResponseStage::Dispatch);
+    printStage(ResponseStage::Completion);
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
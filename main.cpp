@@ -1,10 +1,51 @@
 #include <iostream>
 #include <filesystem>
+#include <string>
 #include "session_manager.hpp"
+#include "path_utils.hpp"
+#include "logger.hpp"
+#include "rollup_store.hpp"
 
 namespace fs = std::filesystem;
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Flags take "--name value" or "--name=value" and override the matching environment variables
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        const std::string::size_type equals = arg.find('=');
+        if (equals != std::string::npos) {
+            value = arg.substr(equals + 1);
+            arg = arg.substr(0, equals);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        }
+
+        LogLevel level;
+        bool ok = !value.empty();
+        if (ok && arg == "--data-dir") {
+            setDataRoot(value);                                 // Overrides HOSPITAL_DATA_DIR
+        } else if (ok && arg == "--log-level") {
+            ok = Logger::parseLevel(value, level);              // Overrides HOSPITAL_LOG_LEVEL
+            if (ok) Logger::instance().setConsoleLevel(level);
+        } else if (ok && arg == "--log-file") {
+            ok = Logger::instance().openFile(value);            // Overrides HOSPITAL_LOG_FILE
+        } else if (ok && arg == "--log-jsonl") {
+            ok = Logger::instance().openJsonl(value);           // Overrides HOSPITAL_LOG_JSONL
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "Usage: " << argv[0] << " [--data-dir <directory>] [--log-level debug|info|warning|error|off]"
+                      << " [--log-file <path>] [--log-jsonl <path>]\n";
+            return 1;
+        }
+    }
+
+    // Backfill the rollups before any role writes to the datasets they are built from
+    RollupStore::instance().load();
+
     std::string credentials_path = "user_credentials.csv";
     SessionManager::start(credentials_path);
     return 0;
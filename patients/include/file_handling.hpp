@@ -3,6 +3,9 @@
 
 #include <fstream>
 #include <chrono>
+#include <filesystem>
+#include <iterator>
+#include <system_error>
 #include <sstream>
 #include <iomanip>
 #include "patient_array.hpp"
@@ -11,9 +14,58 @@
 #include "string_utils.hpp"
 #include "config.hpp"
 #include "time_utils.hpp"
+#include "durable_writer.hpp"
+#include "snapshot.hpp"
+#include "hash_map.hpp"
+#include "rollup_store.hpp"
+
+inline void addPatientSnapshotRow(SnapshotWriter& snapshot, const Patient& patient) {
+    snapshot.addString(patient.patient_id).addString(patient.name).addString(patient.age)
+            .addString(patient.gender).addString(patient.bloodType).addString(patient.height)
+            .addString(patient.weight).addString(patient.BMI).addString(patient.temperature)
+            .addString(patient.heartRate).addString(patient.bloodPressure).addString(patient.condition);
+}
+
+inline void addQueueSnapshotRow(SnapshotWriter& snapshot, DynamicArray& queueElements) {
+    for (int i = 0; i < 5; i++) {
+        snapshot.addString(i < queueElements.getSize() ? queueElements.getElementAt(i) : "");
+    }
+}
+
+// Pads a field with spaces so a longer value can later overwrite it in place, split() trims them away
+inline std::string padCsvField(const std::string& field, int width) {
+    std::string padded = field;
+    if (static_cast<int>(padded.size()) < width) {
+        padded.append(width - padded.size(), ' ');
+    }
+    return padded;
+}
 
 inline PatientArray readPatientFile(PatientArray array, const std::string& filepath) {
     array.clearArray();
+
+    // An up-to-date snapshot is used as is, no per-row parsing
+    SnapshotReader snapshot(filepath, PATIENT_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            Patient patient;
+            patient.patient_id = snapshot.getString(row, 0);
+            patient.name = snapshot.getString(row, 1);
+            patient.age = snapshot.getString(row, 2);
+            patient.gender = snapshot.getString(row, 3);
+            patient.bloodType = snapshot.getString(row, 4);
+            patient.height = snapshot.getString(row, 5);
+            patient.weight = snapshot.getString(row, 6);
+            patient.BMI = snapshot.getString(row, 7);
+            patient.temperature = snapshot.getString(row, 8);
+            patient.heartRate = snapshot.getString(row, 9);
+            patient.bloodPressure = snapshot.getString(row, 10);
+            patient.condition = snapshot.getString(row, 11);
+            array.appendArray(patient);
+        }
+        return array;
+    }
+
     std::ifstream patientFile(filepath);
 
     if (!patientFile.is_open()) {
@@ -23,6 +75,7 @@ inline PatientArray readPatientFile(PatientArray array, const std::string& filep
         getline(patientFile, header, '\n');
         header.erase(0, header.size() - 1);
 
+        SnapshotWriter rebuilt(PATIENT_SNAPSHOT_COLUMNS);
         DynamicArray patientElements;
         std::string readline;
         while (getline(patientFile, readline, '\n')) {
@@ -30,16 +83,28 @@ inline PatientArray readPatientFile(PatientArray array, const std::string& filep
             if (auto patient = Patient(patientElements);
                 !patient.patient_id.empty()) {
                 array.appendArray(patient);
+                addPatientSnapshotRow(rebuilt, patient);
             }
             patientElements.clearArray();
         }
         patientFile.close();
         patientElements.clearArray();
+        rebuilt.save(filepath);
     }
     return array;
 }
 
-inline Queue readQueueFile(Queue queue, const std::string& filepath) {
+inline void readQueueFile(Queue& queue, const std::string& filepath) {
+    SnapshotReader snapshot(filepath, QUEUE_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            if (parsePatientStatus(snapshot.getString(row, 3)) == ADMITTED) {
+                queue.enqueue(snapshot.getString(row, 0), snapshot.getString(row, 1), snapshot.getString(row, 2));
+            }
+        }
+        return;
+    }
+
     std::ifstream queueFile(filepath);
 
     if (!queueFile.is_open()) {
@@ -49,10 +114,12 @@ inline Queue readQueueFile(Queue queue, const std::string& filepath) {
         getline(queueFile, header, '\n');
         header.erase(0, header.size() - 1);
 
+        SnapshotWriter rebuilt(QUEUE_SNAPSHOT_COLUMNS);
         DynamicArray queueElements;
         std::string readline;
         while (getline(queueFile, readline, '\n')) {
             queueElements = split(readline, ',', queueElements);
+            addQueueSnapshotRow(rebuilt, queueElements);
 
             const std::string patient_id = queueElements.getElementAt(0);
             const std::string condition = queueElements.getElementAt(1);
@@ -64,125 +131,494 @@ inline Queue readQueueFile(Queue queue, const std::string& filepath) {
             queueElements.clearArray();
         }
         queueFile.close();
+        rebuilt.save(filepath);
     }
-    return queue;
 }
 
-inline void appendPatientFile(const std::string& newLine, const std::string& filepath) {
-    std::ifstream patientFile(filepath);
+#define PATIENT_VITALS_FIELD_COLUMN 8  // Temperature, followed by Heart_Rate, Blood_Pressure and Condition_Type
+#define PATIENT_VITALS_FIELD_WIDTH 64  // Bytes kept for those four fields so new vitals fit in place
+
+// Where a patient's row lives in patient_data.csv, so new vitals only overwrite the end of it
+struct PatientRowLocation {
+    unsigned long long row_offset = 0;    // First byte of the row
+    unsigned long long vitals_offset = 0; // First byte of the Temperature field
+    int vitals_width = 0;                 // Bytes from Temperature to the end of the row
+};
+
+// Temperature through Condition_Type, the fields a re-triage or readmission changes
+inline std::string patientVitalsField(const Patient& patient) {
+    return patient.temperature + "," + patient.heartRate + "," + patient.bloodPressure + "," + patient.condition;
+}
+
+// A patient_data.csv row with the vitals padded to PATIENT_VITALS_FIELD_WIDTH
+inline std::string paddedPatientLine(const Patient& patient) {
+    return patient.patient_id + "," + patient.name + "," + patient.age + "," + patient.gender + "," + patient.bloodType + "," +
+           patient.height + "," + patient.weight + "," + patient.BMI + "," +
+           padCsvField(patientVitalsField(patient), PATIENT_VITALS_FIELD_WIDTH);
+}
+
+// Offset of the Temperature field within a row, npos if the row is too short
+inline size_t findPatientVitals(const std::string& line) {
+    size_t position = 0;
+    for (int commas = 0; commas < PATIENT_VITALS_FIELD_COLUMN; commas++) {
+        position = line.find(',', position);
+        if (position == std::string::npos) return position;
+        position++;
+    }
+    return position;
+}
+
+/**
+ * @brief Builds the patient ID -> row location index of patient_data.csv
+ * @details A byte scan for the Temperature column, the fields are not parsed. The first row
+ * of an ID wins, as in PatientArray::getPatientWithID
+ */
+inline void indexPatientFile(StringHashMap<PatientRowLocation>& rows, const std::string& filepath) {
+    rows.clear();
+    std::ifstream patientFile(filepath, std::ios::binary);
     if (!patientFile.is_open()) {
-        MessageHandler::info("File \"" + filepath + "\" cannot be found. \n");
         return;
     }
+    std::string content((std::istreambuf_iterator<char>(patientFile)), std::istreambuf_iterator<char>());
+    patientFile.close();
 
-    std::string readline;
-    DynamicArray originalLines;
-    while (getline(patientFile, readline, '\n')) {
-        originalLines.appendArray(readline);
+    size_t start = content.find('\n'); // Skip the header
+    while (start != std::string::npos && start + 1 < content.size()) {
+        start++;
+        size_t end = content.find('\n', start);
+        size_t lineEnd = (end == std::string::npos) ? content.size() : end;
+        if (lineEnd > start && content[lineEnd - 1] == '\r') {
+            lineEnd--;
+        }
+
+        const std::string line = content.substr(start, lineEnd - start);
+        const size_t vitals = findPatientVitals(line);
+        if (vitals != std::string::npos) {
+            const std::string id = trim(line.substr(0, line.find(',')));
+            if (!id.empty() && !rows.contains(id)) {
+                PatientRowLocation& row = rows.getOrInsert(id);
+                row.row_offset = start;
+                row.vitals_offset = start + vitals;
+                row.vitals_width = static_cast<int>(line.size() - vitals);
+            }
+        }
+        start = end;
+    }
+}
+
+/**
+ * @brief Appends a new patient row
+ * @return Location of the new row, vitals_width is 0 if the append failed
+ */
+inline PatientRowLocation appendPatientFile(const std::string& newLine, const std::string& filepath) {
+    PatientRowLocation location;
+    std::ifstream patientFile(filepath);
+    if (!patientFile.is_open()) {
+        MessageHandler::info("File \"" + filepath + "\" cannot be found. \n");
+        return location;
     }
     patientFile.close();
 
-    std::ofstream outputFile(filepath);
-    for (int i = 0; i < originalLines.getSize(); i++) {
-        outputFile << originalLines.getElementAt(i) + "\n";
+    // Only the new record is written, fsynced before returning
+    if (!appendDurably(filepath, newLine + "\n")) {
+        MessageHandler::error("Failed to append to \"" + filepath + "\".");
+        return location;
+    }
+
+    std::error_code ec;
+    const uintmax_t fileSize = std::filesystem::file_size(filepath, ec);
+    const size_t vitals = findPatientVitals(newLine);
+    if (!ec && fileSize > newLine.size() && vitals != std::string::npos) {
+        location.row_offset = fileSize - newLine.size() - 1;
+        location.vitals_offset = location.row_offset + vitals;
+        location.vitals_width = static_cast<int>(newLine.size() - vitals);
     }
-    outputFile << newLine + "\n";
-    outputFile.close();
+    return location;
 }
 
-inline void modifyPatientFile(const std::string& ID, const std::string& newLine, const std::string& filepath) {
+/**
+ * @brief Replaces a patient's row by rewriting patient_data.csv
+ * @return false if the ID has no row or the rewrite failed
+ */
+inline bool modifyPatientFile(const std::string& ID, const std::string& newLine, const std::string& filepath) {
     std::ifstream patientFile(filepath);
     if (!patientFile.is_open()) {
         MessageHandler::info("File \"" + filepath + "\" cannot be found. \n");
-        return;
+        return false;
     }
 
-    std::string readline;
-    DynamicArray originalLines;
-    while (getline(patientFile, readline, '\n')) {
-        originalLines.appendArray(readline);
+    // Stream the old file into a temp file that atomically replaces it on commit
+    DurableWriter outputFile(filepath);
+    if (!outputFile.isOpen()) {
+        return false;
     }
-    patientFile.close();
 
-    std::ofstream outputFile(filepath);
-    for (int i = 0; i < originalLines.getSize(); i++) {
-        std::string line = originalLines.getElementAt(i);
+    SnapshotWriter snapshot(PATIENT_SNAPSHOT_COLUMNS);
+    bool isHeader = true;
+    bool modified = false;
+    std::string readline;
+    while (getline(patientFile, readline, '\n')) {
         DynamicArray patientElements;
-        patientElements = split(line, ',', patientElements);
+        patientElements = split(readline, ',', patientElements);
 
-        if (patientElements.getElementAt(0) == ID) {
+        const bool replaced = !isHeader && patientElements.getSize() > 0 && patientElements.getElementAt(0) == ID;
+        if (replaced) {
+            modified = true;
             outputFile << newLine + "\n";
+            patientElements.clearArray();
+            patientElements = split(newLine, ',', patientElements);
         } else {
-            outputFile << line + "\n";
+            outputFile << readline + "\n";
         }
+
+        // Same filter as readPatientFile so the snapshot holds exactly the rows it would load
+        if (!isHeader && patientElements.getSize() > 0) {
+            if (auto patient = Patient(patientElements); !patient.patient_id.empty()) {
+                addPatientSnapshotRow(snapshot, patient);
+            }
+        }
+        isHeader = false;
+    }
+    patientFile.close();
+    const unsigned long long csvSize = outputFile.bytesWritten();
+    if (!outputFile.commit()) {
+        return false;
     }
-    outputFile.close();
+    snapshot.save(filepath, csvSize);
+    return modified;
 }
 
-inline void enqueueQueueFile(const std::string& PatientID, std::string condition, const std::string& filepath) {
-    std::ifstream queueFile(filepath);
+// Checks that the indexed bytes still hold this patient's row
+inline bool isPatientRowAt(const PatientRowLocation& row, const std::string& ID, const std::string& filepath) {
+    std::ifstream patientFile(filepath, std::ios::binary);
+    if (!patientFile.is_open() || row.vitals_width <= 0) {
+        return false;
+    }
+    const size_t length = static_cast<size_t>(row.vitals_offset - row.row_offset) + row.vitals_width;
+    std::string bytes(length, '\0');
+    patientFile.seekg(static_cast<std::streamoff>(row.row_offset));
+    if (!patientFile.read(&bytes[0], static_cast<std::streamsize>(length))) {
+        return false;
+    }
+    return bytes.compare(0, ID.size() + 1, ID + ",") == 0 && bytes.find('\n') == std::string::npos
+        && findPatientVitals(bytes) == static_cast<size_t>(row.vitals_offset - row.row_offset);
+}
+
+/**
+ * @brief Writes a patient's new vitals and condition to patient_data.csv
+ *
+ * @details
+ * - Rows located through the index are updated in place: only the padded Temperature to
+ *   Condition_Type bytes are overwritten. The patient snapshot is deleted, it no longer
+ *   matches the file
+ * - Rows without room for the new values, or an index that no longer matches the file, fall
+ *   back to rewriting the file once with the row padded; the index is rebuilt afterwards
+ */
+inline bool updatePatientRow(const Patient& patient, StringHashMap<PatientRowLocation>& rows, const std::string& filepath) {
+    const std::string field = patientVitalsField(patient);
+
+    PatientRowLocation* row = rows.find(patient.patient_id);
+    if (row != nullptr && row->vitals_width >= static_cast<int>(field.size()) && isPatientRowAt(*row, patient.patient_id, filepath)) {
+        std::error_code ec;
+        std::filesystem::remove(snapshotPathFor(filepath), ec);
+        if (overwriteDurably(filepath, row->vitals_offset, padCsvField(field, row->vitals_width))) {
+            return true;
+        }
+    }
+
+    const bool modified = modifyPatientFile(patient.patient_id, paddedPatientLine(patient), filepath);
+    indexPatientFile(rows, filepath);
+    return modified;
+}
+
+#define QUEUE_STATUS_FIELD_WIDTH 35    // "DISCHARGED," followed by a 24-character discharge time
+#define QUEUE_CONDITION_FIELD_WIDTH 30 // Bytes kept for the Condition so a re-triage fits in place
+
+// Where a waiting patient's row lives in queue.csv, so a discharge only overwrites its Status field
+struct QueueRowLocation {
+    unsigned long long row_offset = 0;       // First byte of the row
+    unsigned long long condition_offset = 0; // First byte of the Condition field
+    int condition_width = 0;                 // Bytes of the Condition field
+    unsigned long long status_offset = 0;    // First byte of the Status field
+    int status_width = 0;                    // Bytes from Status to the end of the row
+};
+
+/**
+ * @brief Builds the patient ID -> row location index of every ADMITTED row in queue.csv
+ * @details A byte scan for the Status column, the other fields are not parsed
+ */
+inline void indexQueueFile(StringHashMap<QueueRowLocation>& rows, const std::string& filepath) {
+    rows.clear();
+    std::ifstream queueFile(filepath, std::ios::binary);
     if (!queueFile.is_open()) {
-        MessageHandler::info("File \"" + filepath + "\" cannot be found. \n");
         return;
     }
+    std::string content((std::istreambuf_iterator<char>(queueFile)), std::istreambuf_iterator<char>());
+    queueFile.close();
 
-    std::string readline;
-    DynamicArray originalLines;
-    while (getline(queueFile, readline, '\n')) {
-        originalLines.appendArray(readline);
+    size_t start = content.find('\n'); // Skip the header
+    while (start != std::string::npos && start + 1 < content.size()) {
+        start++;
+        size_t end = content.find('\n', start);
+        size_t lineEnd = (end == std::string::npos) ? content.size() : end;
+        if (lineEnd > start && content[lineEnd - 1] == '\r') {
+            lineEnd--;
+        }
+
+        size_t statusStart = start;
+        for (int commas = 0; commas < 3 && statusStart != std::string::npos && statusStart < lineEnd; commas++) {
+            statusStart = content.find(',', statusStart);
+            if (statusStart != std::string::npos) statusStart++;
+        }
+        if (statusStart != std::string::npos && statusStart < lineEnd) {
+            size_t statusEnd = content.find(',', statusStart);
+            if (statusEnd == std::string::npos || statusEnd > lineEnd) statusEnd = lineEnd;
+            if (parsePatientStatus(content.substr(statusStart, statusEnd - statusStart)) == ADMITTED) {
+                const size_t conditionStart = content.find(',', start) + 1;
+                const std::string id = trim(content.substr(start, conditionStart - 1 - start));
+                if (!rows.contains(id)) {
+                    QueueRowLocation& row = rows.getOrInsert(id);
+                    row.row_offset = start;
+                    row.condition_offset = conditionStart;
+                    row.condition_width = static_cast<int>(content.find(',', conditionStart) - conditionStart);
+                    row.status_offset = statusStart;
+                    row.status_width = static_cast<int>(lineEnd - statusStart);
+                }
+            }
+        }
+        start = end;
     }
-    queueFile.close();
+}
 
-    std::ofstream outputFile(filepath);
-    for (int i = 0; i < originalLines.getSize(); i++) {
-        outputFile << originalLines.getElementAt(i) + "\n";
+/**
+ * @brief Appends a new ADMITTED row with Condition and Status fields wide enough to be updated in place
+ * @return Location of the new row, status_width is 0 if the append failed
+ */
+inline QueueRowLocation enqueueQueueFile(const std::string& PatientID, std::string condition, const std::string& filepath) {
+    QueueRowLocation location;
+    std::ifstream queueFile(filepath);
+    if (!queueFile.is_open()) {
+        MessageHandler::info("File \"" + filepath + "\" cannot be found. \n");
+        return location;
     }
+    queueFile.close();
 
     auto admission_time = std::chrono::system_clock::now();
     std::time_t formatted_admission_time = std::chrono::system_clock::to_time_t(admission_time);
 
-    outputFile << PatientID + "," + condition + "," + getCurrentTimeString(formatted_admission_time) + "," +
-        patientStatusToString(ADMITTED) + "," + "NOT_DISCHARGED\n";
+    const std::string paddedCondition = padCsvField(condition, QUEUE_CONDITION_FIELD_WIDTH);
+    const std::string prefix = PatientID + "," + paddedCondition + "," + getCurrentTimeString(formatted_admission_time) + ",";
+    const std::string status = padCsvField(patientStatusToString(ADMITTED) + "," + "NOT_DISCHARGED", QUEUE_STATUS_FIELD_WIDTH);
+    const std::string row = prefix + status + "\n";
 
-    outputFile.close();
+    // Only the new queue row is written, fsynced before returning
+    if (!appendDurably(filepath, row)) {
+        MessageHandler::error("Failed to append to \"" + filepath + "\".");
+        return location;
+    }
+    RollupStore::instance().add(ROLLUP_QUEUE_DAILY, RollupStore::todayBucket(), ROLLUP_ADMITTED, 1);
+
+    std::error_code ec;
+    const uintmax_t fileSize = std::filesystem::file_size(filepath, ec);
+    if (!ec && fileSize >= row.size()) {
+        location.row_offset = fileSize - row.size();
+        location.condition_offset = location.row_offset + PatientID.size() + 1;
+        location.condition_width = static_cast<int>(paddedCondition.size());
+        location.status_offset = location.row_offset + prefix.size();
+        location.status_width = static_cast<int>(status.size());
+    }
+    return location;
+}
+
+// Checks that the indexed bytes still hold this patient's ADMITTED row
+inline bool isQueueRowAt(const QueueRowLocation& row, const std::string& ID, const std::string& filepath) {
+    std::ifstream queueFile(filepath, std::ios::binary);
+    if (!queueFile.is_open() || row.status_width <= 0) {
+        return false;
+    }
+    const size_t length = static_cast<size_t>(row.status_offset - row.row_offset) + row.status_width;
+    std::string bytes(length, '\0');
+    queueFile.seekg(static_cast<std::streamoff>(row.row_offset));
+    if (!queueFile.read(&bytes[0], static_cast<std::streamsize>(length))) {
+        return false;
+    }
+    const std::string status = bytes.substr(static_cast<size_t>(row.status_offset - row.row_offset));
+    return bytes.compare(0, ID.size() + 1, ID + ",") == 0
+        && parsePatientStatus(status.substr(0, status.find(','))) == ADMITTED;
 }
 
-inline void dequeueQueueFile(const std::string& filepath) {
+/**
+ * @brief Marks one patient's ADMITTED row as DISCHARGED by rewriting queue.csv
+ * @param ID Patient to discharge, or "" for the first ADMITTED row
+ * @details Fallback for rows written before the Status field was padded
+ */
+inline bool dischargeQueueFileRow(const std::string& ID, const std::string& filepath) {
     bool dequeued = false;
 
     std::ifstream queueFile(filepath);
     if (!queueFile.is_open()) {
         MessageHandler::info("File \"" + filepath + "\" cannot be found. \n");
-        return;
+        return false;
     }
 
-    std::string readline;
-    DynamicArray originalLines;
-    while (getline(queueFile, readline, '\n')) {
-        originalLines.appendArray(readline);
+    // Stream the old file into a temp file that atomically replaces it on commit
+    DurableWriter outputFile(filepath);
+    if (!outputFile.isOpen()) {
+        return false;
     }
-    queueFile.close();
 
-    std::ofstream outputFile(filepath);
-    for (int i = 0; i < originalLines.getSize(); i++) {
-        std::string line = originalLines.getElementAt(i);
+    SnapshotWriter snapshot(QUEUE_SNAPSHOT_COLUMNS);
+    bool isHeader = true;
+    std::string line;
+    while (getline(queueFile, line, '\n')) {
         DynamicArray queueElements;
         queueElements = split(line, ',', queueElements);
 
-        if (!dequeued && parsePatientStatus(queueElements.getElementAt(3)) == ADMITTED) {
+        if (!dequeued && !isHeader && queueElements.getSize() > 3 && parsePatientStatus(queueElements.getElementAt(3)) == ADMITTED
+            && (ID.empty() || queueElements.getElementAt(0) == ID)) {
             auto discharge_time = std::chrono::system_clock::now();
             std::time_t formatted_discharge_time = std::chrono::system_clock::to_time_t(discharge_time);
 
-            outputFile << queueElements.getElementAt(0) + "," + queueElements.getElementAt(1) + "," +
+            const std::string dischargedLine = queueElements.getElementAt(0) + "," + queueElements.getElementAt(1) + "," +
                 queueElements.getElementAt(2) + "," + patientStatusToString(DISCHARGED) + "," +
-                getCurrentTimeString(formatted_discharge_time) + "\n";
+                getCurrentTimeString(formatted_discharge_time);
+            outputFile << dischargedLine + "\n";
+            queueElements.clearArray();
+            queueElements = split(dischargedLine, ',', queueElements);
 
             dequeued = true;
         } else {
             outputFile << line + "\n";
         }
+
+        if (!isHeader) {
+            addQueueSnapshotRow(snapshot, queueElements);
+        }
+        isHeader = false;
+    }
+    queueFile.close();
+    const unsigned long long csvSize = outputFile.bytesWritten();
+    if (!outputFile.commit()) {
+        return false;
+    }
+    snapshot.save(filepath, csvSize);
+    return dequeued;
+}
+
+/**
+ * @brief Marks one patient's row in queue.csv as DISCHARGED
+ *
+ * @details
+ * - Rows located through the index are updated in place: only the padded Status and
+ *   Discharge_Time bytes are overwritten, the rest of the file is untouched. The queue
+ *   snapshot is deleted, it no longer matches the file
+ * - Unpadded legacy rows, or an index that no longer matches the file, fall back to
+ *   rewriting the file once; the index is rebuilt afterwards because offsets moved
+ */
+inline bool dischargeQueueRow(const std::string& ID, StringHashMap<QueueRowLocation>& rows, const std::string& filepath) {
+    auto discharge_time = std::chrono::system_clock::now();
+    std::time_t formatted_discharge_time = std::chrono::system_clock::to_time_t(discharge_time);
+    const std::string field = patientStatusToString(DISCHARGED) + "," + getCurrentTimeString(formatted_discharge_time);
+
+    QueueRowLocation* row = rows.find(ID);
+    if (row != nullptr && row->status_width >= static_cast<int>(field.size()) && isQueueRowAt(*row, ID, filepath)) {
+        // The file keeps its size, so its snapshot would still pass for current when the mtimes
+        // tie. Drop it first, the next load parses the CSV and writes a fresh one
+        std::error_code ec;
+        std::filesystem::remove(snapshotPathFor(filepath), ec);
+        if (overwriteDurably(filepath, row->status_offset, padCsvField(field, row->status_width))) {
+            rows.erase(ID);
+            RollupStore::instance().add(ROLLUP_QUEUE_DAILY, RollupStore::todayBucket(), ROLLUP_DISCHARGED, 1);
+            return true;
+        }
+    }
+
+    const bool discharged = dischargeQueueFileRow(ID, filepath);
+    indexQueueFile(rows, filepath);
+    if (discharged) {
+        RollupStore::instance().add(ROLLUP_QUEUE_DAILY, RollupStore::todayBucket(), ROLLUP_DISCHARGED, 1);
+    }
+    return discharged;
+}
+
+/**
+ * @brief Sets the Condition of one patient's ADMITTED row by rewriting queue.csv
+ * @details Fallback for rows without room for the new condition, the rewritten row is padded
+ */
+inline bool modifyQueueFileCondition(const std::string& ID, const std::string& condition, const std::string& filepath) {
+    bool modified = false;
+
+    std::ifstream queueFile(filepath);
+    if (!queueFile.is_open()) {
+        MessageHandler::info("File \"" + filepath + "\" cannot be found. \n");
+        return false;
+    }
+
+    // Stream the old file into a temp file that atomically replaces it on commit
+    DurableWriter outputFile(filepath);
+    if (!outputFile.isOpen()) {
+        return false;
+    }
+
+    SnapshotWriter snapshot(QUEUE_SNAPSHOT_COLUMNS);
+    bool isHeader = true;
+    std::string line;
+    while (getline(queueFile, line, '\n')) {
+        DynamicArray queueElements;
+        queueElements = split(line, ',', queueElements);
+
+        if (!modified && !isHeader && queueElements.getSize() > 3 && parsePatientStatus(queueElements.getElementAt(3)) == ADMITTED
+            && queueElements.getElementAt(0) == ID) {
+            // Everything after the Condition, the padded Status included, is kept as it was
+            const size_t conditionStart = line.find(',') + 1;
+            const std::string updatedLine = line.substr(0, conditionStart) + padCsvField(condition, QUEUE_CONDITION_FIELD_WIDTH) +
+                line.substr(line.find(',', conditionStart));
+            outputFile << updatedLine + "\n";
+            queueElements.clearArray();
+            queueElements = split(updatedLine, ',', queueElements);
+
+            modified = true;
+        } else {
+            outputFile << line + "\n";
+        }
+
+        if (!isHeader) {
+            addQueueSnapshotRow(snapshot, queueElements);
+        }
+        isHeader = false;
+    }
+    queueFile.close();
+    const unsigned long long csvSize = outputFile.bytesWritten();
+    if (!outputFile.commit()) {
+        return false;
+    }
+    snapshot.save(filepath, csvSize);
+    return modified;
+}
+
+/**
+ * @brief Sets the Condition of one waiting patient's row in queue.csv
+ *
+ * @details
+ * - Rows located through the index are updated in place: only the padded Condition bytes are
+ *   overwritten and the queue snapshot is deleted, as in dischargeQueueRow()
+ * - Conditions longer than the field, or an index that no longer matches the file, fall back
+ *   to rewriting the file once; the index is rebuilt afterwards
+ */
+inline bool updateQueueRowCondition(const std::string& ID, const std::string& condition, StringHashMap<QueueRowLocation>& rows,
+                                    const std::string& filepath) {
+    QueueRowLocation* row = rows.find(ID);
+    if (row != nullptr && row->condition_width >= static_cast<int>(condition.size()) && isQueueRowAt(*row, ID, filepath)) {
+        std::error_code ec;
+        std::filesystem::remove(snapshotPathFor(filepath), ec);
+        if (overwriteDurably(filepath, row->condition_offset, padCsvField(condition, row->condition_width))) {
+            return true;
+        }
     }
-    outputFile.close();
+
+    const bool modified = modifyQueueFileCondition(ID, condition, filepath);
+    indexQueueFile(rows, filepath);
+    return modified;
 }
 
 #endif
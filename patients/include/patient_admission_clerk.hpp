@@ -8,6 +8,8 @@
 #include "queue.hpp"
 #include "patient_array.hpp"
 #include "file_handling.hpp"
+#include "patient_search_index.hpp"
+#include "triage_queue.hpp"
 // #include "../utils/message_handler.hpp"
 
 class PatientAdmissionClerk {
@@ -15,8 +17,15 @@ class PatientAdmissionClerk {
         std::string name;
         Queue patientQueue;
         PatientArray allPatients;
+        StringHashMap<int> patientSlots; // Patient ID -> index in allPatients
         std::string patientFilepath;
         std::string queueFilePath;
+        StringHashMap<QueueRowLocation> queueRows; // Waiting patients' rows in queue.csv
+        StringHashMap<PatientRowLocation> patientRows; // Patients' rows in patient_data.csv
+        PatientSearchIndex searchIndex; // Name/condition search over allPatients
+        TriageQueue triageQueue; // Same waiting patients as patientQueue, most urgent first
+
+        int findPatientSlot(const std::string& ID) const; // Index in allPatients, -1 if unknown
     public:
         PatientAdmissionClerk();
         void displayMenu();
@@ -25,6 +34,12 @@ class PatientAdmissionClerk {
         void viewPatientQueue();
         void viewPatient();
         void dischargePatient();
+        void dischargePatientByID();
+        void searchPatients();
+        void displayTriageMenu();
+        void viewTriageQueue();
+        void dischargeMostUrgentPatient();
+        void retriagePatient();
 };
 
 #endif
\ No newline at end of file
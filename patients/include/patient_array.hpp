@@ -22,6 +22,8 @@ class PatientArray {
         void clearArray();
         bool isInArray(std::string patientID);
         Patient getPatientWithID(std::string patientID);
+        Patient getPatientAt(int index);
+        bool setPatientAt(int index, const Patient& patient);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#ifndef PATIENT_SEARCH_INDEX_HPP
+#define PATIENT_SEARCH_INDEX_HPP
+
+#include <string>
+#include "entities.hpp"
+#include "hash_map.hpp"
+
+#define MAX_SEARCH_RESULTS 20
+#define FUZZY_MIN_SIMILARITY 0.5 // Share of the query's trigrams a fuzzy match must contain
+#define FUZZY_MAX_CANDIDATES 4096 // Patients a fuzzy query scores at most, drawn from its rarest trigrams
+
+/**
+ * @struct PatientSearchFilter
+ * @brief Optional filters applied to every search result, -1 / empty means "any"
+ */
+struct PatientSearchFilter {
+    int min_age = -1;
+    int max_age = -1;
+    std::string blood_type;
+};
+
+/**
+ * @struct PatientSearchHit
+ * @brief One search result, prefix matches come before fuzzy ones
+ */
+struct PatientSearchHit {
+    std::string patient_id;
+    std::string name;
+    int age = -1;
+    std::string blood_type;
+    std::string condition;
+    bool fuzzy = false;
+    double similarity = 1.0; /// Share of the query's trigrams found, 1 for prefix matches
+};
+
+/**
+ * @brief In-memory search index over patient names and conditions
+ *
+ * @details
+ * - Name and condition are split into lowercase words. A trie over the words answers prefix
+ *   queries ("mar" finds Maria and Marcus): walk the prefix, then read the posting lists of
+ *   the subtree until enough results pass the filters
+ * - A trigram inverted index catches typos and infixes ("mria" still finds Maria): patients
+ *   sharing at least FUZZY_MIN_SIMILARITY of the query's trigrams are ranked by that share.
+ *   It only runs when no prefix match is found. Such a patient contains at least one of the
+ *   query's rarest trigrams (all but the number it must share, plus one), so only those
+ *   posting lists are read, up to FUZZY_MAX_CANDIDATES patients
+ * - Age and blood type filters are checked against the indexed copy of each patient, no
+ *   lookups in PatientArray
+ * - Built once at load; add() and updateCondition() keep it current on admission. An update
+ *   only touches the posting lists of words and trigrams that actually changed, and each
+ *   document records its position in every list it is on, so leaving a list is O(1)
+ * - A document keeps its words, prefix checks on candidates never re-split the text
+ * - Per-patient scratch arrays are marked with a per-query stamp instead of being cleared,
+ *   a query only costs the posting lists it reads
+ *
+ * @usage
+ *      PatientSearchIndex index;
+ *      index.add(patient);
+ *      PatientSearchFilter filter; filter.min_age = 25; filter.max_age = 35; filter.blood_type = "B-";
+ *      PatientSearchHit hits[MAX_SEARCH_RESULTS];
+ *      int found = index.search("maria", filter, hits, MAX_SEARCH_RESULTS);
+ */
+class PatientSearchIndex {
+private:
+    struct Posting {
+        int document;
+        int membership; /// Index in the document's memberships pointing back at this posting
+    };
+
+    struct Membership {
+        int list;       /// Index in postingLists
+        int position;   /// Index of the document's posting in that list
+    };
+
+    struct PostingList {
+        Posting* entries = nullptr;
+        int size = 0;
+        int capacity = 0;
+        int mark = 0;   /// Equals queryStamp while the list belongs to the current fuzzy query
+    };
+
+    struct TrieNode {
+        char letter;
+        int firstChild;
+        int nextSibling;
+        int postings;   /// Index in postingLists of the patients having this exact word, -1 if none
+    };
+
+    struct Document {
+        std::string patient_id;
+        std::string name;
+        std::string condition;
+        std::string blood_type;
+        int age = -1;
+        std::string* words = nullptr;       /// Lowercase words of name and condition
+        int wordCount = 0;
+        Membership* memberships = nullptr;  /// Every posting list the document is on
+        int membershipCount = 0;
+        int membershipCapacity = 0;
+    };
+
+    TrieNode* trie;
+    int trieSize;
+    int trieCapacity;
+
+    PostingList* postingLists;
+    int postingCount;
+    int postingCapacity;
+
+    StringHashMap<int> trigramPostings;   /// Trigram -> index in postingLists
+
+    Document* documents;
+    int documentCount;
+    int documentCapacity;
+    StringHashMap<int> documentById;      /// Patient ID -> document
+
+    // Per-document scratch space of a query, valid where the stamp equals queryStamp
+    int* resultStamp;                     /// Document already returned by this query
+    int* countStamp;                      /// Document is already a candidate of this fuzzy query
+    int* touched;                         /// Candidates of the current fuzzy query
+    int queryStamp;
+
+    void growDocuments();
+
+    int newTrieNode(char letter);
+    int newPostingList();
+    void addPosting(int list, int document);
+    void removePosting(int list, int document);
+    static void storeWords(Document& doc, const std::string* words, int wordCount);
+
+    static int splitWords(const std::string& text, std::string* words, int maxWords);
+    static int collectTrigrams(const std::string& text, std::string* trigrams, int maxTrigrams);
+    int collectDocumentWords(const Document& doc, std::string* words, int maxWords) const;
+    int collectDocumentTrigrams(const Document& doc, std::string* trigrams, int maxTrigrams) const;
+
+    int findWordNode(const std::string& word) const;
+    void indexWord(const std::string& word, int document);
+    void unindexWord(const std::string& word, int document);
+    void indexTrigram(const std::string& trigram, int document);
+    void unindexTrigram(const std::string& trigram, int document);
+
+    bool passesFilter(const Document& doc, const PatientSearchFilter& filter) const;
+    bool matchesAllPrefixes(const Document& doc, const std::string* words, int wordCount) const;
+    void fillHit(PatientSearchHit& hit, int document, bool fuzzy, double similarity) const;
+    int collectPrefix(int node, const std::string* words, int wordCount, const PatientSearchFilter& filter,
+                      PatientSearchHit* hits, int found, int maxHits);
+
+public:
+    PatientSearchIndex();
+    ~PatientSearchIndex();
+
+    PatientSearchIndex(const PatientSearchIndex&) = delete;
+    PatientSearchIndex& operator=(const PatientSearchIndex&) = delete;
+
+    /**
+     * @brief Indexes a patient, an ID that is already indexed gets its condition updated instead
+     */
+    void add(const Patient& patient);
+
+    /**
+     * @brief Re-indexes a patient's condition after an admission
+     * @return false if the patient is not indexed
+     */
+    bool updateCondition(const std::string& patientId, const std::string& condition);
+
+    /**
+     * @brief Finds patients by name or condition, then by filters alone if text is empty
+     * @param text Words to look for, each must prefix a word of the name or condition
+     * @param hits Output array
+     * @param maxHits Capacity of hits
+     * @return Number of hits stored, prefix matches first, then fuzzy matches by similarity
+     */
+    int search(const std::string& text, const PatientSearchFilter& filter, PatientSearchHit* hits, int maxHits);
+
+    int getSize() const { return documentCount; }
+};
+
+#endif // PATIENT_SEARCH_INDEX_HPP
@@ -4,6 +4,8 @@
 #include <string>
 #include "entities.hpp"
 #include "string_utils.hpp"
+#include "hash_map.hpp"
+#include "node_pool.hpp"
 
 enum PatientStatus {ADMITTED ,DISCHARGED, NONE};
 
@@ -36,7 +38,15 @@ class Node {
         std::string admission;
         PatientStatus status;
         std::string discharge;
+        int ticket; // Slot in the queue's ticket tree, increases from front to rear
         Node* next;
+        Node* prev; // Doubly linked so a patient can leave from the middle in O(1)
+};
+
+// Earliest queued node of a patient, and how many times the patient is queued
+struct QueueIndexEntry {
+    Node* node = nullptr;
+    int count = 0;
 };
 
 class Queue {
@@ -44,8 +54,27 @@ class Queue {
         Node* front;
         Node* rear;
         int queueLength;
+
+        NodePool<Node, 64, true> nodePool; // Discharged nodes are recycled by later admissions
+        StringHashMap<QueueIndexEntry> index; // Patient ID -> node, membership without walking the list
+
+        // Fenwick tree over ticket slots: 1 for every waiting patient, 0 once discharged,
+        // so a patient's position is the prefix sum up to its ticket
+        int* ticketTree;
+        int ticketCapacity;
+        int nextTicket;
+
+        void link(Node* newNode);
+        void unlink(Node* node);
+        void addTicket(Node* node);
+        void releaseTicket(const Node* node);
+        void renumberTickets();
+        int countTicketsUpTo(int ticket) const;
     public:
         Queue();
+        ~Queue();
+        Queue(const Queue&) = delete;
+        Queue& operator=(const Queue&) = delete;
         [[nodiscard]] bool isEmpty() const;
         [[nodiscard]] int getLength() const;
         [[nodiscard]] Node* getFront() const;
@@ -54,6 +83,8 @@ class Queue {
         bool enqueue(std::string Patient_id, std::string Condition);
         bool enqueue(std::string Patient_id, std::string Condition, std::string Admission);
         bool dequeue();
+        bool remove(const std::string& ID);
+        bool updateCondition(const std::string& ID, const std::string& condition); // Earliest queued node of the patient
         bool inQueue(std::string ID);
         int getPatientQueueNumber(std::string ID);
 };
@@ -0,0 +1,122 @@
+#ifndef TRIAGE_QUEUE_HPP
+#define TRIAGE_QUEUE_HPP
+
+#include <string>
+#include "entities.hpp"
+#include "hash_map.hpp"
+
+#define TRIAGE_HEAP_ARITY 4          // Children per heap node, a shallower tree than a binary heap
+#define TRIAGE_MINUTES_PER_POINT 15  // Waiting this long is worth one point of triage score
+#define TRIAGE_MAX_SCORE 16          // Vitals (3 x 3 points) plus the condition (up to 7 points)
+
+/**
+ * @struct TriageEntry
+ * @brief One waiting patient as ordered by the triage queue
+ */
+struct TriageEntry {
+    std::string patient_id;
+    std::string condition;
+    std::string admission;  /// Admission time as written to queue.csv
+    int score = 0;          /// Triage score, higher is more urgent
+    long long admitted = 0; /// Admission time, seconds since the epoch
+    long long sequence = 0; /// Arrival order, breaks ties between equal keys
+    long long key = 0;      /// admitted - score * TRIAGE_MINUTES_PER_POINT minutes, smallest is seen first
+};
+
+/**
+ * @brief Admission queue ordered by triage score, with aging, beside the FIFO Queue
+ *
+ * @details
+ * - The score comes from the patient's vitals (heart rate, temperature, systolic pressure)
+ *   and condition, see score()
+ * - Aging: a patient's urgency is score + minutes waited / TRIAGE_MINUTES_PER_POINT. Every
+ *   patient gains urgency at the same rate, so the order only depends on
+ *   admitted - score * TRIAGE_MINUTES_PER_POINT, fixed at admission. The heap never needs
+ *   re-sorting as time passes, and a patient admitted more than
+ *   TRIAGE_MAX_SCORE * TRIAGE_MINUTES_PER_POINT minutes after another never goes first
+ * - A TRIAGE_HEAP_ARITY-ary min-heap on that key, with a patient ID -> slot index:
+ *   push(), pop(), remove() and retriage() (decrease- or increase-key) are O(log n)
+ * - Holds the same ADMITTED rows of queue.csv as the FIFO Queue, no file of its own
+ *
+ * @usage
+ *      TriageQueue triage;
+ *      triage.push(patient, "Sun Nov 09 19:55:50 2025");
+ *      TriageEntry next;
+ *      if (triage.pop(next)) { ... }
+ *      triage.retriage(updatedPatient);
+ */
+class TriageQueue {
+private:
+    TriageEntry* heap;
+    int count;
+    int capacity;
+    long long nextSequence;
+    StringHashMap<int> slots; /// Patient ID -> index in heap
+
+    bool before(const TriageEntry& a, const TriageEntry& b) const;
+    void place(int slot, const TriageEntry& entry);
+    int siftUp(int slot);
+    int siftDown(int slot);
+    void removeAt(int slot);
+
+public:
+    TriageQueue();
+    ~TriageQueue();
+    TriageQueue(const TriageQueue&) = delete;
+    TriageQueue& operator=(const TriageQueue&) = delete;
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] int getLength() const;
+    [[nodiscard]] bool contains(const std::string& patientID) const;
+
+    /**
+     * @brief Queues a patient admitted at a ctime() time ("Sun Nov 09 19:55:50 2025")
+     * @return false if the patient is already queued
+     */
+    bool push(const Patient& patient, const std::string& admission);
+
+    /**
+     * @brief Takes the most urgent patient off the queue
+     * @return false if the queue is empty
+     */
+    bool pop(TriageEntry& out);
+
+    /**
+     * @brief Most urgent patient, nullptr if the queue is empty
+     */
+    [[nodiscard]] const TriageEntry* peek() const;
+
+    /**
+     * @brief Takes a patient off the queue wherever it is
+     */
+    bool remove(const std::string& patientID);
+
+    /**
+     * @brief Rescores a queued patient from new vitals or condition and moves it to its new place
+     * @return false if the patient is not queued
+     */
+    bool retriage(const Patient& patient);
+
+    /**
+     * @brief Copies the queue into out, most urgent first
+     * @return Number of entries copied, at most maxEntries
+     */
+    int listInOrder(TriageEntry* out, int maxEntries) const;
+
+    /**
+     * @brief Urgency of an entry now: its score plus the points earned by waiting
+     */
+    static double urgency(const TriageEntry& entry, long long now);
+
+    /**
+     * @brief Triage score of a patient, 0 (stable) to TRIAGE_MAX_SCORE
+     */
+    static int score(const Patient& patient);
+
+    /**
+     * @brief Seconds since the epoch of a ctime() time, -1 if unreadable
+     */
+    static long long parseAdmission(const std::string& admission);
+};
+
+#endif // TRIAGE_QUEUE_HPP
@@ -1,13 +1,40 @@
 #include "patient_admission_clerk.hpp"
 #include "path_utils.hpp"
 #include "message_handler.hpp"
+#include "id_allocator.hpp"
+#include <ctime>
 
 PatientAdmissionClerk::PatientAdmissionClerk() {
     name = "";
     patientFilepath = getDataFilePath("patient_data.csv");
     queueFilePath = getDataFilePath("queue.csv");
     allPatients = readPatientFile(allPatients, patientFilepath);
-    patientQueue = readQueueFile(patientQueue, queueFilePath);
+    readQueueFile(patientQueue, queueFilePath);
+    indexQueueFile(queueRows, queueFilePath);
+    indexPatientFile(patientRows, patientFilepath);
+
+    IdAllocator &ids = IdAllocator::instance();
+    for (int i = 0; i < allPatients.getSize(); i++) {
+        const Patient patient = allPatients.getPatientAt(i);
+        searchIndex.add(patient);
+        ids.observeId(PATIENT_ID_NAMESPACE, patient.patient_id);
+        if (!patientSlots.contains(patient.patient_id)) {
+            patientSlots.insertOrAssign(patient.patient_id, i);
+        }
+    }
+
+    // Scored from the latest vitals on file, in queue order so equal keys keep it
+    for (Node* node = patientQueue.getFront(); node != nullptr; node = node->next) {
+        Patient patient = allPatients.getPatientAt(findPatientSlot(node->patient_id));
+        patient.patient_id = node->patient_id;
+        patient.condition = node->condition;
+        triageQueue.push(patient, node->admission);
+    }
+}
+
+int PatientAdmissionClerk::findPatientSlot(const std::string& ID) const {
+    const int* slot = patientSlots.find(ID);
+    return slot != nullptr ? *slot : -1;
 }
 
 void PatientAdmissionClerk::displayMenu() {
@@ -21,7 +48,10 @@ void PatientAdmissionClerk::displayMenu() {
         std::cout << "3. View Patient Queue"                                            << std::endl;
         std::cout << "4. View Patient Latest Condition"                                 << std::endl;
         std::cout << "5. Discharge Patient"                                             << std::endl;
-        std::cout << "6. Exit"                                                          << std::endl;
+        std::cout << "6. Discharge Patient by ID"                                       << std::endl;
+        std::cout << "7. Search Patients"                                               << std::endl;
+        std::cout << "8. Triage Queue"                                                  << std::endl;
+        std::cout << "9. Exit"                                                          << std::endl;
         std::cout << "---------------------------------------------------------------"  << std::endl;
         std::cout << "Enter a number to perform an action: " << std::flush;
 
@@ -50,13 +80,22 @@ void PatientAdmissionClerk::displayMenu() {
                 dischargePatient();
                 break;
             case 6:
+                dischargePatientByID();
+                break;
+            case 7:
+                searchPatients();
+                break;
+            case 8:
+                displayTriageMenu();
+                break;
+            case 9:
                 MessageHandler::info("Exiting Patient Admission System...\n");
                 break;
             default:
                 MessageHandler::error("Invalid choice. Please select a valid option.");
                 break;
         }
-    } while (choice != 6);
+    } while (choice != 9);
 }
 
 void PatientAdmissionClerk::admitNewPatient() {
@@ -89,16 +128,24 @@ void PatientAdmissionClerk::admitNewPatient() {
     stream << std::fixed << std::setprecision(2) << result;
     patient.BMI = stream.str();
 
-    std::string newID = std::to_string(allPatients.getSize() + 1);
-    newID.insert(0, 4 - newID.length(), '0');
-    newID = "PAT-" + newID;
+    // Never derived from the patient count, a discharge would make the next ID collide
+    const std::string newID = IdAllocator::format(PATIENT_ID_NAMESPACE, IdAllocator::instance().next(PATIENT_ID_NAMESPACE), 4);
     patient.patient_id = newID;
 
     allPatients.appendArray(patient);
-    appendPatientFile(patient.getLine(), patientFilepath);
+    patientSlots.insertOrAssign(newID, allPatients.getSize() - 1);
+    PatientRowLocation patientRow = appendPatientFile(paddedPatientLine(patient), patientFilepath);
+    if (patientRow.vitals_width > 0) {
+        patientRows.insertOrAssign(newID, patientRow);
+    }
+    searchIndex.add(patient);
 
     patientQueue.enqueue(patient.patient_id, patient.condition);
-    enqueueQueueFile(newID, patient.condition, queueFilePath);
+    triageQueue.push(patient, getCurrentTimeString(std::time(nullptr)));
+    QueueRowLocation row = enqueueQueueFile(newID, patient.condition, queueFilePath);
+    if (row.status_width > 0 && !queueRows.contains(newID)) {
+        queueRows.insertOrAssign(newID, row);
+    }
 }
 
 void PatientAdmissionClerk::admitExistingPatient() {
@@ -109,7 +156,8 @@ void PatientAdmissionClerk::admitExistingPatient() {
     std::cout << "\nPatient ID: " << std::flush;
     std::getline(std::cin, ID);
 
-    if(!allPatients.isInArray(ID)) {
+    const int slot = findPatientSlot(ID);
+    if(slot < 0) {
         MessageHandler::info("Patient does not exist.");
         return;
     }
@@ -123,14 +171,19 @@ void PatientAdmissionClerk::admitExistingPatient() {
     std::getline(std::cin, Condition);
     std::cout << "---------------------------------------------------------------"  << std::endl;
 
-    Patient patient = allPatients.getPatientWithID(ID);
+    Patient patient = allPatients.getPatientAt(slot);
     patient.condition = Condition;
 
-    modifyPatientFile(ID, patient.getLine(), patientFilepath);
-    allPatients = readPatientFile(allPatients, patientFilepath);
+    allPatients.setPatientAt(slot, patient);
+    updatePatientRow(patient, patientRows, patientFilepath);
+    searchIndex.updateCondition(ID, Condition);
 
     patientQueue.enqueue(patient.patient_id, patient.condition);
-    enqueueQueueFile(ID, patient.condition, queueFilePath);
+    triageQueue.push(patient, getCurrentTimeString(std::time(nullptr)));
+    QueueRowLocation row = enqueueQueueFile(ID, patient.condition, queueFilePath);
+    if (row.status_width > 0 && !queueRows.contains(ID)) {
+        queueRows.insertOrAssign(ID, row);
+    }
 }
 
 void PatientAdmissionClerk::viewPatientQueue() {
@@ -212,7 +265,8 @@ void PatientAdmissionClerk::dischargePatient() {
 
     bool success = patientQueue.dequeue();
     if (success) {
-        dequeueQueueFile(queueFilePath);
+        if (!patientQueue.inQueue(ID)) triageQueue.remove(ID);
+        dischargeQueueRow(ID, queueRows, queueFilePath);
         MessageHandler::info("Patient " + ID + " has been discharged.\n");
     }
     else {
@@ -220,4 +274,265 @@ void PatientAdmissionClerk::dischargePatient() {
     }
 }
 
-    
\ No newline at end of file
+void PatientAdmissionClerk::dischargePatientByID() {
+    std::string ID;
+    std::cout << "\nEnter Patient ID to discharge: " << std::flush;
+    std::getline(std::cin, ID);
+    ID = trim(ID);
+
+    if (!patientQueue.remove(ID)) {
+        MessageHandler::info("Patient " + ID + " is not in the queue.\n");
+        return;
+    }
+    if (!patientQueue.inQueue(ID)) triageQueue.remove(ID);
+    if (!dischargeQueueRow(ID, queueRows, queueFilePath)) {
+        MessageHandler::error("Patient " + ID + " was removed from the queue but " + queueFilePath + " was not updated.\n");
+        return;
+    }
+    MessageHandler::info("Patient " + ID + " has been discharged.\n");
+}
+
+    
+
+/**
+ * @brief Parses an age filter: "30" exact, "~30" within AGE_SEARCH_TOLERANCE years, "25-35" a range
+ * @return false if the text is none of these
+ */
+static bool parseAgeFilter(const std::string& text, PatientSearchFilter& filter) {
+    constexpr int AGE_SEARCH_TOLERANCE = 5;
+    try {
+        if (text[0] == '~') {
+            const int age = std::stoi(text.substr(1));
+            filter.min_age = age > AGE_SEARCH_TOLERANCE ? age - AGE_SEARCH_TOLERANCE : 0;
+            filter.max_age = age + AGE_SEARCH_TOLERANCE;
+            return true;
+        }
+        const std::string::size_type dash = text.find('-');
+        if (dash != std::string::npos) {
+            filter.min_age = std::stoi(text.substr(0, dash));
+            filter.max_age = std::stoi(text.substr(dash + 1));
+            return filter.min_age <= filter.max_age;
+        }
+        filter.min_age = filter.max_age = std::stoi(text);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void PatientAdmissionClerk::searchPatients() {
+    std::string text, age, bloodType;
+    PatientSearchFilter filter;
+
+    std::cout << "\n----------------------- PATIENT SEARCH -----------------------"  << std::endl;
+    std::cout << "Name or condition (blank for any): " << std::flush;
+    std::getline(std::cin, text);
+    std::cout << "Age (e.g. 30, ~30, 25-35, blank for any): " << std::flush;
+    std::getline(std::cin, age);
+    std::cout << "Blood type (e.g. B-, blank for any): " << std::flush;
+    std::getline(std::cin, bloodType);
+
+    age = trim(age);
+    if (!age.empty() && !parseAgeFilter(age, filter)) {
+        MessageHandler::error("Invalid age. Use 30, ~30 or 25-35.");
+        return;
+    }
+    filter.blood_type = toUpper(trim(bloodType));
+    text = trim(text);
+    if (text.empty() && age.empty() && filter.blood_type.empty()) {
+        MessageHandler::info("Enter a name, condition, age or blood type to search.");
+        return;
+    }
+
+    PatientSearchHit hits[MAX_SEARCH_RESULTS];
+    const int found = searchIndex.search(text, filter, hits, MAX_SEARCH_RESULTS);
+    if (found == 0) {
+        MessageHandler::info("No matching patients.");
+        return;
+    }
+
+    constexpr int columnWidthOfPatientID = 14;
+    constexpr int columnWidthOfName = 20;
+    constexpr int columnWidthOfAge = 6;
+    constexpr int columnWidthOfBloodType = 8;
+    constexpr int columnWidthOfCondition = 30;
+    constexpr int columnWidthOfMatch = 10;
+
+    std::cout << std::left << "\n" <<
+        std::setw(columnWidthOfPatientID) << "Patient ID" <<
+        std::setw(columnWidthOfName) << "Name" <<
+        std::setw(columnWidthOfAge) << "Age" <<
+        std::setw(columnWidthOfBloodType) << "Blood" <<
+        std::setw(columnWidthOfCondition) << "Condition" <<
+        std::setw(columnWidthOfMatch) << "Match" <<
+        std::endl;
+    std::cout << std::string(columnWidthOfPatientID + columnWidthOfName + columnWidthOfAge + columnWidthOfBloodType +
+        columnWidthOfCondition + columnWidthOfMatch, '-') << "\n";
+
+    for (int i = 0; i < found; i++) {
+        const PatientSearchHit& hit = hits[i];
+        const std::string match = hit.fuzzy ? "~" + std::to_string(static_cast<int>(hit.similarity * 100)) + "%" : "prefix";
+        std::cout << std::left <<
+            std::setw(columnWidthOfPatientID) << hit.patient_id <<
+            std::setw(columnWidthOfName) << hit.name <<
+            std::setw(columnWidthOfAge) << (hit.age >= 0 ? std::to_string(hit.age) : "-") <<
+            std::setw(columnWidthOfBloodType) << hit.blood_type <<
+            std::setw(columnWidthOfCondition) << hit.condition <<
+            std::setw(columnWidthOfMatch) << match <<
+            "\n";
+    }
+    if (found == MAX_SEARCH_RESULTS) {
+        MessageHandler::info("Showing the first " + std::to_string(MAX_SEARCH_RESULTS) + " matches, refine the search to narrow them down.");
+    }
+}
+
+void PatientAdmissionClerk::displayTriageMenu() {
+    int choice;
+    do {
+        std::cout << "\n------------------------ TRIAGE QUEUE ------------------------"  << std::endl;
+        std::cout << "1. View Triage Queue"                                             << std::endl;
+        std::cout << "2. Discharge Most Urgent Patient"                                 << std::endl;
+        std::cout << "3. Re-triage Patient"                                             << std::endl;
+        std::cout << "4. Back"                                                          << std::endl;
+        std::cout << "---------------------------------------------------------------"  << std::endl;
+        std::cout << "Enter a number to perform an action: " << std::flush;
+
+        if (!(std::cin >> choice)) {
+            std::cin.clear();
+            std::cin.ignore(1000, '\n');
+            MessageHandler::error("Invalid input. Please enter a number.");
+            continue;
+        }
+        std::cin.ignore();
+
+        switch (choice) {
+            case 1:
+                viewTriageQueue();
+                break;
+            case 2:
+                dischargeMostUrgentPatient();
+                break;
+            case 3:
+                retriagePatient();
+                break;
+            case 4:
+                break;
+            default:
+                MessageHandler::error("Invalid choice. Please select a valid option.");
+                break;
+        }
+    } while (choice != 4);
+}
+
+void PatientAdmissionClerk::viewTriageQueue() {
+    if (triageQueue.isEmpty()) {
+        MessageHandler::info("Patient queue is empty.");
+        return;
+    }
+    const int queueLength = triageQueue.getLength();
+    TriageEntry* entries = new TriageEntry[queueLength];
+    const int listed = triageQueue.listInOrder(entries, queueLength);
+    const long long now = static_cast<long long>(std::time(nullptr));
+
+    constexpr int columnWidthOfQueueID = 8;
+    constexpr int columnWidthOfPatientID = 14;
+    constexpr int columnWidthOfName = 20;
+    constexpr int columnWidthOfCondition = 30;
+    constexpr int columnWidthOfScore = 8;
+    constexpr int columnWidthOfUrgency = 10;
+    constexpr int columnWidthOfAdmissionTime = 30;
+
+    std::cout << std::left << "\n" <<
+        std::setw(columnWidthOfQueueID) << "Queue" <<
+        std::setw(columnWidthOfPatientID) << "Patient ID" <<
+        std::setw(columnWidthOfName) << "Name" <<
+        std::setw(columnWidthOfCondition) << "Condition" <<
+        std::setw(columnWidthOfScore) << "Score" <<
+        std::setw(columnWidthOfUrgency) << "Urgency" <<
+        std::setw(columnWidthOfAdmissionTime) << "Admission Time" <<
+        std::endl;
+    std::cout << std::string(columnWidthOfQueueID + columnWidthOfPatientID + columnWidthOfName + columnWidthOfCondition +
+        columnWidthOfScore + columnWidthOfUrgency + columnWidthOfAdmissionTime, '-') << "\n";
+
+    for (int i = 0; i < listed; i++) {
+        std::stringstream urgency;
+        urgency << std::fixed << std::setprecision(1) << TriageQueue::urgency(entries[i], now);
+        std::cout << std::left <<
+            std::setw(columnWidthOfQueueID) << i + 1 <<
+            std::setw(columnWidthOfPatientID) << entries[i].patient_id <<
+            std::setw(columnWidthOfName) << allPatients.getPatientAt(findPatientSlot(entries[i].patient_id)).name <<
+            std::setw(columnWidthOfCondition) << entries[i].condition <<
+            std::setw(columnWidthOfScore) << entries[i].score <<
+            std::setw(columnWidthOfUrgency) << urgency.str() <<
+            std::setw(columnWidthOfAdmissionTime) << entries[i].admission <<
+            "\n";
+    }
+    std::cout << "Urgency is the triage score plus one point per " << TRIAGE_MINUTES_PER_POINT << " minutes waited.\n";
+    delete[] entries;
+}
+
+void PatientAdmissionClerk::dischargeMostUrgentPatient() {
+    TriageEntry next;
+    if (!triageQueue.pop(next)) {
+        MessageHandler::info("Patient queue is empty.");
+        return;
+    }
+
+    patientQueue.remove(next.patient_id);
+    if (!dischargeQueueRow(next.patient_id, queueRows, queueFilePath)) {
+        MessageHandler::error("Patient " + next.patient_id + " was removed from the queue but " + queueFilePath + " was not updated.\n");
+        return;
+    }
+    MessageHandler::info("Patient " + next.patient_id + " (triage score " + std::to_string(next.score) + ") has been discharged.\n");
+}
+
+void PatientAdmissionClerk::retriagePatient() {
+    std::string ID, value;
+    std::cout << "\n----------------------- RE-TRIAGE PATIENT -----------------------"  << std::endl;
+    std::cout << "Patient ID: " << std::flush;
+    std::getline(std::cin, ID);
+    ID = trim(ID);
+
+    if (!triageQueue.contains(ID)) {
+        MessageHandler::info("Patient " + ID + " is not in the queue.\n");
+        return;
+    }
+    const int slot = findPatientSlot(ID);
+    if (slot < 0) {
+        MessageHandler::error("Patient " + ID + " is queued but has no record in " + patientFilepath + ".\n");
+        return;
+    }
+
+    // Blank answers keep the recorded value
+    Patient patient = allPatients.getPatientAt(slot);
+    std::cout << "Patient Temperature (C, blank keeps " << patient.temperature << "): " << std::flush;
+    std::getline(std::cin, value);
+    if (!trim(value).empty()) patient.temperature = trim(value);
+    std::cout << "Patient Heart Rate (bpm, blank keeps " << patient.heartRate << "): " << std::flush;
+    std::getline(std::cin, value);
+    if (!trim(value).empty()) patient.heartRate = trim(value);
+    std::cout << "Patient Blood Pressure (mmHg, blank keeps " << patient.bloodPressure << "): " << std::flush;
+    std::getline(std::cin, value);
+    if (!trim(value).empty()) patient.bloodPressure = trim(value);
+    std::cout << "Patient Condition (blank keeps " << patient.condition << "): " << std::flush;
+    std::getline(std::cin, value);
+    const bool conditionChanged = !trim(value).empty() && trim(value) != patient.condition;
+    if (conditionChanged) patient.condition = trim(value);
+    std::cout << "---------------------------------------------------------------"  << std::endl;
+
+    // Only this patient's record and queue row change, both in memory and on disk
+    allPatients.setPatientAt(slot, patient);
+    if (!updatePatientRow(patient, patientRows, patientFilepath)) {
+        MessageHandler::error("Patient " + ID + " was re-triaged but " + patientFilepath + " was not updated.\n");
+    }
+    if (conditionChanged) {
+        searchIndex.updateCondition(ID, patient.condition);
+        patientQueue.updateCondition(ID, patient.condition);
+        if (!updateQueueRowCondition(ID, patient.condition, queueRows, queueFilePath)) {
+            MessageHandler::error("Patient " + ID + " was re-triaged but " + queueFilePath + " was not updated.\n");
+        }
+    }
+
+    triageQueue.retriage(patient);
+    MessageHandler::info("Patient " + ID + " re-triaged with score " + std::to_string(TriageQueue::score(patient)) + ".\n");
+}
@@ -80,4 +80,19 @@ Patient PatientArray::getPatientWithID(std::string patientID) {
         }
     }
     return Patient();
-}
\ No newline at end of file
+}
+
+Patient PatientArray::getPatientAt(int index) {
+    if (index < 0 || index >= size) {
+        return Patient();
+    }
+    return array[index];
+}
+
+bool PatientArray::setPatientAt(int index, const Patient& patient) {
+    if (index < 0 || index >= size) {
+        return false;
+    }
+    array[index] = patient;
+    return true;
+}
@@ -0,0 +1,439 @@
+#include "patient_search_index.hpp"
+
+#include <cctype>
+#include <utility>
+
+#define SEARCH_MAX_WORDS 64
+#define SEARCH_MAX_TRIGRAMS 256
+#define SEARCH_INITIAL_CAPACITY 64
+
+// Parses an age column, -1 if it is not a whole number
+static int parseAge(const std::string& age) {
+    try {
+        return std::stoi(age);
+    } catch (const std::exception&) {
+        return -1;
+    }
+}
+
+// True if value is among the first count entries of list
+static bool containsWord(const std::string* list, int count, const std::string& value) {
+    for (int i = 0; i < count; i++) {
+        if (list[i] == value) return true;
+    }
+    return false;
+}
+
+template <typename T>
+static void growTo(T*& array, int size, int newCapacity) {
+    T* grown = new T[newCapacity];
+    for (int i = 0; i < size; i++) {
+        grown[i] = std::move(array[i]);
+    }
+    delete[] array;
+    array = grown;
+}
+
+PatientSearchIndex::PatientSearchIndex()
+    : trie(new TrieNode[SEARCH_INITIAL_CAPACITY]), trieSize(0), trieCapacity(SEARCH_INITIAL_CAPACITY),
+      postingLists(new PostingList[SEARCH_INITIAL_CAPACITY]), postingCount(0), postingCapacity(SEARCH_INITIAL_CAPACITY),
+      documents(new Document[SEARCH_INITIAL_CAPACITY]), documentCount(0), documentCapacity(SEARCH_INITIAL_CAPACITY),
+      resultStamp(new int[SEARCH_INITIAL_CAPACITY]()), countStamp(new int[SEARCH_INITIAL_CAPACITY]()),
+      touched(new int[SEARCH_INITIAL_CAPACITY]),
+      queryStamp(0) {
+    newTrieNode('\0'); // Root
+}
+
+PatientSearchIndex::~PatientSearchIndex() {
+    for (int i = 0; i < postingCount; i++) {
+        delete[] postingLists[i].entries;
+    }
+    for (int i = 0; i < documentCount; i++) {
+        delete[] documents[i].words;
+        delete[] documents[i].memberships;
+    }
+    delete[] postingLists;
+    delete[] trie;
+    delete[] documents;
+    delete[] resultStamp;
+    delete[] countStamp;
+    delete[] touched;
+}
+
+int PatientSearchIndex::newTrieNode(char letter) {
+    if (trieSize == trieCapacity) {
+        growTo(trie, trieSize, trieCapacity * 2);
+        trieCapacity *= 2;
+    }
+    trie[trieSize] = TrieNode{letter, -1, -1, -1};
+    return trieSize++;
+}
+
+int PatientSearchIndex::newPostingList() {
+    if (postingCount == postingCapacity) {
+        growTo(postingLists, postingCount, postingCapacity * 2);
+        postingCapacity *= 2;
+    }
+    postingLists[postingCount] = PostingList{};
+    return postingCount++;
+}
+
+void PatientSearchIndex::growDocuments() {
+    const int newCapacity = documentCapacity * 2;
+    growTo(documents, documentCount, newCapacity);
+
+    // Scratch arrays start zeroed, a stamp of 0 never equals a live queryStamp
+    int* arrays[] = {resultStamp, countStamp};
+    for (int*& array : arrays) {
+        int* grown = new int[newCapacity]();
+        for (int i = 0; i < documentCount; i++) grown[i] = array[i];
+        delete[] array;
+        array = grown;
+    }
+    resultStamp = arrays[0];
+    countStamp = arrays[1];
+
+    delete[] touched;
+    touched = new int[newCapacity];
+    documentCapacity = newCapacity;
+}
+
+void PatientSearchIndex::addPosting(int list, int document) {
+    PostingList& postings = postingLists[list];
+    if (postings.size == postings.capacity) {
+        const int newCapacity = postings.capacity == 0 ? 4 : postings.capacity * 2;
+        growTo(postings.entries, postings.size, newCapacity);
+        postings.capacity = newCapacity;
+    }
+    Document& doc = documents[document];
+    if (doc.membershipCount == doc.membershipCapacity) {
+        const int newCapacity = doc.membershipCapacity == 0 ? 16 : doc.membershipCapacity * 2;
+        growTo(doc.memberships, doc.membershipCount, newCapacity);
+        doc.membershipCapacity = newCapacity;
+    }
+    postings.entries[postings.size] = Posting{document, doc.membershipCount};
+    doc.memberships[doc.membershipCount++] = Membership{list, postings.size++};
+}
+
+// Swap-and-pop on both sides; only the document's own memberships are searched, never the list
+void PatientSearchIndex::removePosting(int list, int document) {
+    Document& doc = documents[document];
+    int membership = 0;
+    while (membership < doc.membershipCount && doc.memberships[membership].list != list) membership++;
+    if (membership == doc.membershipCount) return;
+
+    PostingList& postings = postingLists[list];
+    const int position = doc.memberships[membership].position;
+    const Posting lastPosting = postings.entries[--postings.size];
+    if (position != postings.size) {
+        postings.entries[position] = lastPosting;
+        documents[lastPosting.document].memberships[lastPosting.membership].position = position;
+    }
+
+    const Membership lastMembership = doc.memberships[--doc.membershipCount];
+    if (membership != doc.membershipCount) {
+        doc.memberships[membership] = lastMembership;
+        postingLists[lastMembership.list].entries[lastMembership.position].membership = membership;
+    }
+}
+
+void PatientSearchIndex::storeWords(Document& doc, const std::string* words, int wordCount) {
+    delete[] doc.words;
+    doc.words = wordCount > 0 ? new std::string[wordCount] : nullptr;
+    for (int i = 0; i < wordCount; i++) doc.words[i] = words[i];
+    doc.wordCount = wordCount;
+}
+
+// Lowercase alphanumeric runs of text, each word once
+int PatientSearchIndex::splitWords(const std::string& text, std::string* words, int maxWords) {
+    int count = 0;
+    std::string word;
+    for (std::size_t i = 0; i <= text.size(); i++) {
+        const unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+        if (std::isalnum(c)) {
+            word += static_cast<char>(std::tolower(c));
+            continue;
+        }
+        if (!word.empty() && count < maxWords && !containsWord(words, count, word)) {
+            words[count++] = word;
+        }
+        word.clear();
+    }
+    return count;
+}
+
+// Trigrams of every word padded with one space on each side, each trigram once
+int PatientSearchIndex::collectTrigrams(const std::string& text, std::string* trigrams, int maxTrigrams) {
+    std::string words[SEARCH_MAX_WORDS];
+    const int wordCount = splitWords(text, words, SEARCH_MAX_WORDS);
+
+    int count = 0;
+    for (int w = 0; w < wordCount; w++) {
+        const std::string padded = " " + words[w] + " ";
+        for (std::size_t i = 0; i + 3 <= padded.size() && count < maxTrigrams; i++) {
+            const std::string trigram = padded.substr(i, 3);
+            if (!containsWord(trigrams, count, trigram)) {
+                trigrams[count++] = trigram;
+            }
+        }
+    }
+    return count;
+}
+
+int PatientSearchIndex::collectDocumentWords(const Document& doc, std::string* words, int maxWords) const {
+    return splitWords(doc.name + " " + doc.condition, words, maxWords);
+}
+
+int PatientSearchIndex::collectDocumentTrigrams(const Document& doc, std::string* trigrams, int maxTrigrams) const {
+    return collectTrigrams(doc.name + " " + doc.condition, trigrams, maxTrigrams);
+}
+
+// Trie node spelling word, -1 if no indexed word starts with it
+int PatientSearchIndex::findWordNode(const std::string& word) const {
+    int node = 0;
+    for (char letter : word) {
+        int child = trie[node].firstChild;
+        while (child != -1 && trie[child].letter != letter) {
+            child = trie[child].nextSibling;
+        }
+        if (child == -1) return -1;
+        node = child;
+    }
+    return node;
+}
+
+void PatientSearchIndex::indexWord(const std::string& word, int document) {
+    int node = 0;
+    for (char letter : word) {
+        int child = trie[node].firstChild;
+        while (child != -1 && trie[child].letter != letter) {
+            child = trie[child].nextSibling;
+        }
+        if (child == -1) {
+            child = newTrieNode(letter); // May move trie, so links are set through indices
+            trie[child].nextSibling = trie[node].firstChild;
+            trie[node].firstChild = child;
+        }
+        node = child;
+    }
+    if (trie[node].postings == -1) {
+        const int list = newPostingList();
+        trie[node].postings = list;
+    }
+    addPosting(trie[node].postings, document);
+}
+
+void PatientSearchIndex::unindexWord(const std::string& word, int document) {
+    const int node = findWordNode(word);
+    if (node != -1 && trie[node].postings != -1) {
+        removePosting(trie[node].postings, document);
+    }
+}
+
+void PatientSearchIndex::indexTrigram(const std::string& trigram, int document) {
+    int* list = trigramPostings.find(trigram);
+    if (!list) {
+        const int created = newPostingList();
+        trigramPostings.insertOrAssign(trigram, created);
+        list = trigramPostings.find(trigram);
+    }
+    addPosting(*list, document);
+}
+
+void PatientSearchIndex::unindexTrigram(const std::string& trigram, int document) {
+    if (const int* list = trigramPostings.find(trigram)) {
+        removePosting(*list, document);
+    }
+}
+
+void PatientSearchIndex::add(const Patient& patient) {
+    if (documentById.contains(patient.patient_id)) {
+        updateCondition(patient.patient_id, patient.condition);
+        return;
+    }
+    if (documentCount == documentCapacity) growDocuments();
+
+    const int document = documentCount++;
+    Document& doc = documents[document];
+    doc.patient_id = patient.patient_id;
+    doc.name = patient.name;
+    doc.condition = patient.condition;
+    doc.blood_type = patient.bloodType;
+    doc.age = parseAge(patient.age);
+    documentById.insertOrAssign(doc.patient_id, document);
+
+    std::string words[SEARCH_MAX_WORDS];
+    const int wordCount = collectDocumentWords(doc, words, SEARCH_MAX_WORDS);
+    storeWords(doc, words, wordCount);
+    for (int i = 0; i < wordCount; i++) indexWord(words[i], document);
+
+    std::string trigrams[SEARCH_MAX_TRIGRAMS];
+    const int trigramCount = collectDocumentTrigrams(doc, trigrams, SEARCH_MAX_TRIGRAMS);
+    for (int i = 0; i < trigramCount; i++) indexTrigram(trigrams[i], document);
+}
+
+bool PatientSearchIndex::updateCondition(const std::string& patientId, const std::string& condition) {
+    const int* found = documentById.find(patientId);
+    if (!found) return false;
+    const int document = *found;
+    Document& doc = documents[document];
+    if (doc.condition == condition) return true;
+
+    std::string newWords[SEARCH_MAX_WORDS];
+    std::string oldTrigrams[SEARCH_MAX_TRIGRAMS], newTrigrams[SEARCH_MAX_TRIGRAMS];
+    const int oldTrigramCount = collectDocumentTrigrams(doc, oldTrigrams, SEARCH_MAX_TRIGRAMS);
+    doc.condition = condition;
+    const int newWordCount = collectDocumentWords(doc, newWords, SEARCH_MAX_WORDS);
+    const int newTrigramCount = collectDocumentTrigrams(doc, newTrigrams, SEARCH_MAX_TRIGRAMS);
+
+    // Only postings of words and trigrams that appear or disappear are touched
+    for (int i = 0; i < doc.wordCount; i++) {
+        if (!containsWord(newWords, newWordCount, doc.words[i])) unindexWord(doc.words[i], document);
+    }
+    for (int i = 0; i < newWordCount; i++) {
+        if (!containsWord(doc.words, doc.wordCount, newWords[i])) indexWord(newWords[i], document);
+    }
+    storeWords(doc, newWords, newWordCount);
+    for (int i = 0; i < oldTrigramCount; i++) {
+        if (!containsWord(newTrigrams, newTrigramCount, oldTrigrams[i])) unindexTrigram(oldTrigrams[i], document);
+    }
+    for (int i = 0; i < newTrigramCount; i++) {
+        if (!containsWord(oldTrigrams, oldTrigramCount, newTrigrams[i])) indexTrigram(newTrigrams[i], document);
+    }
+    return true;
+}
+
+bool PatientSearchIndex::passesFilter(const Document& doc, const PatientSearchFilter& filter) const {
+    if (filter.min_age >= 0 && (doc.age < 0 || doc.age < filter.min_age)) return false;
+    if (filter.max_age >= 0 && (doc.age < 0 || doc.age > filter.max_age)) return false;
+    if (!filter.blood_type.empty() && doc.blood_type != filter.blood_type) return false;
+    return true;
+}
+
+// Every query word after the first must prefix some word of the document
+bool PatientSearchIndex::matchesAllPrefixes(const Document& doc, const std::string* words, int wordCount) const {
+    for (int q = 1; q < wordCount; q++) {
+        bool matched = false;
+        for (int d = 0; d < doc.wordCount && !matched; d++) {
+            matched = doc.words[d].compare(0, words[q].size(), words[q]) == 0;
+        }
+        if (!matched) return false;
+    }
+    return true;
+}
+
+void PatientSearchIndex::fillHit(PatientSearchHit& hit, int document, bool fuzzy, double similarity) const {
+    const Document& doc = documents[document];
+    hit.patient_id = doc.patient_id;
+    hit.name = doc.name;
+    hit.age = doc.age;
+    hit.blood_type = doc.blood_type;
+    hit.condition = doc.condition;
+    hit.fuzzy = fuzzy;
+    hit.similarity = similarity;
+}
+
+// Exact word at node first, then longer words below it; stops as soon as maxHits are found
+int PatientSearchIndex::collectPrefix(int node, const std::string* words, int wordCount,
+                                      const PatientSearchFilter& filter, PatientSearchHit* hits, int found, int maxHits) {
+    if (trie[node].postings != -1) {
+        const PostingList& list = postingLists[trie[node].postings];
+        for (int i = 0; i < list.size && found < maxHits; i++) {
+            const int document = list.entries[i].document;
+            if (resultStamp[document] == queryStamp) continue;
+            const Document& doc = documents[document];
+            if (!passesFilter(doc, filter) || !matchesAllPrefixes(doc, words, wordCount)) continue;
+
+            resultStamp[document] = queryStamp;
+            fillHit(hits[found++], document, false, 1.0);
+        }
+    }
+    for (int child = trie[node].firstChild; child != -1 && found < maxHits; child = trie[child].nextSibling) {
+        found = collectPrefix(child, words, wordCount, filter, hits, found, maxHits);
+    }
+    return found;
+}
+
+int PatientSearchIndex::search(const std::string& text, const PatientSearchFilter& filter,
+                               PatientSearchHit* hits, int maxHits) {
+    queryStamp++;
+    int found = 0;
+
+    std::string words[SEARCH_MAX_WORDS];
+    const int wordCount = splitWords(text, words, SEARCH_MAX_WORDS);
+    if (wordCount == 0) {
+        // Filters only, in admission order
+        for (int document = 0; document < documentCount && found < maxHits; document++) {
+            if (passesFilter(documents[document], filter)) {
+                fillHit(hits[found++], document, false, 1.0);
+            }
+        }
+        return found;
+    }
+
+    const int prefixNode = findWordNode(words[0]);
+    if (prefixNode != -1) {
+        found = collectPrefix(prefixNode, words, wordCount, filter, hits, found, maxHits);
+    }
+    if (found > 0) return found;
+
+    // Fuzzy pass, only when no word starts with the query: a patient sharing `needed` of the
+    // query's trigrams misses at most trigramCount - needed of them, so it is on at least one
+    // of the trigramCount - needed + 1 rarest lists. Candidates come from those lists alone
+    std::string trigrams[SEARCH_MAX_TRIGRAMS];
+    const int trigramCount = collectTrigrams(text, trigrams, SEARCH_MAX_TRIGRAMS);
+    if (trigramCount == 0) return found;
+    int lists[SEARCH_MAX_TRIGRAMS];
+    int sizes[SEARCH_MAX_TRIGRAMS];
+    for (int t = 0; t < trigramCount; t++) {
+        const int* listIndex = trigramPostings.find(trigrams[t]);
+        int list = listIndex ? *listIndex : -1;
+        int size = listIndex ? postingLists[*listIndex].size : 0;
+        int position = t;
+        while (position > 0 && sizes[position - 1] > size) { // Insertion sort, rarest first
+            lists[position] = lists[position - 1];
+            sizes[position] = sizes[position - 1];
+            position--;
+        }
+        lists[position] = list;
+        sizes[position] = size;
+        if (list != -1) postingLists[list].mark = queryStamp;
+    }
+
+    int needed = static_cast<int>(FUZZY_MIN_SIMILARITY * trigramCount);
+    if (needed < FUZZY_MIN_SIMILARITY * trigramCount) needed++;
+    if (needed < 1) needed = 1;
+    int touchedCount = 0;
+    for (int t = 0; t <= trigramCount - needed && touchedCount < FUZZY_MAX_CANDIDATES; t++) {
+        if (lists[t] == -1) continue;
+        const PostingList& list = postingLists[lists[t]];
+        for (int i = 0; i < list.size && touchedCount < FUZZY_MAX_CANDIDATES; i++) {
+            const int document = list.entries[i].document;
+            if (countStamp[document] == queryStamp) continue;
+            countStamp[document] = queryStamp;
+            touched[touchedCount++] = document;
+        }
+    }
+
+    // Keep the best candidates, sorted by similarity
+    for (int i = 0; i < touchedCount; i++) {
+        const int document = touched[i];
+        const Document& doc = documents[document];
+        int shared = 0; // Marked lists among the document's own postings, the query's lists are not walked
+        for (int m = 0; m < doc.membershipCount; m++) {
+            if (postingLists[doc.memberships[m].list].mark == queryStamp) shared++;
+        }
+        const double similarity = static_cast<double>(shared) / trigramCount;
+        if (similarity < FUZZY_MIN_SIMILARITY || resultStamp[document] == queryStamp) continue;
+        if (!passesFilter(documents[document], filter)) continue;
+        if (found == maxHits && similarity <= hits[found - 1].similarity) continue;
+
+        int position = found < maxHits ? found++ : maxHits - 1;
+        while (position > 0 && hits[position - 1].similarity < similarity) {
+            hits[position] = hits[position - 1];
+            position--;
+        }
+        fillHit(hits[position], document, true, similarity);
+    }
+    return found;
+}
@@ -5,9 +5,84 @@
 #include "message_handler.hpp"
 #include "time_utils.hpp"
 
+#define INITIAL_TICKET_CAPACITY 16
+
 Queue::Queue() {
     front = rear = nullptr;
     queueLength = 0;
+    ticketCapacity = INITIAL_TICKET_CAPACITY;
+    ticketTree = new int[ticketCapacity + 1]();
+    nextTicket = 0;
+}
+
+// Nodes belong to nodePool and are freed with it
+Queue::~Queue() {
+    delete[] ticketTree;
+}
+
+// Fenwick tree update: ticket slots are 0-based, tree indices 1-based
+void Queue::addTicket(Node* node) {
+    if (nextTicket == ticketCapacity) {
+        renumberTickets();
+    }
+    node->ticket = nextTicket++;
+    for (int i = node->ticket + 1; i <= ticketCapacity; i += i & -i) {
+        ticketTree[i]++;
+    }
+}
+
+void Queue::releaseTicket(const Node* node) {
+    for (int i = node->ticket + 1; i <= ticketCapacity; i += i & -i) {
+        ticketTree[i]--;
+    }
+}
+
+// Discharged patients leave empty slots at the front, compact the live ones into a fresh tree
+void Queue::renumberTickets() {
+    int newCapacity = INITIAL_TICKET_CAPACITY;
+    while (newCapacity < (queueLength + 1) * 2) {
+        newCapacity *= 2;
+    }
+
+    delete[] ticketTree;
+    ticketCapacity = newCapacity;
+    ticketTree = new int[ticketCapacity + 1]();
+    nextTicket = 0;
+
+    for (Node* temp = front; temp != nullptr; temp = temp->next) {
+        temp->ticket = nextTicket++;
+        for (int i = temp->ticket + 1; i <= ticketCapacity; i += i & -i) {
+            ticketTree[i]++;
+        }
+    }
+}
+
+int Queue::countTicketsUpTo(int ticket) const {
+    int total = 0;
+    for (int i = ticket + 1; i > 0; i -= i & -i) {
+        total += ticketTree[i];
+    }
+    return total;
+}
+
+void Queue::link(Node* newNode) {
+    addTicket(newNode); // Before linking, a renumber only walks the nodes already queued
+
+    newNode->prev = rear;
+    if (isEmpty()) {
+        front = rear = newNode;
+    }
+    else {
+        rear->next = newNode;
+        rear = newNode;
+    }
+    queueLength++;
+
+    QueueIndexEntry& entry = index.getOrInsert(newNode->patient_id);
+    if (entry.count == 0) {
+        entry.node = newNode;
+    }
+    entry.count++;
 }
 
 bool Queue::isEmpty() const {
@@ -37,7 +112,7 @@ std::string Queue::getRearPatientID() const {
 }
 
 bool Queue::enqueue(const std::string Patient_id, std::string Condition) {
-    const auto newNode = new Node();
+    Node* newNode = nodePool.acquire();
 
     newNode->patient_id = Patient_id;
     newNode->condition = Condition;
@@ -49,19 +124,12 @@ bool Queue::enqueue(const std::string Patient_id, std::string Condition) {
     const std::time_t formatted_admission_time = std::chrono::system_clock::to_time_t(admission_time_in_seconds);
     newNode->admission = getCurrentTimeString(formatted_admission_time);
 
-    if (isEmpty()) {
-        front = rear = newNode;
-    }
-    else {
-        rear->next = newNode;
-        rear = newNode;
-    }
-    queueLength++;
+    link(newNode);
     return true;
 }
 
 bool Queue::enqueue(const std::string Patient_id, std::string Condition, std::string Admission) {
-    Node* newNode = new Node();
+    Node* newNode = nodePool.acquire();
 
     newNode->patient_id = Patient_id;
     newNode->condition = Condition;
@@ -70,15 +138,43 @@ bool Queue::enqueue(const std::string Patient_id, std::string Condition, std::st
     newNode->next = nullptr;
     newNode->admission = Admission;
 
-    if (isEmpty()) {
-        front = rear = newNode;
+    link(newNode);
+    return true;
+}
+
+// Detaches a node from anywhere in the queue, fixes the index and recycles it
+void Queue::unlink(Node* removed) {
+    if (removed->prev != nullptr) {
+        removed->prev->next = removed->next;
     }
     else {
-        rear->next = newNode;
-        rear = newNode;
+        front = removed->next;
     }
-    queueLength++;
-    return true;
+    if (removed->next != nullptr) {
+        removed->next->prev = removed->prev;
+    }
+    else {
+        rear = removed->prev;
+    }
+    queueLength--;
+    releaseTicket(removed);
+
+    QueueIndexEntry* entry = index.find(removed->patient_id);
+    if (entry != nullptr) {
+        entry->count--;
+        if (entry->count == 0) {
+            index.erase(removed->patient_id);
+        }
+        else if (entry->node == removed) {
+            // Same patient queued again further back, point at the next occurrence
+            Node* temp = removed->next;
+            while (temp != nullptr && temp->patient_id != removed->patient_id) {
+                temp = temp->next;
+            }
+            entry->node = temp;
+        }
+    }
+    nodePool.release(removed);
 }
 
 bool Queue::dequeue() {
@@ -86,37 +182,38 @@ bool Queue::dequeue() {
         MessageHandler::info("Cannot dequeue. Queue is empty.");
         return false;
     }
-    front = front->next;
-    if(front == nullptr) {
-        rear = nullptr;
+    unlink(front);
+    return true;
+}
+
+// Removes a patient wherever they are in the queue (transfers, walk-outs)
+bool Queue::remove(const std::string& ID) {
+    QueueIndexEntry* entry = index.find(ID);
+    if (entry == nullptr) {
+        return false;
     }
-    queueLength--;
+    unlink(entry->node);
     return true;
 }
 
-bool Queue::inQueue(std::string ID) {
-    const Node* temp = front;
-    for (int i = 1; i <= getLength(); i++) {
-        if (temp->patient_id == ID) {
-            // delete temp;
-            return true;
-        }
-        temp = temp->next;
+bool Queue::updateCondition(const std::string& ID, const std::string& condition) {
+    QueueIndexEntry* entry = index.find(ID);
+    if (entry == nullptr) {
+        return false;
     }
-    // delete temp;
-    return false;
+    entry->node->condition = condition;
+    return true;
+}
+
+bool Queue::inQueue(std::string ID) {
+    return index.contains(ID);
 }
 
 int Queue::getPatientQueueNumber(std::string ID) {
-    Node* temp = front;
-    for (int i = 1; i <= getLength(); i++) {
-        if (temp->patient_id == ID) {
-            // delete temp;
-            return i;
-        }
-        temp = temp->next;
+    const QueueIndexEntry* entry = index.find(ID);
+    if (entry == nullptr) {
+        MessageHandler::info("Patient not found in queue.");
+        return -1;
     }
-    // delete temp;
-    MessageHandler::info("Patient not found in queue.");
-    return -1;
+    return countTicketsUpTo(entry->node->ticket);
 }
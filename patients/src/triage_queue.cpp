@@ -0,0 +1,231 @@
+#include "triage_queue.hpp"
+#include "string_utils.hpp"
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#define TRIAGE_CRITICAL_POINTS 7
+#define TRIAGE_SERIOUS_POINTS 4
+
+// Lowercase fragments matched anywhere in the condition
+static const char* const CRITICAL_CONDITIONS[] = {
+    "chest pain", "heart attack", "cardiac", "stroke", "unconscious", "seizure", "bleeding",
+    "breath", "anaphyla", "overdose", "sepsis", "trauma", "ebola"
+};
+static const char* const SERIOUS_CONDITIONS[] = {
+    "fracture", "burn", "allergic", "pneumonia", "asthma", "pancreatitis", "appendic", "poison",
+    "head injury", "dehydration"
+};
+
+TriageQueue::TriageQueue() : count(0), capacity(16), nextSequence(0) {
+    heap = new TriageEntry[capacity];
+}
+
+TriageQueue::~TriageQueue() {
+    delete[] heap;
+}
+
+bool TriageQueue::isEmpty() const {
+    return count == 0;
+}
+
+int TriageQueue::getLength() const {
+    return count;
+}
+
+bool TriageQueue::contains(const std::string& patientID) const {
+    return slots.contains(patientID);
+}
+
+bool TriageQueue::before(const TriageEntry& a, const TriageEntry& b) const {
+    if (a.key != b.key) return a.key < b.key;
+    return a.sequence < b.sequence;
+}
+
+void TriageQueue::place(int slot, const TriageEntry& entry) {
+    heap[slot] = entry;
+    slots.insertOrAssign(entry.patient_id, slot);
+}
+
+// Moves the entry at slot towards the root while it beats its parent, returns where it stopped
+int TriageQueue::siftUp(int slot) {
+    const TriageEntry entry = heap[slot];
+    while (slot > 0) {
+        const int parent = (slot - 1) / TRIAGE_HEAP_ARITY;
+        if (!before(entry, heap[parent])) break;
+        place(slot, heap[parent]);
+        slot = parent;
+    }
+    place(slot, entry);
+    return slot;
+}
+
+// Moves the entry at slot towards the leaves while a child beats it, returns where it stopped
+int TriageQueue::siftDown(int slot) {
+    const TriageEntry entry = heap[slot];
+    while (true) {
+        const int firstChild = slot * TRIAGE_HEAP_ARITY + 1;
+        if (firstChild >= count) break;
+        int best = firstChild;
+        const int lastChild = firstChild + TRIAGE_HEAP_ARITY < count ? firstChild + TRIAGE_HEAP_ARITY : count;
+        for (int child = firstChild + 1; child < lastChild; child++) {
+            if (before(heap[child], heap[best])) best = child;
+        }
+        if (!before(heap[best], entry)) break;
+        place(slot, heap[best]);
+        slot = best;
+    }
+    place(slot, entry);
+    return slot;
+}
+
+void TriageQueue::removeAt(int slot) {
+    slots.erase(heap[slot].patient_id);
+    count--;
+    if (slot == count) return;
+
+    // The last entry fills the hole and moves whichever way its key requires
+    place(slot, heap[count]);
+    if (siftUp(slot) == slot) siftDown(slot);
+}
+
+bool TriageQueue::push(const Patient& patient, const std::string& admission) {
+    if (slots.contains(patient.patient_id)) return false;
+
+    if (count == capacity) {
+        TriageEntry* grown = new TriageEntry[capacity * 2];
+        for (int i = 0; i < count; i++) grown[i] = heap[i];
+        delete[] heap;
+        heap = grown;
+        capacity *= 2;
+    }
+
+    TriageEntry entry;
+    entry.patient_id = patient.patient_id;
+    entry.condition = patient.condition;
+    entry.admission = admission;
+    entry.score = score(patient);
+    entry.admitted = parseAdmission(admission);
+    if (entry.admitted < 0) entry.admitted = static_cast<long long>(std::time(nullptr));
+    entry.sequence = nextSequence++;
+    entry.key = entry.admitted - static_cast<long long>(entry.score) * TRIAGE_MINUTES_PER_POINT * 60;
+
+    place(count, entry);
+    count++;
+    siftUp(count - 1);
+    return true;
+}
+
+const TriageEntry* TriageQueue::peek() const {
+    return count > 0 ? &heap[0] : nullptr;
+}
+
+bool TriageQueue::pop(TriageEntry& out) {
+    if (count == 0) return false;
+    out = heap[0];
+    removeAt(0);
+    return true;
+}
+
+bool TriageQueue::remove(const std::string& patientID) {
+    const int* slot = slots.find(patientID);
+    if (slot == nullptr) return false;
+    removeAt(*slot);
+    return true;
+}
+
+bool TriageQueue::retriage(const Patient& patient) {
+    const int* found = slots.find(patient.patient_id);
+    if (found == nullptr) return false;
+
+    const int slot = *found;
+    TriageEntry &entry = heap[slot];
+    entry.condition = patient.condition;
+    entry.score = score(patient);
+    entry.key = entry.admitted - static_cast<long long>(entry.score) * TRIAGE_MINUTES_PER_POINT * 60;
+    if (siftUp(slot) == slot) siftDown(slot);
+    return true;
+}
+
+int TriageQueue::listInOrder(TriageEntry* out, int maxEntries) const {
+    if (count == 0 || maxEntries <= 0) return 0;
+
+    // Bottom-up merge sort of a copy, the heap itself is left as it is
+    TriageEntry* items = new TriageEntry[count];
+    TriageEntry* temp = new TriageEntry[count];
+    for (int i = 0; i < count; i++) items[i] = heap[i];
+    for (int runLength = 1; runLength < count; runLength *= 2) {
+        for (int left = 0; left < count - runLength; left += 2 * runLength) {
+            const int middle = left + runLength;
+            const int right = middle + runLength < count ? middle + runLength : count;
+            int i = left, j = middle, k = left;
+            while (i < middle && j < right) {
+                temp[k++] = before(items[j], items[i]) ? items[j++] : items[i++];
+            }
+            while (i < middle) temp[k++] = items[i++];
+            while (j < right) temp[k++] = items[j++];
+            for (k = left; k < right; k++) items[k] = temp[k];
+        }
+    }
+
+    const int copied = count < maxEntries ? count : maxEntries;
+    for (int i = 0; i < copied; i++) out[i] = items[i];
+    delete[] items;
+    delete[] temp;
+    return copied;
+}
+
+double TriageQueue::urgency(const TriageEntry& entry, long long now) {
+    const double waited = now > entry.admitted ? static_cast<double>(now - entry.admitted) / 60.0 : 0.0;
+    return entry.score + waited / TRIAGE_MINUTES_PER_POINT;
+}
+
+// Reads a leading number, false for blank or non-numeric text
+static bool readNumber(const std::string& text, double& value) {
+    const std::string clean = trim(text);
+    if (clean.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(clean.c_str(), &end);
+    return end != clean.c_str();
+}
+
+int TriageQueue::score(const Patient& patient) {
+    int points = 0;
+    double value;
+
+    if (readNumber(patient.heartRate, value)) {
+        if (value < 40 || value > 130) points += 3;
+        else if (value < 50 || value > 110) points += 2;
+        else if (value > 100) points += 1;
+    }
+    if (readNumber(patient.temperature, value)) {
+        if (value >= 40 || value < 35) points += 3;
+        else if (value >= 39) points += 2;
+        else if (value >= 38) points += 1;
+    }
+    if (readNumber(patient.bloodPressure, value)) { // Systolic, the part before '/'
+        if (value < 90 || value >= 180) points += 3;
+        else if (value >= 160) points += 2;
+        else if (value >= 140) points += 1;
+    }
+
+    const std::string condition = toLower(patient.condition);
+    for (const char* fragment : CRITICAL_CONDITIONS) {
+        if (condition.find(fragment) != std::string::npos) return points + TRIAGE_CRITICAL_POINTS;
+    }
+    for (const char* fragment : SERIOUS_CONDITIONS) {
+        if (condition.find(fragment) != std::string::npos) return points + TRIAGE_SERIOUS_POINTS;
+    }
+    return points;
+}
+
+long long TriageQueue::parseAdmission(const std::string& admission) {
+    std::tm tm = {};
+    std::istringstream ss(trim(admission));
+    ss >> std::get_time(&tm, "%a %b %d %H:%M:%S %Y");
+    if (ss.fail()) return -1;
+    tm.tm_isdst = -1;
+    const std::time_t t = std::mktime(&tm);
+    return t == static_cast<std::time_t>(-1) ? -1 : static_cast<long long>(t);
+}
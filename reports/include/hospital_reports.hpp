@@ -0,0 +1,57 @@
+#ifndef HOSPITAL_REPORTS_HPP
+#define HOSPITAL_REPORTS_HPP
+
+#include <string>
+
+#define REPORT_TOP_ROWS 20 // Rows listed by the "all patients" history summary
+
+/**
+ * @brief Built-in cross-dataset reports over the CSV files in the data root
+ *
+ * @details
+ * - Each report builds hash tables (JoinTable) over the smaller datasets, streams the larger
+ *   one past them once and groups the joined rows (GroupAggregate)
+ * - Every file a report needs is read exactly once, nothing stays in memory after it prints
+ * - Reports read the files, callers save pending changes first to include them
+ *
+ * @usage
+ *      HospitalReports reports;
+ *      reports.supplyConsumptionByEmergencyType();
+ *      reports.caseSuppliesForType("CARDIAC ARREST");
+ */
+class HospitalReports {
+private:
+    std::string casesFile;      /// emergency_cases.csv
+    std::string usageFile;      /// supply_usage_log.csv
+    std::string patientsFile;   /// patient_data.csv
+    std::string ambulancesFile; /// ambulance_schedule.csv
+
+public:
+    HospitalReports();
+
+    /**
+     * @brief Units of every supply used per emergency type
+     * @details Build: cases by Case_ID. Probe: supply usage log. Group: type, then type and supply
+     */
+    void supplyConsumptionByEmergencyType();
+
+    /**
+     * @brief Every case of one emergency type with the ambulance that handled it and the supplies it used
+     * @details Build: supply usage by Case_ID, ambulances by Ambulance_ID. Probe: cases
+     */
+    void caseSuppliesForType(const std::string& emergencyType);
+
+    /**
+     * @brief Cases of one patient, or the patients with the most cases if patientId is empty
+     * @details Build: patients by Patient_ID, supply units grouped by Case_ID. Probe: cases
+     */
+    void patientCaseHistory(const std::string& patientId);
+
+    /**
+     * @brief Cases, completions and average response time per ambulance
+     * @details Build: ambulances by Ambulance_ID. Probe: cases. Group: Ambulance_ID
+     */
+    void ambulanceCaseLoad();
+};
+
+#endif // HOSPITAL_REPORTS_HPP
@@ -0,0 +1,192 @@
+#ifndef REPORT_ENGINE_HPP
+#define REPORT_ENGINE_HPP
+
+#include <fstream>
+#include <string>
+#include "hash_map.hpp"
+
+#define CSV_MAX_COLUMNS 32 // Extra fields on a row are ignored
+
+/**
+ * @brief Streams a CSV dataset one row at a time, columns are looked up by header name
+ *
+ * @details
+ * - One pass, one row in memory. The field strings are reused from row to row so a scan does
+ *   not allocate once their capacity has settled
+ * - Fields are trimmed, blank lines are skipped
+ *
+ * @usage
+ *      CsvScanner cases(getDataFilePath("emergency_cases.csv"));
+ *      const int type = cases.column("Emergency_Type");
+ *      while (cases.next()) { use(cases.field(type)); }
+ */
+class CsvScanner {
+private:
+    std::ifstream file;
+    std::string line;
+    std::string header[CSV_MAX_COLUMNS];
+    int headerCount;
+    std::string fields[CSV_MAX_COLUMNS];
+    int fieldCount;
+    std::string empty;
+
+    int split();
+
+public:
+    explicit CsvScanner(const std::string& path);
+
+    bool isOpen() const { return file.is_open(); }
+
+    /**
+     * @brief Index of a header column, -1 if the file has no such column
+     */
+    int column(const std::string& name) const;
+
+    /**
+     * @brief Reads the next non-blank row
+     * @return false at the end of the file
+     */
+    bool next();
+
+    /**
+     * @brief A field of the current row, empty if the row is shorter or column is -1
+     */
+    const std::string& field(int column) const;
+};
+
+/**
+ * @brief Build side of a hash join: rows of one dataset indexed by a key column
+ *
+ * @details
+ * - Each row keeps a fixed number of payload columns copied from the build dataset
+ * - Several rows may share a key (a case with many supply usages), they are chained in
+ *   insertion order and probed with find() / nextMatch()
+ * - The probe side is never stored, it is streamed row by row against the table
+ *
+ * @usage
+ *      JoinTable usage(2);                                          // Supply name, quantity
+ *      const std::string payload[2] = {name, quantity};
+ *      usage.insert(caseId, payload);
+ *      for (int row = usage.find(caseId); row != -1; row = usage.nextMatch(row)) { usage.get(row, 0); }
+ */
+class JoinTable {
+private:
+    struct Chain {
+        int first = -1;
+        int last = -1;
+    };
+
+    int width;
+    StringHashMap<Chain> chains;
+    std::string* keys;
+    std::string* payload;   /// width values per row
+    int* nextRow;           /// Next row with the same key, -1 at the end of a chain
+    int rowCount;
+    int capacity;
+
+    void grow();
+
+public:
+    explicit JoinTable(int payloadWidth);
+    ~JoinTable();
+
+    JoinTable(const JoinTable&) = delete;
+    JoinTable& operator=(const JoinTable&) = delete;
+
+    /**
+     * @brief Appends a row, values must hold the table's payload width
+     */
+    void insert(const std::string& key, const std::string* values);
+
+    /**
+     * @brief Loads a whole dataset in one pass
+     * @param keyColumn Column of scanner holding the join key, rows with an empty key are skipped
+     * @param payloadColumns The table's payload width worth of scanner columns (-1 stores an empty value)
+     * @return Number of rows loaded
+     */
+    int build(CsvScanner& scanner, int keyColumn, const int* payloadColumns);
+
+    /**
+     * @brief First row with this key, -1 if none
+     */
+    int find(const std::string& key) const;
+
+    int nextMatch(int row) const { return nextRow[row]; }
+    const std::string& getKey(int row) const { return keys[row]; }
+    const std::string& get(int row, int column) const { return payload[row * width + column]; }
+    int getRowCount() const { return rowCount; }
+};
+
+/**
+ * @struct GroupTotals
+ * @brief Running aggregates of one group
+ */
+struct GroupTotals {
+    long long rows = 0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @brief Grouped aggregation (GROUP BY key: COUNT, SUM, MIN, MAX) over a streamed dataset
+ *
+ * @details
+ * - Groups are kept in first-seen order, sortByKey() and sortBySumDescending() reorder them
+ *   with a merge sort for listing
+ * - A group made of several columns uses compositeKey()
+ *
+ * @usage
+ *      GroupAggregate perType;
+ *      perType.add(type, quantity);
+ *      perType.sortBySumDescending();
+ *      for (int i = 0; i < perType.getCount(); i++) { perType.getKey(i); perType.getTotals(i).sum; }
+ */
+class GroupAggregate {
+private:
+    StringHashMap<int> groupByKey;
+    std::string* keys;
+    GroupTotals* totals;
+    int count;
+    int capacity;
+
+    void grow();
+    template <typename Less>
+    void sortBy(Less less);
+
+public:
+    GroupAggregate();
+    ~GroupAggregate();
+
+    GroupAggregate(const GroupAggregate&) = delete;
+    GroupAggregate& operator=(const GroupAggregate&) = delete;
+
+    /**
+     * @brief Adds one value to its group, creating the group on first sight
+     */
+    GroupTotals& add(const std::string& key, double value);
+
+    /**
+     * @brief Totals of a group, nullptr if nothing was added to it
+     */
+    const GroupTotals* find(const std::string& key) const;
+
+    void sortByKey();
+    void sortBySumDescending();
+
+    int getCount() const { return count; }
+    const std::string& getKey(int index) const { return keys[index]; }
+    const GroupTotals& getTotals(int index) const { return totals[index]; }
+
+    /**
+     * @brief Joins two columns into one group key, the separator sorts before any printable character
+     */
+    static std::string compositeKey(const std::string& first, const std::string& second);
+
+    /**
+     * @brief Splits a key built by compositeKey()
+     */
+    static void splitKey(const std::string& key, std::string& first, std::string& second);
+};
+
+#endif // REPORT_ENGINE_HPP
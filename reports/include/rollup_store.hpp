@@ -0,0 +1,114 @@
+#ifndef ROLLUP_STORE_HPP
+#define ROLLUP_STORE_HPP
+
+#include <mutex>
+#include <string>
+#include "hash_map.hpp"
+#include "report_engine.hpp"
+
+#define ROLLUP_FILE "rollups.csv"
+#define ROLLUP_COMPACT_SLACK 256 // Journal rows tolerated beyond twice the cell count before a rewrite
+
+// Views, each keyed by (time bucket, dimension)
+#define ROLLUP_CASE_ARRIVALS "case_arrivals_hourly"    // "YYYY-MM-DD HH", emergency type, cases logged
+#define ROLLUP_SUPPLY_BURN "supply_burn_daily"         // "YYYY-MM-DD", supply name, units used on cases
+#define ROLLUP_SUPPLY_DEDUCTED "supply_deducted_daily" // "YYYY-MM-DD", supply name, units deducted from stock
+#define ROLLUP_QUEUE_DAILY "queue_daily"               // "YYYY-MM-DD", ROLLUP_ADMITTED or ROLLUP_DISCHARGED
+#define ROLLUP_ADMITTED "Admitted"
+#define ROLLUP_DISCHARGED "Discharged"
+
+/**
+ * @brief Materialized time-bucketed rollups, maintained as the datasets change
+ *
+ * @details
+ * - Every mutation that feeds a view calls add() with its bucket, dimension and delta: case
+ *   intake and edits, supply usage logging, stock deduction, queue admissions and discharges
+ * - rollups.csv in the data root is a journal of deltas (View,Bucket,Dimension,Delta), each
+ *   add() appends one fsynced row. Startup sums the journal instead of rescanning the datasets,
+ *   and rewrites it compacted once it holds many more rows than cells
+ * - Without a journal, the views are backfilled once from the datasets. Supply rows carry no
+ *   time of their own, the backfill dates them by their case's processing time
+ * - The backfill must run before any dataset write, or that write is counted twice: once by
+ *   the backfill reading it and once by its own add(). main() calls load() at startup
+ * - All calls are serialized by a mutex
+ *
+ * @usage
+ *      RollupStore::instance().add(ROLLUP_QUEUE_DAILY, RollupStore::todayBucket(), ROLLUP_ADMITTED, 1);
+ *      RollupStore::instance().printView(ROLLUP_QUEUE_DAILY, "2025-11-01", "2025-12-01", "Day", "Patients");
+ */
+class RollupStore {
+private:
+    StringHashMap<double> cells; /// view + bucket + dimension -> running total
+    long long journalRows;
+    std::mutex mutex;
+    std::string path;
+    bool loaded;
+
+    RollupStore();
+
+    void loadLocked();
+    void backfillLocked();
+    bool compactLocked();
+    void addLocked(const std::string& view, const std::string& bucket, const std::string& dimension, double delta);
+
+    static std::string cellKey(const std::string& view, const std::string& bucket, const std::string& dimension);
+
+public:
+    RollupStore(const RollupStore&) = delete;
+    RollupStore& operator=(const RollupStore&) = delete;
+
+    static RollupStore& instance();
+
+    /**
+     * @brief Sums the journal, or backfills it from the datasets, if not done yet
+     */
+    void load();
+
+    /**
+     * @brief Adds delta to one cell and journals it, an empty bucket is ignored
+     */
+    void add(const std::string& view, const std::string& bucket, const std::string& dimension, double delta);
+
+    /**
+     * @brief Current total of one cell, 0 if it was never touched
+     */
+    double get(const std::string& view, const std::string& bucket, const std::string& dimension);
+
+    /**
+     * @brief Calls visit(bucket, dimension, value) for every non-zero cell of a view, in no particular order
+     */
+    template <typename Visitor>
+    void forEachCell(const std::string& view, Visitor visit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        loadLocked();
+        std::string cellView, rest, bucket, dimension;
+        cells.forEach([&](const std::string& key, double value) {
+            if (value == 0) return;
+            GroupAggregate::splitKey(key, cellView, rest);
+            if (cellView != view) return;
+            GroupAggregate::splitKey(rest, bucket, dimension);
+            visit(bucket, dimension, value);
+        });
+    }
+
+    /**
+     * @brief Prints the cells of a view with from <= bucket < to, by bucket then dimension
+     * @return Number of rows printed
+     */
+    int printView(const std::string& view, const std::string& from, const std::string& to,
+                  const std::string& bucketTitle, const std::string& valueTitle);
+
+    /**
+     * @brief "YYYY-MM-DD HH" of a "YYYY-MM-DD HH:MM[:SS]" timestamp, empty if malformed
+     */
+    static std::string hourBucket(const std::string& timestamp);
+
+    /**
+     * @brief "YYYY-MM-DD" of a timestamp, empty if malformed
+     */
+    static std::string dayBucket(const std::string& timestamp);
+
+    static std::string todayBucket();
+};
+
+#endif // ROLLUP_STORE_HPP
@@ -0,0 +1,294 @@
+#include "hospital_reports.hpp"
+#include "report_engine.hpp"
+#include "message_handler.hpp"
+#include "path_utils.hpp"
+#include "string_utils.hpp"
+#include "time_utils.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    // Quantities in the logs are integers, a malformed one counts as zero instead of aborting the scan
+    double toNumber(const std::string& text) {
+        return text.empty() ? 0.0 : std::strtod(text.c_str(), nullptr);
+    }
+
+    // Opens a dataset and checks it has every column a report reads
+    bool openDataset(CsvScanner& scanner, const std::string& path, const char* const* columns, int* indexes, int columnCount) {
+        if (!scanner.isOpen()) {
+            MessageHandler::warning("Cannot open " + path + ".");
+            return false;
+        }
+        for (int i = 0; i < columnCount; i++) {
+            indexes[i] = scanner.column(columns[i]);
+            if (indexes[i] < 0) {
+                MessageHandler::warning(path + " has no " + columns[i] + " column.");
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+HospitalReports::HospitalReports() {
+    casesFile = getDataFilePath("emergency_cases.csv");
+    usageFile = getDataFilePath("supply_usage_log.csv");
+    patientsFile = getDataFilePath("patient_data.csv");
+    ambulancesFile = getDataFilePath("ambulance_schedule.csv");
+}
+
+void HospitalReports::supplyConsumptionByEmergencyType() {
+    // Build: Case_ID -> Emergency_Type
+    CsvScanner cases(casesFile);
+    const char* caseColumns[] = {"Case_ID", "Emergency_Type"};
+    int caseIndex[2];
+    if (!openDataset(cases, casesFile, caseColumns, caseIndex, 2)) return;
+    JoinTable caseTypes(1);
+    caseTypes.build(cases, caseIndex[0], &caseIndex[1]);
+
+    // Probe: every supply usage row, grouped by type and by type + supply
+    CsvScanner usage(usageFile);
+    const char* usageColumns[] = {"Case_ID", "Supply_Name", "Quantity_Used"};
+    int usageIndex[3];
+    if (!openDataset(usage, usageFile, usageColumns, usageIndex, 3)) return;
+
+    GroupAggregate perType;
+    GroupAggregate perTypeSupply;
+    while (usage.next()) {
+        const int row = caseTypes.find(usage.field(usageIndex[0]));
+        const std::string &type = row == -1 ? std::string("(unknown case)") : caseTypes.get(row, 0);
+        const double quantity = toNumber(usage.field(usageIndex[2]));
+        perType.add(type, quantity);
+        perTypeSupply.add(GroupAggregate::compositeKey(type, usage.field(usageIndex[1])), quantity);
+    }
+
+    if (perType.getCount() == 0) {
+        std::cout << "No supply usage recorded.\n";
+        return;
+    }
+
+    // Types by total units, each followed by its supplies by units
+    perType.sortBySumDescending();
+    perTypeSupply.sortBySumDescending();
+
+    std::cout << "\n=== Supply Consumption per Emergency Type ===\n";
+    std::cout << std::left << std::setw(32) << "Emergency Type / Supply" << std::setw(10) << "Units" << "Log Rows\n";
+    std::cout << std::string(52, '-') << "\n";
+    std::string type, supply;
+    for (int t = 0; t < perType.getCount(); t++) {
+        const GroupTotals &typeTotals = perType.getTotals(t);
+        std::cout << std::setw(32) << perType.getKey(t) << std::setw(10) << static_cast<long long>(typeTotals.sum)
+                  << typeTotals.rows << "\n";
+
+        for (int s = 0; s < perTypeSupply.getCount(); s++) {
+            GroupAggregate::splitKey(perTypeSupply.getKey(s), type, supply);
+            if (type != perType.getKey(t)) continue;
+            const GroupTotals &supplyTotals = perTypeSupply.getTotals(s);
+            std::cout << "  " << std::setw(30) << supply << std::setw(10) << static_cast<long long>(supplyTotals.sum)
+                      << supplyTotals.rows << "\n";
+        }
+    }
+}
+
+void HospitalReports::caseSuppliesForType(const std::string& emergencyType) {
+    const std::string wanted = toUpper(emergencyType);
+
+    // Build: Case_ID -> supply name, quantity (many per case)
+    CsvScanner usage(usageFile);
+    const char* usageColumns[] = {"Case_ID", "Supply_Name", "Quantity_Used"};
+    int usageIndex[3];
+    if (!openDataset(usage, usageFile, usageColumns, usageIndex, 3)) return;
+    JoinTable supplies(2);
+    supplies.build(usage, usageIndex[0], &usageIndex[1]);
+
+    // Build: Ambulance_ID -> driver
+    CsvScanner ambulances(ambulancesFile);
+    const char* ambulanceColumns[] = {"Ambulance_ID", "Driver_Name"};
+    int ambulanceIndex[2];
+    JoinTable drivers(1);
+    if (openDataset(ambulances, ambulancesFile, ambulanceColumns, ambulanceIndex, 2)) {
+        drivers.build(ambulances, ambulanceIndex[0], &ambulanceIndex[1]);
+    }
+
+    // Probe: the cases of the requested type
+    CsvScanner cases(casesFile);
+    const char* caseColumns[] = {"Case_ID", "Patient_ID", "Emergency_Type", "Status", "Ambulance_ID"};
+    int caseIndex[5];
+    if (!openDataset(cases, casesFile, caseColumns, caseIndex, 5)) return;
+
+    std::cout << "\n=== " << wanted << " Cases ===\n";
+    int found = 0;
+    long long totalUnits = 0;
+    while (cases.next()) {
+        if (toUpper(cases.field(caseIndex[2])) != wanted) continue;
+        found++;
+
+        const std::string &caseId = cases.field(caseIndex[0]);
+        const std::string &ambulanceId = cases.field(caseIndex[4]);
+        std::cout << caseId << " | " << cases.field(caseIndex[1]) << " | " << cases.field(caseIndex[3]) << " | ";
+        if (ambulanceId.empty()) {
+            std::cout << "No ambulance";
+        } else {
+            const int driver = drivers.find(ambulanceId);
+            std::cout << ambulanceId << " (" << (driver == -1 ? std::string("not in schedule") : drivers.get(driver, 0)) << ")";
+        }
+        std::cout << "\n";
+
+        int row = supplies.find(caseId);
+        if (row == -1) {
+            std::cout << "    No supplies logged\n";
+        }
+        for (; row != -1; row = supplies.nextMatch(row)) {
+            const long long units = static_cast<long long>(toNumber(supplies.get(row, 1)));
+            totalUnits += units;
+            std::cout << "    " << std::left << std::setw(30) << supplies.get(row, 0) << units << "\n";
+        }
+    }
+
+    if (found == 0) {
+        std::cout << "No cases of type " << wanted << ".\n";
+        return;
+    }
+    std::cout << found << " case(s), " << totalUnits << " supply unit(s) used.\n";
+}
+
+void HospitalReports::patientCaseHistory(const std::string& patientId) {
+    // Build: Patient_ID -> name
+    CsvScanner patients(patientsFile);
+    const char* patientColumns[] = {"Patient_ID", "Name"};
+    int patientIndex[2];
+    if (!openDataset(patients, patientsFile, patientColumns, patientIndex, 2)) return;
+    JoinTable names(1);
+    names.build(patients, patientIndex[0], &patientIndex[1]);
+
+    // Build: supply units grouped by Case_ID
+    GroupAggregate unitsPerCase;
+    CsvScanner usage(usageFile);
+    const char* usageColumns[] = {"Case_ID", "Quantity_Used"};
+    int usageIndex[2];
+    if (openDataset(usage, usageFile, usageColumns, usageIndex, 2)) {
+        while (usage.next()) {
+            unitsPerCase.add(usage.field(usageIndex[0]), toNumber(usage.field(usageIndex[1])));
+        }
+    }
+
+    // Probe: cases, one patient's rows or every patient grouped
+    CsvScanner cases(casesFile);
+    const char* caseColumns[] = {"Case_ID", "Patient_ID", "Emergency_Type", "Priority_Level", "Status", "Timestamp_Logged"};
+    int caseIndex[6];
+    if (!openDataset(cases, casesFile, caseColumns, caseIndex, 6)) return;
+
+    if (!patientId.empty()) {
+        const int patient = names.find(patientId);
+        std::cout << "\n=== Case History of " << patientId;
+        if (patient != -1) std::cout << " (" << names.get(patient, 0) << ")";
+        std::cout << " ===\n";
+        std::cout << std::left << std::setw(12) << "Case" << std::setw(28) << "Emergency Type" << std::setw(10) << "Priority"
+                  << std::setw(12) << "Status" << std::setw(22) << "Logged" << "Supply Units\n";
+        std::cout << std::string(96, '-') << "\n";
+
+        int found = 0;
+        while (cases.next()) {
+            if (cases.field(caseIndex[1]) != patientId) continue;
+            found++;
+            const GroupTotals* units = unitsPerCase.find(cases.field(caseIndex[0]));
+            std::cout << std::setw(12) << cases.field(caseIndex[0]) << std::setw(28) << cases.field(caseIndex[2])
+                      << std::setw(10) << cases.field(caseIndex[3]) << std::setw(12) << cases.field(caseIndex[4])
+                      << std::setw(22) << cases.field(caseIndex[5]) << (units ? static_cast<long long>(units->sum) : 0) << "\n";
+        }
+        if (found == 0) std::cout << "No cases for " << patientId << ".\n";
+        return;
+    }
+
+    GroupAggregate casesPerPatient;
+    GroupAggregate unitsPerPatient;
+    while (cases.next()) {
+        const std::string &patient = cases.field(caseIndex[1]);
+        const GroupTotals* units = unitsPerCase.find(cases.field(caseIndex[0]));
+        casesPerPatient.add(patient, 1.0);
+        unitsPerPatient.add(patient, units ? units->sum : 0.0);
+    }
+    if (casesPerPatient.getCount() == 0) {
+        std::cout << "No cases recorded.\n";
+        return;
+    }
+    casesPerPatient.sortBySumDescending();
+
+    const int shown = casesPerPatient.getCount() < REPORT_TOP_ROWS ? casesPerPatient.getCount() : REPORT_TOP_ROWS;
+    std::cout << "\n=== Patients with the Most Cases (top " << shown << " of " << casesPerPatient.getCount() << ") ===\n";
+    std::cout << std::left << std::setw(12) << "Patient" << std::setw(26) << "Name" << std::setw(8) << "Cases" << "Supply Units\n";
+    std::cout << std::string(58, '-') << "\n";
+    for (int i = 0; i < shown; i++) {
+        const std::string &patient = casesPerPatient.getKey(i);
+        const int name = names.find(patient);
+        std::cout << std::setw(12) << patient << std::setw(26) << (name == -1 ? std::string("-") : names.get(name, 0))
+                  << std::setw(8) << casesPerPatient.getTotals(i).rows
+                  << static_cast<long long>(unitsPerPatient.find(patient)->sum) << "\n";
+    }
+}
+
+void HospitalReports::ambulanceCaseLoad() {
+    // Build: Ambulance_ID -> driver, status
+    CsvScanner ambulances(ambulancesFile);
+    const char* ambulanceColumns[] = {"Ambulance_ID", "Driver_Name", "Ambulance_Status"};
+    int ambulanceIndex[3];
+    if (!openDataset(ambulances, ambulancesFile, ambulanceColumns, ambulanceIndex, 3)) return;
+    JoinTable fleet(2);
+    fleet.build(ambulances, ambulanceIndex[0], &ambulanceIndex[1]);
+
+    // Probe: cases with an ambulance, grouped by Ambulance_ID
+    CsvScanner cases(casesFile);
+    const char* caseColumns[] = {"Status", "Timestamp_Logged", "Timestamp_Processed", "Ambulance_ID"};
+    int caseIndex[4];
+    if (!openDataset(cases, casesFile, caseColumns, caseIndex, 4)) return;
+
+    GroupAggregate casesPerAmbulance;
+    GroupAggregate completedPerAmbulance;
+    GroupAggregate responseMinutes;
+    while (cases.next()) {
+        const std::string &ambulanceId = cases.field(caseIndex[3]);
+        if (ambulanceId.empty()) continue;
+
+        casesPerAmbulance.add(ambulanceId, 1.0);
+        if (cases.field(caseIndex[0]) == "Completed") completedPerAmbulance.add(ambulanceId, 1.0);
+
+        const long long logged = parseDatetime(cases.field(caseIndex[1]));
+        const long long processed = parseDatetime(cases.field(caseIndex[2]));
+        if (logged >= 0 && processed >= logged) {
+            responseMinutes.add(ambulanceId, static_cast<double>(processed - logged) / 60.0);
+        }
+    }
+
+    std::cout << "\n=== Case Load per Ambulance ===\n";
+    std::cout << std::left << std::setw(12) << "Ambulance" << std::setw(22) << "Driver" << std::setw(12) << "Status"
+              << std::setw(8) << "Cases" << std::setw(11) << "Completed" << std::setw(14) << "Avg Resp Min" << "Max Resp Min\n";
+    std::cout << std::string(91, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    // Every ambulance in the schedule, idle ones included, then IDs only the cases know about
+    auto printRow = [&](const std::string& ambulanceId, const std::string& driver, const std::string& status) {
+        const GroupTotals* total = casesPerAmbulance.find(ambulanceId);
+        const GroupTotals* completed = completedPerAmbulance.find(ambulanceId);
+        const GroupTotals* response = responseMinutes.find(ambulanceId);
+        std::cout << std::setw(12) << ambulanceId << std::setw(22) << driver << std::setw(12) << status
+                  << std::setw(8) << (total ? total->rows : 0) << std::setw(11) << (completed ? completed->rows : 0);
+        if (response) {
+            std::cout << std::setw(14) << response->sum / response->rows << response->max << "\n";
+        } else {
+            std::cout << std::setw(14) << "-" << "-\n";
+        }
+    };
+    for (int row = 0; row < fleet.getRowCount(); row++) {
+        if (fleet.find(fleet.getKey(row)) != row) continue; // A duplicated schedule row is listed once
+        printRow(fleet.getKey(row), fleet.get(row, 0), fleet.get(row, 1));
+    }
+    casesPerAmbulance.sortByKey();
+    for (int i = 0; i < casesPerAmbulance.getCount(); i++) {
+        if (fleet.find(casesPerAmbulance.getKey(i)) == -1) {
+            printRow(casesPerAmbulance.getKey(i), "(not in schedule)", "-");
+        }
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
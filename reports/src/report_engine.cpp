@@ -0,0 +1,265 @@
+#include "report_engine.hpp"
+
+#define GROUP_KEY_SEPARATOR '\x1f' // ASCII unit separator, never part of a CSV field
+
+namespace {
+    // Trims spaces, tabs and a trailing carriage return in place, keeping the string's capacity
+    void trimInPlace(std::string& text) {
+        std::string::size_type end = text.size();
+        while (end > 0 && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\r')) end--;
+        std::string::size_type start = 0;
+        while (start < end && (text[start] == ' ' || text[start] == '\t')) start++;
+        text.erase(end);
+        text.erase(0, start);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// CsvScanner
+// ---------------------------------------------------------------------------
+
+CsvScanner::CsvScanner(const std::string& path) : file(path), headerCount(0), fieldCount(0) {
+    if (!file.is_open() || !std::getline(file, line)) return;
+
+    headerCount = split();
+    for (int i = 0; i < headerCount; i++) {
+        header[i] = fields[i];
+    }
+    fieldCount = 0;
+}
+
+// Splits line into fields, returns how many were filled
+int CsvScanner::split() {
+    int filled = 0;
+    std::string::size_type start = 0;
+    while (filled < CSV_MAX_COLUMNS) {
+        const std::string::size_type comma = line.find(',', start);
+        const std::string::size_type end = comma == std::string::npos ? line.size() : comma;
+        fields[filled].assign(line, start, end - start);
+        trimInPlace(fields[filled]);
+        filled++;
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return filled;
+}
+
+int CsvScanner::column(const std::string& name) const {
+    for (int i = 0; i < headerCount; i++) {
+        if (header[i] == name) return i;
+    }
+    return -1;
+}
+
+bool CsvScanner::next() {
+    while (std::getline(file, line)) {
+        if (line.empty() || line == "\r") continue;
+        fieldCount = split();
+        return true;
+    }
+    fieldCount = 0;
+    return false;
+}
+
+const std::string& CsvScanner::field(int column) const {
+    if (column < 0 || column >= fieldCount) return empty;
+    return fields[column];
+}
+
+// ---------------------------------------------------------------------------
+// JoinTable
+// ---------------------------------------------------------------------------
+
+JoinTable::JoinTable(int payloadWidth)
+    : width(payloadWidth > 0 ? payloadWidth : 1), keys(nullptr), payload(nullptr), nextRow(nullptr),
+      rowCount(0), capacity(0) {}
+
+JoinTable::~JoinTable() {
+    delete[] keys;
+    delete[] payload;
+    delete[] nextRow;
+}
+
+void JoinTable::grow() {
+    const int newCapacity = capacity == 0 ? 64 : capacity * 2;
+    std::string* newKeys = new std::string[newCapacity];
+    std::string* newPayload = new std::string[static_cast<size_t>(newCapacity) * width];
+    int* newNext = new int[newCapacity];
+
+    for (int i = 0; i < rowCount; i++) {
+        newKeys[i].swap(keys[i]);
+        for (int c = 0; c < width; c++) {
+            newPayload[i * width + c].swap(payload[i * width + c]);
+        }
+        newNext[i] = nextRow[i];
+    }
+
+    delete[] keys;
+    delete[] payload;
+    delete[] nextRow;
+    keys = newKeys;
+    payload = newPayload;
+    nextRow = newNext;
+    capacity = newCapacity;
+}
+
+void JoinTable::insert(const std::string& key, const std::string* values) {
+    if (rowCount == capacity) grow();
+
+    const int row = rowCount++;
+    keys[row] = key;
+    for (int c = 0; c < width; c++) {
+        payload[row * width + c] = values[c];
+    }
+    nextRow[row] = -1;
+
+    Chain &chain = chains.getOrInsert(key);
+    if (chain.last == -1) {
+        chain.first = row;
+    } else {
+        nextRow[chain.last] = row;
+    }
+    chain.last = row;
+}
+
+int JoinTable::build(CsvScanner& scanner, int keyColumn, const int* payloadColumns) {
+    std::string* values = new std::string[width];
+    int loaded = 0;
+    while (scanner.next()) {
+        const std::string &key = scanner.field(keyColumn);
+        if (key.empty()) continue;
+        for (int c = 0; c < width; c++) {
+            values[c] = scanner.field(payloadColumns[c]);
+        }
+        insert(key, values);
+        loaded++;
+    }
+    delete[] values;
+    return loaded;
+}
+
+int JoinTable::find(const std::string& key) const {
+    const Chain* chain = chains.find(key);
+    return chain ? chain->first : -1;
+}
+
+// ---------------------------------------------------------------------------
+// GroupAggregate
+// ---------------------------------------------------------------------------
+
+GroupAggregate::GroupAggregate() : keys(nullptr), totals(nullptr), count(0), capacity(0) {}
+
+GroupAggregate::~GroupAggregate() {
+    delete[] keys;
+    delete[] totals;
+}
+
+void GroupAggregate::grow() {
+    const int newCapacity = capacity == 0 ? 32 : capacity * 2;
+    std::string* newKeys = new std::string[newCapacity];
+    GroupTotals* newTotals = new GroupTotals[newCapacity];
+    for (int i = 0; i < count; i++) {
+        newKeys[i].swap(keys[i]);
+        newTotals[i] = totals[i];
+    }
+    delete[] keys;
+    delete[] totals;
+    keys = newKeys;
+    totals = newTotals;
+    capacity = newCapacity;
+}
+
+GroupTotals& GroupAggregate::add(const std::string& key, double value) {
+    int* found = groupByKey.find(key);
+    int index;
+    if (found) {
+        index = *found;
+    } else {
+        if (count == capacity) grow();
+        index = count++;
+        keys[index] = key;
+        totals[index] = GroupTotals{};
+        totals[index].min = value;
+        totals[index].max = value;
+        groupByKey.insertOrAssign(key, index);
+    }
+
+    GroupTotals &group = totals[index];
+    group.rows++;
+    group.sum += value;
+    if (value < group.min) group.min = value;
+    if (value > group.max) group.max = value;
+    return group;
+}
+
+const GroupTotals* GroupAggregate::find(const std::string& key) const {
+    const int* index = groupByKey.find(key);
+    return index ? &totals[*index] : nullptr;
+}
+
+// Stable merge sort of the groups, then the key index is pointed at the new positions
+template <typename Less>
+void GroupAggregate::sortBy(Less less) {
+    if (count < 2) return;
+
+    int* order = new int[count];
+    int* scratch = new int[count];
+    for (int i = 0; i < count; i++) order[i] = i;
+
+    for (int runLength = 1; runLength < count; runLength *= 2) {
+        for (int left = 0; left < count - runLength; left += 2 * runLength) {
+            const int middle = left + runLength;
+            const int right = middle + runLength < count ? middle + runLength : count;
+            int i = left, j = middle, k = left;
+            while (i < middle && j < right) {
+                scratch[k++] = less(order[j], order[i]) ? order[j++] : order[i++];
+            }
+            while (i < middle) scratch[k++] = order[i++];
+            while (j < right) scratch[k++] = order[j++];
+            for (k = left; k < right; k++) order[k] = scratch[k];
+        }
+    }
+
+    std::string* sortedKeys = new std::string[capacity];
+    GroupTotals* sortedTotals = new GroupTotals[capacity];
+    for (int i = 0; i < count; i++) {
+        sortedKeys[i].swap(keys[order[i]]);
+        sortedTotals[i] = totals[order[i]];
+        groupByKey.insertOrAssign(sortedKeys[i], i);
+    }
+    delete[] keys;
+    delete[] totals;
+    keys = sortedKeys;
+    totals = sortedTotals;
+
+    delete[] order;
+    delete[] scratch;
+}
+
+void GroupAggregate::sortByKey() {
+    sortBy([this](int a, int b) { return keys[a] < keys[b]; });
+}
+
+void GroupAggregate::sortBySumDescending() {
+    sortBy([this](int a, int b) { return totals[a].sum > totals[b].sum; });
+}
+
+std::string GroupAggregate::compositeKey(const std::string& first, const std::string& second) {
+    std::string key;
+    key.reserve(first.size() + second.size() + 1);
+    key += first;
+    key += GROUP_KEY_SEPARATOR;
+    key += second;
+    return key;
+}
+
+void GroupAggregate::splitKey(const std::string& key, std::string& first, std::string& second) {
+    const std::string::size_type separator = key.find(GROUP_KEY_SEPARATOR);
+    if (separator == std::string::npos) {
+        first = key;
+        second.clear();
+        return;
+    }
+    first = key.substr(0, separator);
+    second = key.substr(separator + 1);
+}
@@ -0,0 +1,248 @@
+#include "rollup_store.hpp"
+#include "report_engine.hpp"
+#include "durable_writer.hpp"
+#include "message_handler.hpp"
+#include "path_utils.hpp"
+#include "time_utils.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Journal fields are comma separated, a stray comma or line break in a name must not split a row
+    std::string sanitize(const std::string& text) {
+        std::string clean = text;
+        for (char &c : clean) {
+            if (c == ',' || c == '\n' || c == '\r') c = ' ';
+        }
+        return clean;
+    }
+
+    // Queue times are written by ctime(): "Sun Nov 09 19:55:50 2025"
+    std::string ctimeDayBucket(const std::string& text) {
+        std::tm tm = {};
+        std::istringstream ss(text);
+        ss >> std::get_time(&tm, "%a %b %d %H:%M:%S %Y");
+        if (ss.fail()) return "";
+        char buffer[16];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", &tm);
+        return buffer;
+    }
+
+    std::string formatValue(double value) {
+        std::ostringstream oss;
+        oss << value;
+        return oss.str();
+    }
+}
+
+RollupStore::RollupStore() : journalRows(0), loaded(false) {}
+
+RollupStore& RollupStore::instance() {
+    static RollupStore store;
+    return store;
+}
+
+std::string RollupStore::cellKey(const std::string& view, const std::string& bucket, const std::string& dimension) {
+    return GroupAggregate::compositeKey(GroupAggregate::compositeKey(view, bucket), dimension);
+}
+
+std::string RollupStore::hourBucket(const std::string& timestamp) {
+    if (timestamp.size() < 13 || timestamp[4] != '-' || timestamp[7] != '-' || timestamp[10] != ' ') return "";
+    if (!std::isdigit(static_cast<unsigned char>(timestamp[11])) || !std::isdigit(static_cast<unsigned char>(timestamp[12]))) return "";
+    return timestamp.substr(0, 13);
+}
+
+std::string RollupStore::dayBucket(const std::string& timestamp) {
+    if (timestamp.size() < 10 || timestamp[4] != '-' || timestamp[7] != '-') return "";
+    return timestamp.substr(0, 10);
+}
+
+std::string RollupStore::todayBucket() {
+    return dayBucket(getCurrentTimestamp());
+}
+
+// Sums the journal on first use, or backfills the views when there is no journal yet
+void RollupStore::loadLocked() {
+    if (loaded) return;
+    loaded = true;
+    path = getDataFilePath(ROLLUP_FILE);
+    if (path.empty()) return;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        backfillLocked();
+        compactLocked();
+        return;
+    }
+
+    CsvScanner journal(path);
+    const int viewColumn = journal.column("View");
+    const int bucketColumn = journal.column("Bucket");
+    const int dimensionColumn = journal.column("Dimension");
+    const int deltaColumn = journal.column("Delta");
+    if (viewColumn < 0 || bucketColumn < 0 || dimensionColumn < 0 || deltaColumn < 0) {
+        MessageHandler::warning(path + " is not a rollup journal, the rollups start empty.");
+        return;
+    }
+    while (journal.next()) {
+        const std::string &delta = journal.field(deltaColumn);
+        if (journal.field(bucketColumn).empty() || delta.empty()) continue; // Torn last line
+        cells.getOrInsert(cellKey(journal.field(viewColumn), journal.field(bucketColumn), journal.field(dimensionColumn)))
+            += std::strtod(delta.c_str(), nullptr);
+        journalRows++;
+    }
+
+    if (journalRows > 2LL * cells.getSize() + ROLLUP_COMPACT_SLACK) {
+        compactLocked();
+    }
+}
+
+// One pass over each dataset, only when no journal exists
+void RollupStore::backfillLocked() {
+    const std::string casesFile = getDataFilePath("emergency_cases.csv");
+    const std::string usageFile = getDataFilePath("supply_usage_log.csv");
+    const std::string queueFile = getDataFilePath("queue.csv");
+
+    // Cases: arrivals per hour and type, and each case's day for the supply rows below
+    JoinTable caseDays(1);
+    CsvScanner cases(casesFile);
+    const int caseId = cases.column("Case_ID");
+    const int caseType = cases.column("Emergency_Type");
+    const int caseLogged = cases.column("Timestamp_Logged");
+    const int caseProcessed = cases.column("Timestamp_Processed");
+    if (caseId >= 0 && caseType >= 0 && caseLogged >= 0) {
+        while (cases.next()) {
+            addLocked(ROLLUP_CASE_ARRIVALS, hourBucket(cases.field(caseLogged)), cases.field(caseType), 1);
+
+            std::string day = dayBucket(cases.field(caseProcessed));
+            if (day.empty()) day = dayBucket(cases.field(caseLogged));
+            if (!day.empty() && !cases.field(caseId).empty()) caseDays.insert(cases.field(caseId), &day);
+        }
+    }
+
+    // Supply usage: burn for every row, deductions for rows already deducted
+    CsvScanner usage(usageFile);
+    const int usageCase = usage.column("Case_ID");
+    const int usageName = usage.column("Supply_Name");
+    const int usageQuantity = usage.column("Quantity_Used");
+    const int usageStatus = usage.column("Status");
+    if (usageCase >= 0 && usageName >= 0 && usageQuantity >= 0) {
+        while (usage.next()) {
+            const int row = caseDays.find(usage.field(usageCase));
+            if (row == -1) continue;
+            const double quantity = std::strtod(usage.field(usageQuantity).c_str(), nullptr);
+            addLocked(ROLLUP_SUPPLY_BURN, caseDays.get(row, 0), usage.field(usageName), quantity);
+            if (usage.field(usageStatus) == "Deducted") {
+                addLocked(ROLLUP_SUPPLY_DEDUCTED, caseDays.get(row, 0), usage.field(usageName), quantity);
+            }
+        }
+    }
+
+    // Queue: admissions and discharges per day
+    CsvScanner queue(queueFile);
+    const int admitted = queue.column("Admission_Time");
+    const int discharged = queue.column("Discharge_Time");
+    if (admitted >= 0) {
+        while (queue.next()) {
+            addLocked(ROLLUP_QUEUE_DAILY, ctimeDayBucket(queue.field(admitted)), ROLLUP_ADMITTED, 1);
+            addLocked(ROLLUP_QUEUE_DAILY, ctimeDayBucket(queue.field(discharged)), ROLLUP_DISCHARGED, 1);
+        }
+    }
+}
+
+// Rewrites the journal with one row per cell
+bool RollupStore::compactLocked() {
+    DurableWriter file(path); // Replaces the file atomically on commit
+    if (!file.isOpen()) return false;
+    file << "View,Bucket,Dimension,Delta\n";
+
+    long long rows = 0;
+    std::string view, rest, bucket, dimension;
+    cells.forEach([&](const std::string& key, double value) {
+        if (value == 0) return;
+        GroupAggregate::splitKey(key, view, rest);
+        GroupAggregate::splitKey(rest, bucket, dimension);
+        file << view << "," << bucket << "," << dimension << "," << formatValue(value) << "\n";
+        rows++;
+    });
+    if (!file.commit()) return false;
+    journalRows = rows;
+    return true;
+}
+
+void RollupStore::addLocked(const std::string& view, const std::string& bucket, const std::string& dimension, double delta) {
+    if (bucket.empty() || delta == 0) return;
+    cells.getOrInsert(cellKey(view, bucket, sanitize(dimension))) += delta;
+}
+
+void RollupStore::load() {
+    std::lock_guard<std::mutex> lock(mutex);
+    loadLocked();
+}
+
+void RollupStore::add(const std::string& view, const std::string& bucket, const std::string& dimension, double delta) {
+    if (bucket.empty() || delta == 0) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    loadLocked();
+    const std::string clean = sanitize(dimension);
+    cells.getOrInsert(cellKey(view, bucket, clean)) += delta;
+
+    if (path.empty()) return;
+    if (!appendDurably(path, view + "," + bucket + "," + clean + "," + formatValue(delta) + "\n")) {
+        MessageHandler::warning("Could not record a rollup update in " + path + ".");
+        return;
+    }
+    journalRows++;
+}
+
+double RollupStore::get(const std::string& view, const std::string& bucket, const std::string& dimension) {
+    std::lock_guard<std::mutex> lock(mutex);
+    loadLocked();
+    const double* value = cells.find(cellKey(view, bucket, sanitize(dimension)));
+    return value ? *value : 0.0;
+}
+
+int RollupStore::printView(const std::string& view, const std::string& from, const std::string& to,
+                           const std::string& bucketTitle, const std::string& valueTitle) {
+    // Matching cells, regrouped by bucket + dimension so they sort for listing
+    GroupAggregate rows;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        loadLocked();
+        std::string cellView, rest, bucket, dimension;
+        cells.forEach([&](const std::string& key, double value) {
+            if (value == 0) return;
+            GroupAggregate::splitKey(key, cellView, rest);
+            if (cellView != view) return;
+            GroupAggregate::splitKey(rest, bucket, dimension);
+            if (bucket < from || bucket >= to) return;
+            rows.add(GroupAggregate::compositeKey(bucket, dimension), value);
+        });
+    }
+
+    if (rows.getCount() == 0) {
+        std::cout << "No data in this range.\n";
+        return 0;
+    }
+    rows.sortByKey();
+
+    std::cout << std::left << std::setw(16) << bucketTitle << std::setw(30) << "Dimension" << valueTitle << "\n";
+    std::cout << std::string(56, '-') << "\n";
+    std::string bucket, dimension, lastBucket;
+    double total = 0.0;
+    for (int i = 0; i < rows.getCount(); i++) {
+        GroupAggregate::splitKey(rows.getKey(i), bucket, dimension);
+        std::cout << std::setw(16) << (bucket == lastBucket ? std::string("") : bucket) << std::setw(30) << dimension
+                  << rows.getTotals(i).sum << "\n";
+        lastBucket = bucket;
+        total += rows.getTotals(i).sum;
+    }
+    std::cout << std::setw(46) << "Total" << total << "\n";
+    return rows.getCount();
+}
@@ -9,9 +9,47 @@
 #include "message_handler.hpp"
 #include "path_utils.hpp"
 #include "supply_usage_log_dynamic_array.hpp"
+#include "supply_forecast.hpp"
+#include "paging.hpp"
 
 namespace fs = std::filesystem;
 
+/**
+ * @brief Sort orders supported by MedicalSupplyManager::querySupplies
+ */
+enum SupplySortKey {
+    SORT_SUPPLIES_NEWEST_FIRST, /// Stack order, most recently added first
+    SORT_SUPPLIES_BY_EXPIRY,    /// Earliest expiry date first
+    SORT_SUPPLIES_BY_NAME       /// Alphabetical by supply name
+};
+
+/**
+ * @struct SupplyQuery
+ * @brief Filter and ordering used for paged supply listings
+ *
+ * @details
+ * Empty strings mean "any" for that field. Expiry bounds are inclusive "YYYY-MM-DD" dates
+ */
+struct SupplyQuery {
+    std::string status;      /// "Available", "Expired" or "" for any
+    std::string supply_type; /// "MED", "EQP", "PPE" or "" for any
+    std::string name;        /// Supply name (case-insensitive) or "" for any
+    std::string expiry_from;
+    std::string expiry_to;
+    SupplySortKey sort_key = SORT_SUPPLIES_NEWEST_FIRST;
+};
+
+/**
+ * @struct SupplyPage
+ * @brief One materialized page of a supply query
+ */
+struct SupplyPage {
+    Supply items[LIST_PAGE_SIZE];
+    int count = 0;
+    bool has_more = false;
+    std::string next_cursor; /// Opaque token, pass it back to querySupplies to resume after this page
+};
+
 /**
  * @brief Handles medical supply management operations using a stack data structure
  *
@@ -24,12 +62,28 @@ class MedicalSupplyManager {
 private:
     SupplyStack stack; /// Stack for storing supply records
     SupplyUsageLogDynamicArray usage_logs; /// Dynamic array for storing supply usage logs
+    bool supplies_dirty = false;   /// Stack changed in a way an append cannot express (pop, quantity update)
+    bool usage_log_dirty = false;  /// Usage log statuses changed since it was loaded or saved
+    unsigned long long usage_log_offset = 0; /// Bytes of supply_usage_log.csv already ingested into usage_logs
+    SupplyForecaster usage_forecast; /// Usage rates per supply name, fed by the daily burn rollup and new usage rows
 
     void loadSupplyUsageLog();
+    void refreshSupplyUsageLog();
+    int ingestSupplyUsageLogTail(const std::string& filePath);
+    bool isSupplyUsageLogPrefixUnchanged(const std::string& filePath);
     void saveSupplyUsageLog();
+    void saveSupplySnapshot(const std::string& filePath, unsigned long long csvSize) const;
+    void saveUsageLogSnapshot(const std::string& filePath, unsigned long long csvSize);
     void viewAllSupplyUsageLog();
     void viewNonDeductedSupplyUsageLog();
     void deductSupplyFromUsageLog();
+    void loadReorderThresholds();
+    void saveReorderThresholds();
+    void viewStockByName();
+    void viewStockByType();
+    void setReorderThreshold();
+    void seedUsageForecast();
+    void viewDepletionForecast();
 
 public:
     /**
@@ -52,6 +106,7 @@ public:
     /**
      * @brief Saves the current state of the stack to a CSV file
      * @param filename Path to the CSV file
+     * @note Skipped when the stack has no unsaved changes (new supplies are already appended on add)
      */
     void saveToCSV(const std::string& filename);
 
@@ -74,6 +129,31 @@ public:
      */
     void useLastAddedSupply();
 
+    /**
+     * @brief Uses units of a supply, earliest-expiring batches first
+     * @details Same first-expiry-first-out policy as the ED officer's automatic allocation, so
+     * long-dated stock is not used up while short-dated batches expire
+     */
+    void useSupplyFEFO();
+
+    /**
+     * @brief Materializes one page of supplies matching a query
+     * @param query Filter and sort key
+     * @param cursor "" for the first page, otherwise the next_cursor of the previous page
+     * @return Up to LIST_PAGE_SIZE supplies that sort after the cursor
+     */
+    SupplyPage querySupplies(const SupplyQuery& query, const std::string& cursor) const;
+
+    /**
+     * @brief Prints the results of a query page by page, prompting between pages
+     */
+    void printSuppliesPaged(const SupplyQuery& query, const std::string& title) const;
+
+    /**
+     * @brief Prompts for filters and displays matching supplies page by page
+     */
+    void searchSupplies();
+
     /**
      * @brief Displays all current supplies in the stack
      */
@@ -124,6 +204,13 @@ public:
      */
     void displayInventoryMenu();
 
+    /**
+     * @brief Displays running stock totals per supply name and type, with reorder thresholds
+     * @details Totals are maintained by the stack as supplies change, so the dashboard never rescans batches.
+     * The depletion forecast combines them with usage rates kept up to date as usage rows arrive
+     */
+    void displayStockLevelsMenu();
+
     /**
      * @brief Displays a user menu for interacting with the system
      */
@@ -2,8 +2,10 @@
 #define STACK_HPP
 
 #include <iostream>
+#include <string>
 
 #include "entities.hpp"
+#include "hash_map.hpp"
 
 /**
  * @brief Implements a stack data structure for managing medical supplies
@@ -14,17 +16,62 @@
  */
 
 #define MAX_STACK_CAPACITY 1000
+#define DEFAULT_REORDER_THRESHOLD 100 /// Units per supply name, used when no threshold is configured
+
+/**
+ * @struct SupplyTotal
+ * @brief Running stock aggregate for one supply name or supply type
+ */
+struct SupplyTotal {
+    int batches = 0;         /// Batches currently on the stack
+    int available_units = 0; /// Units in batches that have not expired
+    int expired_units = 0;   /// Units in batches past their expiry date
+};
+
+/**
+ * @struct ExpiryHeap
+ * @brief Min-heap of the stack slots of one supply name, earliest expiry date at slots[0]
+ */
+struct ExpiryHeap {
+    int* slots = nullptr;
+    int count = 0;
+    int capacity = 0;
+};
 
 class SupplyStack {
 private:
     Supply supplies[MAX_STACK_CAPACITY]; /// Static array to hold supply items
     int top; /// Index of the top element in the stack
 
+    // Running totals, updated by every operation that changes a quantity so reading them is O(1)
+    bool counted_expired[MAX_STACK_CAPACITY]; /// Slot's units are counted as expired rather than available
+    StringHashMap<SupplyTotal> totals_by_name;
+    StringHashMap<SupplyTotal> totals_by_type;
+    StringHashMap<int> reorder_thresholds;    /// Supply name or type -> threshold on available units
+    std::string expiry_checked_on;            /// "YYYY-MM-DD" of the last expiry sweep
+    bool alerts_enabled;
+
+    // Earliest-expiry-first lookup: a slot is in its name's heap while it has units and has not expired
+    StringHashMap<ExpiryHeap> expiry_heaps;
+    int heap_position[MAX_STACK_CAPACITY];    /// Slot's index in its name's heap, -1 if not in it
+
+    bool expiresBefore(int a, int b) const;
+    void placeInHeap(ExpiryHeap& heap, int position, int slot);
+    void siftUpInHeap(ExpiryHeap& heap, int position);
+    void siftDownInHeap(ExpiryHeap& heap, int position);
+    void addToHeap(int slot);
+    void removeFromHeap(int slot);
+    void applyDelta(const Supply& supply, int batchDelta, int availableDelta, int expiredDelta);
+    void checkThreshold(const std::string& key, int before, int after, bool isType) const;
+
 public:
     /**
      * @brief Constructor to initialize an empty stack
      */
     SupplyStack();
+    ~SupplyStack();
+    SupplyStack(const SupplyStack&) = delete;
+    SupplyStack& operator=(const SupplyStack&) = delete;
 
     /**
      * @brief Checks if the stack is full
@@ -73,6 +120,69 @@ public:
      * @return Supply at the given index
      */
     Supply getSupplyAt(int index) const;
+
+    /**
+     * @brief Changes the quantity of the supply at a given index, keeping the totals in step
+     * @param index Index from 0 to top
+     * @param quantity New quantity
+     */
+    void setQuantityAt(int index, int quantity);
+
+    /**
+     * @brief Index of the unexpired, non-empty batch of a name that expires first
+     * @details O(1), the per-name heaps are kept current by push, pop and setQuantityAt
+     * @return -1 if the name has no usable batch
+     */
+    int getEarliestExpiringIndex(const std::string& name);
+
+    /**
+     * @brief Moves batches whose expiry date has passed from available to expired
+     * @details Scans the stack at most once per calendar day, otherwise returns immediately
+     */
+    void refreshExpiry();
+
+    /**
+     * @brief Running totals of one supply name, nullptr if no batch has that name
+     */
+    const SupplyTotal* getTotalForName(const std::string& name);
+
+    /**
+     * @brief Running totals of one supply type (MED, EQP, PPE), nullptr if none
+     */
+    const SupplyTotal* getTotalForType(const std::string& type);
+
+    /**
+     * @brief Calls visit(name, total) for every supply name, in no particular order
+     */
+    template <typename Visitor>
+    void forEachNameTotal(Visitor visit) {
+        refreshExpiry();
+        totals_by_name.forEach(visit);
+    }
+
+    /**
+     * @brief Sets the reorder threshold of a supply name or type
+     * @details Threshold 0 disables the alert for that key
+     */
+    void setReorderThreshold(const std::string& key, int threshold);
+
+    /**
+     * @brief Threshold of a supply name or type; names default to DEFAULT_REORDER_THRESHOLD, types to 0
+     */
+    int getReorderThreshold(const std::string& key, bool isType) const;
+
+    /**
+     * @brief Calls visit(key, threshold) for every configured threshold
+     */
+    template <typename Visitor>
+    void forEachReorderThreshold(Visitor visit) const {
+        reorder_thresholds.forEach(visit);
+    }
+
+    /**
+     * @brief Turns low-stock alerts on or off (off while a dataset is being loaded)
+     */
+    void setAlertsEnabled(bool enabled);
 };
 
 #endif
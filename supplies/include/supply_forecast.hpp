@@ -0,0 +1,66 @@
+#ifndef SUPPLY_FORECAST_HPP
+#define SUPPLY_FORECAST_HPP
+
+#include <string>
+#include "hash_map.hpp"
+
+#define FORECAST_HALF_LIFE_DAYS 14 // A day's usage weighs half as much this many days later
+#define FORECAST_LEAD_TIME_DAYS 7  // Items running out sooner than this go on the reorder list
+#define FORECAST_COVER_DAYS 30     // Suggested orders cover the lead time plus this many days of use
+
+/**
+ * @struct UsageRate
+ * @brief Exponentially weighted daily usage of one supply name
+ */
+struct UsageRate {
+    double units_per_day = 0.0; /// Rate as of `day`, that day's usage included
+    long long day = 0;          /// Day number the rate was last brought forward to
+};
+
+/**
+ * @brief Incremental usage rates per supply name, the input of the depletion forecast
+ *
+ * @details
+ * - Each day's usage enters as alpha * units, where alpha = 1 - 2^(-1/FORECAST_HALF_LIFE_DAYS),
+ *   and everything before decays by (1 - alpha) per day, days without usage included
+ * - Usage for a day older than the rate's current day is weighted by its age instead, so
+ *   observations may arrive in any order and the result is the same
+ * - observe() and rateOn() are O(1), the log is never rescanned
+ *
+ * @usage
+ *      SupplyForecaster forecaster;
+ *      forecaster.observe("Bandage", SupplyForecaster::dayNumber("2025-11-09"), 12);
+ *      double perDay = forecaster.rateOn("Bandage", SupplyForecaster::today());
+ */
+class SupplyForecaster {
+private:
+    StringHashMap<UsageRate> rates;
+    double alpha;
+
+    double decay(long long days) const;
+
+public:
+    SupplyForecaster();
+
+    /**
+     * @brief Adds units used of a supply on a day
+     */
+    void observe(const std::string& name, long long day, double units);
+
+    /**
+     * @brief Expected units used per day, as of a day on or after the last observation
+     * @return 0 for a supply never observed
+     */
+    double rateOn(const std::string& name, long long day) const;
+
+    void clear();
+
+    /**
+     * @brief Days since the epoch of a "YYYY-MM-DD[ HH:MM]" local date, -1 if unreadable
+     */
+    static long long dayNumber(const std::string& date);
+
+    static long long today();
+};
+
+#endif // SUPPLY_FORECAST_HPP
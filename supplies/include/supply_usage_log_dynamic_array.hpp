@@ -16,6 +16,7 @@ class SupplyUsageLogDynamicArray {
         void appendArray(SupplyUsageLog log);
         SupplyUsageLog getElementAt(int index);
         void setElementAt(int index, SupplyUsageLog value);
+        void clearArray();
 };
 
 #endif
@@ -10,6 +10,7 @@
 #include "string_utils.hpp"
 #include "stack.hpp"
 #include "time_utils.hpp"
+#include "durable_writer.hpp"
 
 /**
  * @brief Writes the most recently added supply into medical_supply.csv
@@ -37,33 +38,29 @@ void MedicalSupplyManager::writeSupplyIntoCSV(const Supply& supply, const std::s
         }
     }
 
-    std::ofstream file(filePath, std::ios::app);
-    if (!file.is_open()) {
-        MessageHandler::error("Failed to open " + filePath + " for writing.");
-        return;
-    }
+    std::ostringstream entry;
 
     // Write header if missing
     if (!hasHeader) {
-        file << "Supply_Batch_ID,Name,Supply_Type,Quantity,"
-                "Status,Supplier_Name,Timestamp_Added,Expiry_Date\n";
+        entry << "Supply_Batch_ID,Name,Supply_Type,Quantity,"
+                 "Status,Supplier_Name,Timestamp_Added,Expiry_Date\n";
     }
 
     // Write new supply entry
-    file << supply.supply_batch_id << ","
-         << supply.name << ","
-         << supply.supply_type << ","
-         << supply.quantity << ","
-         << supply.status << ","
-         << supply.supplier_name << ","
-         << supply.timestamp_added << ","
-         << supply.expiry_date << std::endl;
-
-    if (file.fail()) {
+    entry << supply.supply_batch_id << ","
+          << supply.name << ","
+          << supply.supply_type << ","
+          << supply.quantity << ","
+          << supply.status << ","
+          << supply.supplier_name << ","
+          << supply.timestamp_added << ","
+          << supply.expiry_date << "\n";
+
+    if (!appendDurably(filePath, entry.str())) {
         MessageHandler::error("Failed to write to " + filePath);
+        return;
     }
 
-    file.close();
     MessageHandler::info("New supply has been saved in the system.");
 }
 
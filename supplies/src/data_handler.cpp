@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 #include "medical_supply_manager.hpp"
@@ -8,6 +9,8 @@
 #include "string_utils.hpp"
 #include "stack.hpp"
 #include "path_utils.hpp"
+#include "durable_writer.hpp"
+#include "snapshot.hpp"
 
 /**
 * @brief Loads CSV file
@@ -15,11 +18,32 @@
 void MedicalSupplyManager::loadFromCSV(const std::string& filename) {
     std::string filePath = getDataFilePath(filename);
 
+    // An up-to-date snapshot is pushed as is, no per-row parsing
+    SnapshotReader snapshot(filePath, SUPPLY_SNAPSHOT_COLUMNS);
+    if (snapshot.isValid()) {
+        for (long long row = 0; row < snapshot.getRowCount(); row++) {
+            Supply s{
+                snapshot.getString(row, 0),
+                snapshot.getString(row, 1),
+                snapshot.getString(row, 2),
+                static_cast<int>(snapshot.getInt(row, 3)),
+                snapshot.getString(row, 4),
+                snapshot.getString(row, 5),
+                snapshot.getString(row, 6),
+                snapshot.getString(row, 7)
+            };
+            stack.push(s);
+        }
+        return;
+    }
+
     std::ifstream file(filePath);
     if (!file.is_open()) {
         MessageHandler::error("Unable to open dataset: " + filePath);
         return;
     }
+    std::error_code sizeError;
+    const uintmax_t csvSize = fs::file_size(filePath, sizeError);
 
     std::string line;
     std::getline(file, line); // Skip CSV header
@@ -59,14 +83,20 @@ void MedicalSupplyManager::loadFromCSV(const std::string& filename) {
     }
 
     file.close();
+    if (!sizeError) {
+        saveSupplySnapshot(filePath, static_cast<unsigned long long>(csvSize));
+    }
 }
 
 void MedicalSupplyManager::saveToCSV(const std::string &filename) {
+    if (!supplies_dirty) {
+        return; // Nothing changed since the last load or save
+    }
+
     std::string filePath = getDataFilePath(filename);
-    std::ofstream file(filePath, std::ios::trunc); // Overwrite the file
+    DurableWriter file(filePath); // Replaces the file atomically on commit
 
-    if (!file.is_open()) {
-        MessageHandler::error("Failed to open " + filePath + " for writing.");
+    if (!file.isOpen()) {
         return;
     }
 
@@ -88,53 +118,244 @@ void MedicalSupplyManager::saveToCSV(const std::string &filename) {
              << s.expiry_date << "\n";
     }
 
-    file.close();
+    const unsigned long long csvSize = file.bytesWritten();
+    if (file.commit()) {
+        supplies_dirty = false;
+        saveSupplySnapshot(filePath, csvSize);
+    }
 }
 
-void MedicalSupplyManager::loadSupplyUsageLog() {
-    std::string filePath = getDataFilePath("supply_usage_log.csv");
-
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        MessageHandler::error("Unable to open dataset: " + filePath);
-        return;
+void MedicalSupplyManager::saveSupplySnapshot(const std::string& filePath, unsigned long long csvSize) const {
+    SnapshotWriter snapshot(SUPPLY_SNAPSHOT_COLUMNS);
+    for (int i = 0; i <= stack.getTopIndex(); ++i) {
+        Supply s = stack.getSupplyAt(i);
+        snapshot.addString(s.supply_batch_id)
+                .addString(s.name)
+                .addString(s.supply_type)
+                .addInt(s.quantity)
+                .addString(s.status)
+                .addString(s.supplier_name)
+                .addString(s.timestamp_added)
+                .addString(s.expiry_date);
     }
+    snapshot.save(filePath, csvSize);
+}
 
-    std::string line;
-    std::getline(file, line); // Skip CSV header
-
-    while (std::getline(file, line)) {
+namespace {
+    // Parses one supply_usage_log.csv row, returns false for blank, malformed or half-written lines
+    bool parseSupplyUsageLogLine(const std::string& line, SupplyUsageLog& log) {
         std::stringstream ss(line);
         std::string case_id, patient_id, supply_batch_id, supply_name, quantity_used_str, status;
-        
-        if (!std::getline(ss, case_id, ',')) continue;
-        if (!std::getline(ss, patient_id, ',')) continue;
-        if (!std::getline(ss, supply_batch_id, ',')) continue;
-        if (!std::getline(ss, supply_name, ',')) continue;
-        if (!std::getline(ss, quantity_used_str, ',')) continue;
-        if (!std::getline(ss, status, ',')) continue;
 
-        SupplyUsageLog log {
+        if (!std::getline(ss, case_id, ',')) return false;
+        if (!std::getline(ss, patient_id, ',')) return false;
+        if (!std::getline(ss, supply_batch_id, ',')) return false;
+        if (!std::getline(ss, supply_name, ',')) return false;
+        if (!std::getline(ss, quantity_used_str, ',')) return false;
+        if (!std::getline(ss, status, ',')) return false;
+
+        int quantity_used;
+        try {
+            quantity_used = std::stoi(trim(quantity_used_str));
+        } catch (const std::exception&) {
+            return false;
+        }
+
+        log = SupplyUsageLog {
             trim(case_id),
             trim(patient_id),
             trim(supply_batch_id),
             trim(supply_name),
-            std::stoi(trim(quantity_used_str)),
+            quantity_used,
             trim(status)
         };
+        return true;
+    }
 
-        usage_logs.appendArray(log);
+    bool isSameSupplyUsageLog(const SupplyUsageLog& a, const SupplyUsageLog& b) {
+        return a.case_id == b.case_id && a.patient_id == b.patient_id
+            && a.supply_batch_id == b.supply_batch_id && a.supply_name == b.supply_name
+            && a.quantity_used == b.quantity_used && a.status == b.status;
     }
+}
+
+/**
+ * @brief Loads supply_usage_log.csv into usage_logs
+ *
+ * @details
+ * - An up-to-date snapshot is used as is
+ * - If rows were appended (by the ED officer) after the snapshot was written, the snapshot still
+ *   covers the unchanged prefix and only the appended lines are parsed
+ * - Otherwise the whole CSV is parsed once and the snapshot is rebuilt
+ */
+void MedicalSupplyManager::loadSupplyUsageLog() {
+    std::string filePath = getDataFilePath("supply_usage_log.csv");
+    usage_logs.clearArray();
+    usage_log_offset = 0;
+
+    {
+        SnapshotReader snapshot(filePath, USAGE_LOG_SNAPSHOT_COLUMNS, true);
+        if (snapshot.isValid()) {
+            for (long long row = 0; row < snapshot.getRowCount(); row++) {
+                SupplyUsageLog log {
+                    snapshot.getString(row, 0),
+                    snapshot.getString(row, 1),
+                    snapshot.getString(row, 2),
+                    snapshot.getString(row, 3),
+                    static_cast<int>(snapshot.getInt(row, 4)),
+                    snapshot.getString(row, 5)
+                };
+                usage_logs.appendArray(log);
+            }
+            usage_log_offset = snapshot.getSourceSize();
 
+            if (!isSupplyUsageLogPrefixUnchanged(filePath)) {
+                // The file was rewritten since the snapshot was taken
+                usage_logs.clearArray();
+                usage_log_offset = 0;
+            }
+        }
+    }
+
+    const bool fromSnapshot = usage_log_offset > 0;
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        MessageHandler::error("Unable to open dataset: " + filePath);
+        return;
+    }
     file.close();
+
+    int added = ingestSupplyUsageLogTail(filePath);
+    if (!fromSnapshot || added > 0) {
+        saveUsageLogSnapshot(filePath, usage_log_offset);
+    }
 }
 
-void MedicalSupplyManager::saveSupplyUsageLog() {
+/**
+ * @brief Picks up rows appended to supply_usage_log.csv since it was last read
+ *
+ * @details
+ * Polled on demand from the usage log menu. Only the bytes after usage_log_offset are read;
+ * if the file shrank or its already ingested part changed, it was rewritten and is reloaded
+ */
+void MedicalSupplyManager::refreshSupplyUsageLog() {
     std::string filePath = getDataFilePath("supply_usage_log.csv");
-    std::ofstream file(filePath, std::ios::trunc); // Overwrite the file
 
+    std::error_code ec;
+    const uintmax_t fileSize = fs::file_size(filePath, ec);
+    if (ec || fileSize == usage_log_offset) {
+        return;
+    }
+
+    if (fileSize < usage_log_offset || !isSupplyUsageLogPrefixUnchanged(filePath)) {
+        loadSupplyUsageLog();
+        return;
+    }
+
+    int added = ingestSupplyUsageLogTail(filePath);
+    if (added > 0) {
+        // Rows carry no time of their own, they count as used on the day they arrive
+        const long long today = SupplyForecaster::today();
+        for (int i = usage_logs.getSize() - added; i < usage_logs.getSize(); i++) {
+            const SupplyUsageLog log = usage_logs.getElementAt(i);
+            usage_forecast.observe(log.supply_name, today, log.quantity_used);
+        }
+        MessageHandler::info(std::to_string(added) + " new supply usage record(s) received.");
+    }
+}
+
+/**
+ * @brief Parses the lines after usage_log_offset and appends them to usage_logs
+ * @return Number of records added
+ *
+ * @note
+ * A trailing line without a newline is only taken once it is a complete record, so a row that
+ * is still being appended is picked up by a later refresh instead of being read half-written
+ */
+int MedicalSupplyManager::ingestSupplyUsageLogTail(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
     if (!file.is_open()) {
-        MessageHandler::error("Failed to open " + filePath + " for writing.");
+        return 0;
+    }
+    file.seekg(static_cast<std::streamoff>(usage_log_offset));
+    std::string chunk((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    int added = 0;
+    size_t start = 0;
+    while (start < chunk.size()) {
+        size_t end = chunk.find('\n', start);
+        const bool terminated = end != std::string::npos;
+        std::string line = chunk.substr(start, terminated ? end - start : std::string::npos);
+
+        if (usage_log_offset == 0 && start == 0) {
+            // CSV header
+            if (!terminated) break;
+            start = end + 1;
+            continue;
+        }
+
+        SupplyUsageLog log;
+        const bool parsed = parseSupplyUsageLogLine(line, log);
+        if (!terminated && !(parsed && (log.status == "Deducted" || log.status == "Not Deducted"))) {
+            break; // Partial last line, leave it for the next refresh
+        }
+        if (parsed) {
+            usage_logs.appendArray(log);
+            added++;
+        }
+        start = terminated ? end + 1 : chunk.size();
+    }
+
+    usage_log_offset += start;
+    return added;
+}
+
+/**
+ * @brief Checks that the last line already ingested is still in place in the file
+ */
+bool MedicalSupplyManager::isSupplyUsageLogPrefixUnchanged(const std::string& filePath) {
+    if (usage_log_offset == 0) {
+        return true;
+    }
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // The last ingested line ends at usage_log_offset, read a window that holds it
+    const unsigned long long window = usage_log_offset < 4096 ? usage_log_offset : 4096;
+    std::string tail(static_cast<size_t>(window), '\0');
+    file.seekg(static_cast<std::streamoff>(usage_log_offset - window));
+    if (!file.read(&tail[0], static_cast<std::streamsize>(window))) {
+        return false;
+    }
+
+    if (!tail.empty() && tail.back() == '\n') {
+        tail.pop_back();
+    }
+    size_t lineStart = tail.rfind('\n');
+    std::string line = (lineStart == std::string::npos) ? tail : tail.substr(lineStart + 1);
+
+    if (usage_logs.getSize() == 0) {
+        return line.find("Case_ID") != std::string::npos; // Only the header was ingested
+    }
+
+    SupplyUsageLog last;
+    return parseSupplyUsageLogLine(line, last)
+        && isSameSupplyUsageLog(last, usage_logs.getElementAt(usage_logs.getSize() - 1));
+}
+
+void MedicalSupplyManager::saveSupplyUsageLog() {
+    if (!usage_log_dirty) {
+        return; // Nothing changed since the last load or save
+    }
+
+    std::string filePath = getDataFilePath("supply_usage_log.csv");
+    DurableWriter file(filePath); // Replaces the file atomically on commit
+
+    if (!file.isOpen()) {
         return;
     }
 
@@ -152,5 +373,24 @@ void MedicalSupplyManager::saveSupplyUsageLog() {
              << log.status << "\n";
     }
 
-    file.close();
+    const unsigned long long csvSize = file.bytesWritten();
+    if (file.commit()) {
+        usage_log_dirty = false;
+        usage_log_offset = csvSize; // Our own rewrite, nothing left to tail
+        saveUsageLogSnapshot(filePath, csvSize);
+    }
+}
+
+void MedicalSupplyManager::saveUsageLogSnapshot(const std::string& filePath, unsigned long long csvSize) {
+    SnapshotWriter snapshot(USAGE_LOG_SNAPSHOT_COLUMNS);
+    for (int i = 0; i < usage_logs.getSize(); ++i) {
+        SupplyUsageLog log = usage_logs.getElementAt(i);
+        snapshot.addString(log.case_id)
+                .addString(log.patient_id)
+                .addString(log.supply_batch_id)
+                .addString(log.supply_name)
+                .addInt(log.quantity_used)
+                .addString(log.status);
+    }
+    snapshot.save(filePath, csvSize);
 }
@@ -26,13 +26,18 @@ void MedicalSupplyManager::displayMenu() {
     // Load dataset
     loadFromCSV("medical_supply.csv");
     loadSupplyUsageLog();
+    loadReorderThresholds();
+    seedUsageForecast();
+    stack.setAlertsEnabled(true); // Only changes made from now on raise low-stock alerts
 
     do {
         std::cout << "\n--------------- MEDICAL SUPPLY MANAGEMENT MENU -----------------\n";
         std::cout << "1. Add New Supply\n";
         std::cout << "2. Use (Remove) Last Added Supply\n";
-        std::cout << "3. View Supply Inventory\n";
-        std::cout << "4. Exit\n";
+        std::cout << "3. Use Supply (Earliest Expiry First)\n";
+        std::cout << "4. View Supply Inventory\n";
+        std::cout << "5. Stock Levels & Reorder Alerts\n";
+        std::cout << "6. Exit\n";
         std::cout << "----------------------------------------------------------------\n";
         std::cout << "Enter a number to perform an action: ";
 
@@ -53,14 +58,20 @@ void MedicalSupplyManager::displayMenu() {
                 useLastAddedSupply();
                 break;
             case 3:
-                displayInventoryMenu();
+                useSupplyFEFO();
                 break;
             case 4:
+                displayInventoryMenu();
+                break;
+            case 5:
+                displayStockLevelsMenu();
+                break;
+            case 6:
                 MessageHandler::info("Exiting Medical Supply Management System...\n");
                 break;
             default:
                 MessageHandler::error("Invalid choice. Please select a valid option.");
                 break;
         }
-    } while (choice != 4);
+    } while (choice != 6);
 }
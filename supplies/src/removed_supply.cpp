@@ -6,12 +6,16 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 
 #include "medical_supply_manager.hpp"
 #include "message_handler.hpp"
 #include "stack.hpp"
 
 #include "time_utils.hpp"
+#include "durable_writer.hpp"
+#include "rollup_store.hpp"
+#include "string_utils.hpp"
 
 /**
 * @brief Appends a removed supply record into removed_supplies.csv
@@ -36,38 +40,32 @@ void MedicalSupplyManager::writeRemovedSupply(const Supply& supply) {
         }
     }
 
-    std::ofstream file(filePath, std::ios::app);
-    if (!file.is_open()) {
-        MessageHandler::error("Failed to open " + filePath + " for writing removed supplies.");
-        return;
-    }
+    std::ostringstream entry;
 
     // Write header if not present
     if (!hasHeader) {
-        file << "Supply_Batch_ID,Name,Supply_Type,Quantity,"
-                "Status,Supplier_Name,Timestamp_Added,Expiry_Date,Removed_On\n";
+        entry << "Supply_Batch_ID,Name,Supply_Type,Quantity,"
+                 "Status,Supplier_Name,Timestamp_Added,Expiry_Date,Removed_On\n";
     }
 
     // Get current timestamp for removal
     std::string removedOn = getCurrentTimestamp();
 
     // Append supply details
-    file << supply.supply_batch_id << ","
-         << supply.name << ","
-         << supply.supply_type << ","
-         << supply.quantity << ","
-         << supply.status << ","
-         << supply.supplier_name << ","
-         << supply.timestamp_added << ","
-         << supply.expiry_date << ","
-         << removedOn << std::endl;
-
-    if (file.fail()) {
+    entry << supply.supply_batch_id << ","
+          << supply.name << ","
+          << supply.supply_type << ","
+          << supply.quantity << ","
+          << supply.status << ","
+          << supply.supplier_name << ","
+          << supply.timestamp_added << ","
+          << supply.expiry_date << ","
+          << removedOn << "\n";
+
+    if (!appendDurably(filePath, entry.str())) {
         MessageHandler::error("Failed to write to " + filePath);
     }
 
-    file.close();
-
     // MessageHandler::info("Removed supply has been recorded.");
 }
 
@@ -101,6 +99,7 @@ void MedicalSupplyManager::useLastAddedSupply() {
     std::cout << std::string(75, '-') << "\n";
 
     // Save the updated stack to the CSV file
+    supplies_dirty = true;
     saveToCSV("medical_supply.csv");
 
     // Log the removed supply
@@ -108,3 +107,63 @@ void MedicalSupplyManager::useLastAddedSupply() {
 
     MessageHandler::info("Removed supply logged and inventory updated successfully.");
 }
+
+/**
+ * @brief Uses units of one supply name, earliest-expiring batches first
+ *
+ * @details
+ * - The stack keeps an expiry heap per supply name, so the next batch is its heap top and
+ *   each batch used costs O(log batches); the stack itself is never scanned
+ * - Each batch drawn from is recorded in removed_supplies.csv with the units taken;
+ *   emptied batches stay on the stack with quantity 0, as after a usage log deduction
+ */
+void MedicalSupplyManager::useSupplyFEFO() {
+    std::string name, quantityStr;
+    std::cout << "Supply name: ";
+    std::getline(std::cin, name);
+    name = trim(name);
+    if (name.empty()) {
+        MessageHandler::info("Cancelled.");
+        return;
+    }
+
+    std::cout << "Quantity to use: ";
+    std::getline(std::cin, quantityStr);
+    int quantity;
+    try {
+        quantity = std::stoi(trim(quantityStr));
+    } catch (const std::exception&) {
+        MessageHandler::error("Invalid quantity. Please enter a whole number.");
+        return;
+    }
+    if (quantity <= 0) {
+        MessageHandler::error("Quantity must be greater than 0.");
+        return;
+    }
+
+    const SupplyTotal* total = stack.getTotalForName(name);
+    const int available = total != nullptr ? total->available_units : 0;
+    if (quantity > available) {
+        MessageHandler::error("Not enough unexpired stock of " + name + ". Only " + std::to_string(available) + " available.");
+        return;
+    }
+
+    int remaining = quantity;
+    int slot;
+    while (remaining > 0 && (slot = stack.getEarliestExpiringIndex(name)) >= 0) {
+        Supply batch = stack.getSupplyAt(slot);
+        const int used = batch.quantity < remaining ? batch.quantity : remaining;
+        stack.setQuantityAt(slot, batch.quantity - used); // An emptied batch leaves the name's heap
+        remaining -= used;
+
+        batch.quantity = used;
+        writeRemovedSupply(batch);
+        MessageHandler::info("Used " + std::to_string(used) + " of " + name + " from batch " +
+                             batch.supply_batch_id + " (expires " + batch.expiry_date + ").");
+    }
+
+    RollupStore::instance().add(ROLLUP_SUPPLY_DEDUCTED, RollupStore::todayBucket(), name, quantity);
+    supplies_dirty = true;
+    saveToCSV("medical_supply.csv");
+    MessageHandler::info("Used " + std::to_string(quantity) + " of " + name + ", inventory updated.");
+}
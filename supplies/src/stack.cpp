@@ -1,10 +1,19 @@
 #include "stack.hpp"
 #include <message_handler.hpp>
+#include "time_utils.hpp"
 
 /**
  * @brief Constructor initializes an empty stack
  */
-SupplyStack::SupplyStack() : top(-1) {}
+SupplyStack::SupplyStack() : top(-1), counted_expired(), alerts_enabled(false) {
+    for (int i = 0; i < MAX_STACK_CAPACITY; i++) heap_position[i] = -1;
+}
+
+SupplyStack::~SupplyStack() {
+    expiry_heaps.forEach([](const std::string&, const ExpiryHeap& heap) {
+        delete[] heap.slots;
+    });
+}
 
 /**
  * @brief Checks if the stack is full
@@ -33,6 +42,13 @@ void SupplyStack::push(const Supply &newSupply) {
     }
     top++;
     supplies[top] = newSupply;
+    counted_expired[top] = isDateExpired(newSupply.expiry_date);
+    if (counted_expired[top]) {
+        applyDelta(newSupply, 1, 0, newSupply.quantity);
+    } else {
+        applyDelta(newSupply, 1, newSupply.quantity, 0);
+        if (newSupply.quantity > 0) addToHeap(top);
+    }
 }
 
 /**
@@ -57,6 +73,12 @@ Supply SupplyStack::pop() {
         return Supply{};
     }
     Supply removed = supplies[top];
+    removeFromHeap(top);
+    if (counted_expired[top]) {
+        applyDelta(removed, -1, 0, -removed.quantity);
+    } else {
+        applyDelta(removed, -1, -removed.quantity, 0);
+    }
     top--;
     return removed;
 }
@@ -89,3 +111,172 @@ Supply SupplyStack::getSupplyAt(int index) const {
     if (index >= 0 && index <= top) return supplies[index];
     throw std::out_of_range("Index out of bounds in SupplyStack");
 }
+
+/**
+ * @brief Change the quantity of the supply at a specific index
+ * @details Only the difference is applied to the running totals
+ * @throws std::out_of_range if index is invalid
+ */
+void SupplyStack::setQuantityAt(int index, int quantity) {
+    if (index < 0 || index > top) throw std::out_of_range("Index out of bounds in SupplyStack");
+    const int delta = quantity - supplies[index].quantity;
+    supplies[index].quantity = quantity;
+    if (counted_expired[index]) {
+        applyDelta(supplies[index], 0, 0, delta);
+    } else {
+        applyDelta(supplies[index], 0, delta, 0);
+        if (quantity > 0) addToHeap(index);
+        else removeFromHeap(index);
+    }
+}
+
+/**
+ * @brief Move batches that expired since the last sweep from available to expired
+ * @details Batches only expire when the date changes, so the stack is scanned once per day at most
+ */
+void SupplyStack::refreshExpiry() {
+    const std::string today = getCurrentTimestamp().substr(0, 10);
+    if (today == expiry_checked_on) return;
+    expiry_checked_on = today;
+
+    for (int i = 0; i <= top; i++) {
+        if (!counted_expired[i] && isDateExpired(supplies[i].expiry_date)) {
+            counted_expired[i] = true;
+            removeFromHeap(i);
+            applyDelta(supplies[i], 0, -supplies[i].quantity, supplies[i].quantity);
+        }
+    }
+}
+
+int SupplyStack::getEarliestExpiringIndex(const std::string& name) {
+    refreshExpiry();
+    const ExpiryHeap* heap = expiry_heaps.find(name);
+    return heap != nullptr && heap->count > 0 ? heap->slots[0] : -1;
+}
+
+const SupplyTotal* SupplyStack::getTotalForName(const std::string& name) {
+    refreshExpiry();
+    return totals_by_name.find(name);
+}
+
+const SupplyTotal* SupplyStack::getTotalForType(const std::string& type) {
+    refreshExpiry();
+    return totals_by_type.find(type);
+}
+
+void SupplyStack::setReorderThreshold(const std::string& key, int threshold) {
+    reorder_thresholds.insertOrAssign(key, threshold);
+}
+
+int SupplyStack::getReorderThreshold(const std::string& key, bool isType) const {
+    const int* threshold = reorder_thresholds.find(key);
+    if (threshold) return *threshold;
+    return isType ? 0 : DEFAULT_REORDER_THRESHOLD;
+}
+
+void SupplyStack::setAlertsEnabled(bool enabled) {
+    alerts_enabled = enabled;
+}
+
+/**
+ * @brief Apply a change to the name and type totals of one supply
+ */
+void SupplyStack::applyDelta(const Supply& supply, int batchDelta, int availableDelta, int expiredDelta) {
+    SupplyTotal& byName = totals_by_name.getOrInsert(supply.name);
+    const int nameBefore = byName.available_units;
+    byName.batches += batchDelta;
+    byName.available_units += availableDelta;
+    byName.expired_units += expiredDelta;
+
+    SupplyTotal& byType = totals_by_type.getOrInsert(supply.supply_type);
+    const int typeBefore = byType.available_units;
+    byType.batches += batchDelta;
+    byType.available_units += availableDelta;
+    byType.expired_units += expiredDelta;
+
+    checkThreshold(supply.name, nameBefore, byName.available_units, false);
+    checkThreshold(supply.supply_type, typeBefore, byType.available_units, true);
+}
+
+/**
+ * @brief Alert the moment a total drops below its reorder threshold
+ */
+void SupplyStack::checkThreshold(const std::string& key, int before, int after, bool isType) const {
+    if (!alerts_enabled) return;
+    const int threshold = getReorderThreshold(key, isType);
+    if (threshold > 0 && before >= threshold && after < threshold) {
+        MessageHandler::warning("Low stock: " + key + " is down to " + std::to_string(after) +
+                                " available units (reorder threshold " + std::to_string(threshold) + ").");
+    }
+}
+
+// Earlier expiry date first, then batch ID so equal dates are deterministic
+bool SupplyStack::expiresBefore(int a, int b) const {
+    if (supplies[a].expiry_date != supplies[b].expiry_date) return supplies[a].expiry_date < supplies[b].expiry_date;
+    return supplies[a].supply_batch_id < supplies[b].supply_batch_id;
+}
+
+void SupplyStack::placeInHeap(ExpiryHeap& heap, int position, int slot) {
+    heap.slots[position] = slot;
+    heap_position[slot] = position;
+}
+
+void SupplyStack::siftUpInHeap(ExpiryHeap& heap, int position) {
+    const int slot = heap.slots[position];
+    while (position > 0) {
+        const int parent = (position - 1) / 2;
+        if (!expiresBefore(slot, heap.slots[parent])) break;
+        placeInHeap(heap, position, heap.slots[parent]);
+        position = parent;
+    }
+    placeInHeap(heap, position, slot);
+}
+
+void SupplyStack::siftDownInHeap(ExpiryHeap& heap, int position) {
+    const int slot = heap.slots[position];
+    while (true) {
+        int earliest = position * 2 + 1;
+        if (earliest >= heap.count) break;
+        if (earliest + 1 < heap.count && expiresBefore(heap.slots[earliest + 1], heap.slots[earliest])) earliest++;
+        if (!expiresBefore(heap.slots[earliest], slot)) break;
+        placeInHeap(heap, position, heap.slots[earliest]);
+        position = earliest;
+    }
+    placeInHeap(heap, position, slot);
+}
+
+/**
+ * @brief Puts a slot in its name's expiry heap, O(log batches); no-op if it is already there
+ */
+void SupplyStack::addToHeap(int slot) {
+    if (heap_position[slot] >= 0) return;
+    ExpiryHeap& heap = expiry_heaps.getOrInsert(supplies[slot].name);
+    if (heap.count == heap.capacity) {
+        const int grown = heap.capacity > 0 ? heap.capacity * 2 : 4;
+        int* slots = new int[grown];
+        for (int i = 0; i < heap.count; i++) slots[i] = heap.slots[i];
+        delete[] heap.slots;
+        heap.slots = slots;
+        heap.capacity = grown;
+    }
+    placeInHeap(heap, heap.count++, slot);
+    siftUpInHeap(heap, heap.count - 1);
+}
+
+/**
+ * @brief Takes a slot out of its name's expiry heap, O(log batches); no-op if it is not there
+ */
+void SupplyStack::removeFromHeap(int slot) {
+    const int position = heap_position[slot];
+    if (position < 0) return;
+    ExpiryHeap& heap = *expiry_heaps.find(supplies[slot].name);
+    heap_position[slot] = -1;
+    heap.count--;
+    if (position == heap.count) return;
+
+    // The last slot fills the hole and moves whichever way its expiry date requires
+    const int moved = heap.slots[heap.count];
+    placeInHeap(heap, position, moved);
+    siftUpInHeap(heap, position);
+    if (heap_position[moved] == position) siftDownInHeap(heap, position);
+}
@@ -0,0 +1,408 @@
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <climits>
+
+#include "medical_supply_manager.hpp"
+#include "message_handler.hpp"
+#include "string_utils.hpp"
+#include "stack.hpp"
+#include "path_utils.hpp"
+#include "durable_writer.hpp"
+#include "rollup_store.hpp"
+#include "supply_forecast.hpp"
+#include "time_utils.hpp"
+
+#define REORDER_THRESHOLDS_FILE "reorder_thresholds.csv"
+
+/**
+ * @brief Loads configured reorder thresholds from reorder_thresholds.csv
+ * @details The file is optional, keys without a row keep the default threshold
+ */
+void MedicalSupplyManager::loadReorderThresholds() {
+    std::ifstream file(getDataFilePath(REORDER_THRESHOLDS_FILE));
+    if (!file.is_open()) {
+        return;
+    }
+
+    std::string line;
+    std::getline(file, line); // Skip CSV header
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string key, thresholdStr;
+        if (!std::getline(ss, key, ',')) continue;
+        if (!std::getline(ss, thresholdStr, ',')) continue;
+
+        try {
+            stack.setReorderThreshold(trim(key), std::stoi(trim(thresholdStr)));
+        } catch (const std::exception&) {
+            MessageHandler::warning("Invalid reorder threshold for " + trim(key) + ". Using the default.");
+        }
+    }
+}
+
+/**
+ * @brief Writes every configured reorder threshold to reorder_thresholds.csv
+ */
+void MedicalSupplyManager::saveReorderThresholds() {
+    DurableWriter file(getDataFilePath(REORDER_THRESHOLDS_FILE)); // Replaces the file atomically on commit
+    if (!file.isOpen()) {
+        return;
+    }
+
+    file << "Key,Threshold\n";
+    stack.forEachReorderThreshold([&file](const std::string& key, int threshold) {
+        file << key << "," << threshold << "\n";
+    });
+    file.commit();
+}
+
+/**
+ * @brief Displays the stock levels menu
+ */
+void MedicalSupplyManager::displayStockLevelsMenu() {
+    int choice;
+    do {
+        std::cout << "\n--------------- STOCK LEVELS & REORDER ALERTS ---------------\n";
+        std::cout << "1. View Stock by Supply Name\n";
+        std::cout << "2. View Stock by Supply Type\n";
+        std::cout << "3. Set Reorder Threshold\n";
+        std::cout << "4. Depletion Forecast & Reorder List\n";
+        std::cout << "5. Back\n";
+        std::cout << "-------------------------------------------------------------\n";
+        std::cout << "Enter a number to perform an action: ";
+
+        if (!(std::cin >> choice)) {
+            std::cin.clear();
+            std::cin.ignore(1000, '\n');
+            MessageHandler::error("Invalid input. Please enter a number.");
+            continue;
+        }
+        std::cin.ignore();
+
+        switch (choice) {
+            case 1:
+                viewStockByName();
+                break;
+            case 2:
+                viewStockByType();
+                break;
+            case 3:
+                setReorderThreshold();
+                break;
+            case 4:
+                viewDepletionForecast();
+                break;
+            case 5:
+                break;
+            default:
+                MessageHandler::error("Invalid choice. Please select a valid option.");
+                break;
+        }
+    } while (choice != 5);
+}
+
+/**
+ * @brief Prints one stock level row, flagged red when below its reorder threshold
+ */
+static void printStockRow(const std::string& key, const SupplyTotal& total, int threshold) {
+    constexpr int wKey = 30, wBatches = 10, wAvailable = 12, wExpired = 10, wThreshold = 12;
+
+    std::cout << std::left
+              << std::setw(wKey) << key
+              << std::setw(wBatches) << total.batches
+              << std::setw(wAvailable) << total.available_units
+              << std::setw(wExpired) << total.expired_units
+              << std::setw(wThreshold) << (threshold > 0 ? std::to_string(threshold) : "-");
+
+    if (threshold > 0 && total.available_units < threshold) {
+        std::cout << "\033[31m" << "REORDER" << "\033[0m"; // Red
+    }
+    std::cout << "\n";
+}
+
+static void printStockHeader(const std::string& keyTitle) {
+    constexpr int wKey = 30, wBatches = 10, wAvailable = 12, wExpired = 10, wThreshold = 12;
+
+    std::cout << "\n" << std::left
+              << std::setw(wKey) << keyTitle
+              << std::setw(wBatches) << "Batches"
+              << std::setw(wAvailable) << "Available"
+              << std::setw(wExpired) << "Expired"
+              << std::setw(wThreshold) << "Threshold" << "\n";
+    std::cout << std::string(wKey + wBatches + wAvailable + wExpired + wThreshold + 8, '-') << "\n";
+}
+
+/**
+ * @brief Displays the running totals of every supply name, alphabetically
+ */
+void MedicalSupplyManager::viewStockByName() {
+    int count = 0;
+    stack.forEachNameTotal([&count](const std::string&, const SupplyTotal& total) {
+        if (total.batches > 0) count++;
+    });
+    if (count == 0) {
+        MessageHandler::info("No supplies in stock.");
+        return;
+    }
+
+    // Names are few compared to batches, an insertion sort keeps the listing stable
+    std::string* names = new std::string[count];
+    int filled = 0;
+    stack.forEachNameTotal([names, &filled](const std::string& name, const SupplyTotal& total) {
+        if (total.batches <= 0) return;
+        int i = filled++;
+        while (i > 0 && names[i - 1] > name) {
+            names[i] = names[i - 1];
+            i--;
+        }
+        names[i] = name;
+    });
+
+    printStockHeader("Supply Name");
+    for (int i = 0; i < count; i++) {
+        printStockRow(names[i], *stack.getTotalForName(names[i]), stack.getReorderThreshold(names[i], false));
+    }
+    delete[] names;
+}
+
+/**
+ * @brief Displays the running totals of each supply type
+ */
+void MedicalSupplyManager::viewStockByType() {
+    const std::string types[] = {"MED", "EQP", "PPE"};
+
+    printStockHeader("Supply Type");
+    for (const std::string& type : types) {
+        const SupplyTotal* total = stack.getTotalForType(type);
+        printStockRow(type, total ? *total : SupplyTotal{}, stack.getReorderThreshold(type, true));
+    }
+}
+
+/**
+ * @brief Prompts for a supply name or type and its new reorder threshold
+ */
+void MedicalSupplyManager::setReorderThreshold() {
+    std::string key, thresholdStr;
+    std::cout << "Supply name or type (MED/EQP/PPE): ";
+    std::getline(std::cin, key);
+    key = trim(key);
+    if (key.empty()) {
+        MessageHandler::info("Cancelled.");
+        return;
+    }
+
+    std::cout << "Reorder threshold in units (0 to disable): ";
+    std::getline(std::cin, thresholdStr);
+
+    int threshold;
+    try {
+        threshold = std::stoi(trim(thresholdStr));
+    } catch (const std::exception&) {
+        MessageHandler::error("Invalid threshold. Please enter a whole number.");
+        return;
+    }
+    if (threshold < 0) {
+        MessageHandler::error("Threshold cannot be negative.");
+        return;
+    }
+
+    stack.setReorderThreshold(key, threshold);
+    saveReorderThresholds();
+    MessageHandler::info("Reorder threshold for " + key + " set to " + std::to_string(threshold) + ".");
+
+    const bool isType = key == "MED" || key == "EQP" || key == "PPE";
+    const SupplyTotal* total = isType ? stack.getTotalForType(key) : stack.getTotalForName(key);
+    if (total && threshold > 0 && total->available_units < threshold) {
+        MessageHandler::warning("Low stock: " + key + " is already below the threshold with " +
+                                std::to_string(total->available_units) + " available units.");
+    }
+}
+
+/**
+ * @brief Seeds the usage rates from the daily supply burn rollup
+ * @details One pass over the rollup cells, the usage log itself is not read. Rows that arrive
+ * later are added by refreshSupplyUsageLog(). The rollup counts each usage row once since
+ * main() backfills it before any session can log usage, see RollupStore::load()
+ */
+void MedicalSupplyManager::seedUsageForecast() {
+    usage_forecast.clear();
+    RollupStore::instance().forEachCell(ROLLUP_SUPPLY_BURN,
+        [this](const std::string& day, const std::string& name, double units) {
+            usage_forecast.observe(name, SupplyForecaster::dayNumber(day), units);
+        });
+}
+
+/**
+ * @struct ForecastBatch
+ * @brief A non-expired batch, as the forecast consumes it
+ */
+struct ForecastBatch {
+    std::string name;
+    long long last_day; /// Last day the batch can be used, LLONG_MAX if its expiry is unreadable
+    int units;
+};
+
+/**
+ * @struct DepletionForecast
+ * @brief Outlook of one supply name
+ */
+struct DepletionForecast {
+    double units_per_day = 0.0;
+    int available_units = 0;     /// Non-expired units on the stack
+    double days_covered = 0.0;   /// Days until stock-out at the current rate
+    double expiring_unused = 0.0; /// Units that expire before they would be used
+    bool rated = false;
+};
+
+// Bottom-up merge sort by last usable day, stable so batches of one day keep stack order
+static void sortByLastDay(ForecastBatch* items, int count) {
+    ForecastBatch* temp = new ForecastBatch[count];
+    for (int runLength = 1; runLength < count; runLength *= 2) {
+        for (int left = 0; left < count - runLength; left += 2 * runLength) {
+            const int middle = left + runLength;
+            const int right = middle + runLength < count ? middle + runLength : count;
+            int i = left, j = middle, k = left;
+            while (i < middle && j < right) {
+                temp[k++] = items[j].last_day < items[i].last_day ? items[j++] : items[i++];
+            }
+            while (i < middle) temp[k++] = items[i++];
+            while (j < right) temp[k++] = items[j++];
+            for (k = left; k < right; k++) items[k] = temp[k];
+        }
+    }
+    delete[] temp;
+}
+
+/**
+ * @brief Displays days until stock-out per supply name and the items to reorder
+ *
+ * @details
+ * - Usage logged since the last look is picked up first, the rates are otherwise already current
+ * - Stock is used first-expiry-first-out at the item's rate: a batch that expires before its
+ *   turn, or before it is used up, leaves its remaining units unused and shortens the cover
+ * - Items that run out within FORECAST_LEAD_TIME_DAYS are listed with a suggested order that
+ *   covers the lead time plus FORECAST_COVER_DAYS
+ */
+void MedicalSupplyManager::viewDepletionForecast() {
+    refreshSupplyUsageLog();
+
+    const long long today = SupplyForecaster::today();
+    if (today < 0) {
+        MessageHandler::error("Unable to read the current date.");
+        return;
+    }
+
+    // Non-expired batches in the order they would be used
+    const int batchCount = stack.getTopIndex() + 1;
+    ForecastBatch* batches = new ForecastBatch[batchCount > 0 ? batchCount : 1];
+    int filled = 0;
+    for (int i = 0; i < batchCount; i++) {
+        const Supply supply = stack.getSupplyAt(i);
+        if (supply.quantity <= 0 || isDateExpired(supply.expiry_date)) continue;
+        const long long lastDay = SupplyForecaster::dayNumber(supply.expiry_date);
+        batches[filled++] = ForecastBatch{supply.name, lastDay < 0 ? LLONG_MAX : lastDay, supply.quantity};
+    }
+    sortByLastDay(batches, filled);
+
+    StringHashMap<DepletionForecast> forecasts;
+    for (int i = 0; i < filled; i++) {
+        DepletionForecast &forecast = forecasts.getOrInsert(batches[i].name);
+        if (!forecast.rated) {
+            forecast.units_per_day = usage_forecast.rateOn(batches[i].name, today);
+            forecast.rated = true;
+        }
+        forecast.available_units += batches[i].units;
+        if (forecast.units_per_day <= 0.0) continue;
+
+        const double daysToUse = batches[i].units / forecast.units_per_day;
+        if (batches[i].last_day == LLONG_MAX) {
+            forecast.days_covered += daysToUse;
+            continue;
+        }
+        const double window = static_cast<double>(batches[i].last_day - today + 1) - forecast.days_covered;
+        if (window <= 0.0) {
+            forecast.expiring_unused += batches[i].units;
+        } else if (daysToUse <= window) {
+            forecast.days_covered += daysToUse;
+        } else {
+            forecast.days_covered += window;
+            forecast.expiring_unused += batches[i].units - forecast.units_per_day * window;
+        }
+    }
+    delete[] batches;
+
+    // Names with no usable stock left still run out, alphabetically with the others
+    stack.forEachNameTotal([&forecasts, this, today](const std::string& name, const SupplyTotal&) {
+        DepletionForecast &forecast = forecasts.getOrInsert(name);
+        if (!forecast.rated) {
+            forecast.units_per_day = usage_forecast.rateOn(name, today);
+            forecast.rated = true;
+        }
+    });
+
+    const int count = forecasts.getSize();
+    if (count == 0) {
+        MessageHandler::info("No supplies in stock.");
+        return;
+    }
+    std::string* names = new std::string[count];
+    int sorted = 0;
+    forecasts.forEach([names, &sorted](const std::string& name, const DepletionForecast&) {
+        int i = sorted++;
+        while (i > 0 && names[i - 1] > name) {
+            names[i] = names[i - 1];
+            i--;
+        }
+        names[i] = name;
+    });
+
+    constexpr int wName = 30, wAvailable = 12, wRate = 12, wDays = 12, wDate = 14;
+    const long long todaySeconds = parseDatetime(getCurrentTimestamp().substr(0, 10));
+
+    std::cout << "\n" << std::left << std::setw(wName) << "Supply Name" << std::setw(wAvailable) << "Available"
+              << std::setw(wRate) << "Used/Day" << std::setw(wDays) << "Days Left" << std::setw(wDate) << "Stock-Out"
+              << "Expiring Unused\n";
+    std::cout << std::string(wName + wAvailable + wRate + wDays + wDate + 16, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    int reorders = 0;
+    for (int i = 0; i < count; i++) {
+        const DepletionForecast &forecast = *forecasts.find(names[i]);
+        std::cout << std::setw(wName) << names[i] << std::setw(wAvailable) << forecast.available_units;
+        if (forecast.units_per_day <= 0.0) {
+            std::cout << std::setw(wRate) << "-" << std::setw(wDays) << "-" << std::setw(wDate) << "-" << "-\n";
+            continue;
+        }
+
+        // Noon of the stock-out day, clear of daylight saving shifts around midnight
+        const long long stockOut = todaySeconds + static_cast<long long>(forecast.days_covered) * 86400 + 43200;
+        std::cout << std::setw(wRate) << forecast.units_per_day << std::setw(wDays) << forecast.days_covered
+                  << std::setw(wDate) << formatDatetime(stockOut).substr(0, 10)
+                  << std::ceil(forecast.expiring_unused) << "\n";
+        if (forecast.days_covered < FORECAST_LEAD_TIME_DAYS) reorders++;
+    }
+
+    std::cout << "\n=== Reorder List (stock-out within " << FORECAST_LEAD_TIME_DAYS << " days) ===\n";
+    if (reorders == 0) {
+        std::cout << "Nothing to reorder.\n";
+    } else {
+        std::cout << std::left << std::setw(wName) << "Supply Name" << std::setw(wDays) << "Days Left" << "Suggested Order\n";
+        std::cout << std::string(wName + wDays + 16, '-') << "\n";
+        for (int i = 0; i < count; i++) {
+            const DepletionForecast &forecast = *forecasts.find(names[i]);
+            if (forecast.units_per_day <= 0.0 || forecast.days_covered >= FORECAST_LEAD_TIME_DAYS) continue;
+            const double needed = forecast.units_per_day
+                * (FORECAST_LEAD_TIME_DAYS + FORECAST_COVER_DAYS - forecast.days_covered);
+            std::cout << std::setw(wName) << names[i] << std::setw(wDays) << forecast.days_covered
+                      << static_cast<long long>(std::ceil(needed)) << "\n";
+        }
+    }
+
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    delete[] names;
+}
@@ -0,0 +1,45 @@
+#include "supply_forecast.hpp"
+#include "time_utils.hpp"
+#include <cmath>
+
+SupplyForecaster::SupplyForecaster() : alpha(1.0 - std::pow(2.0, -1.0 / FORECAST_HALF_LIFE_DAYS)) {}
+
+double SupplyForecaster::decay(long long days) const {
+    return std::pow(1.0 - alpha, static_cast<double>(days));
+}
+
+void SupplyForecaster::observe(const std::string& name, long long day, double units) {
+    if (day < 0 || units <= 0) return;
+
+    const bool seen = rates.contains(name);
+    UsageRate &rate = rates.getOrInsert(name);
+    if (!seen) {
+        rate.day = day;
+    } else if (day > rate.day) {
+        // Bring the rate forward, the days in between count as days without usage
+        rate.units_per_day *= decay(day - rate.day);
+        rate.day = day;
+    }
+    rate.units_per_day += alpha * units * decay(rate.day - day);
+}
+
+double SupplyForecaster::rateOn(const std::string& name, long long day) const {
+    const UsageRate* rate = rates.find(name);
+    if (!rate) return 0.0;
+    return day > rate->day ? rate->units_per_day * decay(day - rate->day) : rate->units_per_day;
+}
+
+void SupplyForecaster::clear() {
+    rates.clear();
+}
+
+long long SupplyForecaster::dayNumber(const std::string& date) {
+    const long long seconds = parseDatetime(date.size() > 10 ? date.substr(0, 10) : date);
+    if (seconds < 0) return -1;
+    // Local midnight is a few hours off a UTC day boundary, half a day of margin rounds it onto one
+    return (seconds + 43200) / 86400;
+}
+
+long long SupplyForecaster::today() {
+    return dayNumber(getCurrentTimestamp());
+}
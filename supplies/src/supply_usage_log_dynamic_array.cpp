@@ -41,3 +41,11 @@ void SupplyUsageLogDynamicArray::setElementAt(int index, SupplyUsageLog value) {
         array[index] = value;
     }
 }
+
+void SupplyUsageLogDynamicArray::clearArray() {
+    size = 0;
+    capacity = 1;
+    SupplyUsageLog* newArray = new SupplyUsageLog[capacity];
+    delete[] array;
+    array = newArray;
+}
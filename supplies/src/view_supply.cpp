@@ -9,6 +9,8 @@
 #include "stack.hpp"
 #include "time_utils.hpp"
 #include "path_utils.hpp"
+#include "durable_writer.hpp"
+#include "rollup_store.hpp"
 
 /**
  * @brief Displays inventory menu
@@ -26,7 +28,8 @@ void MedicalSupplyManager::displayInventoryMenu() {
         std::cout << "7. View Supplies Expiring Soon\n";
         std::cout << "8. View Removed Supplies\n";
         std::cout << "9. View Supply Usage Log\n";
-        std::cout << "10. Back to Main Menu\n";
+        std::cout << "10. Search Supplies\n";
+        std::cout << "11. Back to Main Menu\n";
         std::cout << "----------------------------------------------------------\n";
         std::cout << "Enter a number to perform an action: ";
 
@@ -68,12 +71,220 @@ void MedicalSupplyManager::displayInventoryMenu() {
                 displaySupplyUsageLogMenu();
                 break;
             case 10:
+                searchSupplies();
+                break;
+            case 11:
                 break;
             default:
                 MessageHandler::error("Invalid choice. Please select a valid option.");
                 break;
         }
-    } while (choice != 10);
+    } while (choice != 11);
+}
+
+/**
+ * @brief Prints the column header shared by the supply inventory listings
+ */
+static void printSupplyHeader() {
+    constexpr int wBatchID = 20, wName = 25, wType = 15, wQuantity = 10,
+                  wStatus = 16, wSupplierName = 32, wTimestampAdded = 25, wExpiryDate = 18;
+
+    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
+    std::cout << std::left
+              << std::setw(wBatchID) << "Supply Batch ID"
+              << std::setw(wName) << "Name"
+              << std::setw(wType) << "Supply Type"
+              << std::setw(wQuantity) << "Quantity"
+              << std::setw(wStatus) << "Status"
+              << std::setw(wSupplierName) << "Supplier Name"
+              << std::setw(wTimestampAdded) << "Timestamp Added"
+              << std::setw(wExpiryDate) << "Expiry Date" << "\n";
+    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
+}
+
+/**
+ * @brief Prints one supply row with the status colored (Available green, Expired red)
+ */
+static void printSupplyRow(const Supply& s) {
+    constexpr int wBatchID = 20, wName = 25, wType = 15, wQuantity = 10,
+                  wStatus = 16, wSupplierName = 32, wTimestampAdded = 25, wExpiryDate = 18;
+
+    std::cout << std::left
+              << std::setw(wBatchID) << s.supply_batch_id
+              << std::setw(wName) << s.name
+              << std::setw(wType) << s.supply_type
+              << std::setw(wQuantity) << s.quantity;
+
+    if (s.status == "Available") {
+        std::cout << "\033[32m" << std::setw(wStatus) << s.status << "\033[0m"; // Green
+    } else if (s.status == "Expired") {
+        std::cout << "\033[31m" << std::setw(wStatus) << s.status << "\033[0m"; // Red
+    } else {
+        std::cout << std::setw(wStatus) << s.status; // No color
+    }
+
+    std::cout << std::setw(wSupplierName) << s.supplier_name
+              << std::setw(wTimestampAdded) << s.timestamp_added
+              << std::setw(wExpiryDate) << s.expiry_date << "\n";
+}
+
+/**
+ * @brief Builds the unique sort key of a supply for the given sort order
+ * @details The stack index is always the last component so keys are unique
+ */
+static std::string buildSupplySortKey(const Supply& s, int stackIndex, SupplySortKey sortKey) {
+    std::ostringstream oss;
+    // Newer supplies sit higher in the stack, so invert the index to list them first
+    oss << std::setw(7) << std::setfill('0') << (MAX_STACK_CAPACITY - stackIndex);
+    std::string order = oss.str();
+
+    switch (sortKey) {
+        case SORT_SUPPLIES_BY_EXPIRY:
+            return s.expiry_date + "|" + order;
+        case SORT_SUPPLIES_BY_NAME:
+            return toUpper(s.name) + "|" + order;
+        case SORT_SUPPLIES_NEWEST_FIRST:
+        default:
+            return order;
+    }
+}
+
+/**
+ * @brief Checks a supply against every filter of the query
+ */
+static bool supplyMatchesQuery(const Supply& s, const SupplyQuery& query) {
+    if (!query.status.empty() && toUpper(s.status) != toUpper(query.status)) return false;
+    if (!query.supply_type.empty() && toUpper(s.supply_type) != toUpper(query.supply_type)) return false;
+    if (!query.name.empty() && toUpper(s.name) != toUpper(query.name)) return false;
+    if (!query.expiry_from.empty() && s.expiry_date < query.expiry_from) return false;
+    if (!query.expiry_to.empty() && s.expiry_date > query.expiry_to) return false;
+    return true;
+}
+
+/**
+ * @brief Materializes one page of supplies sorted after the cursor
+ *
+ * @details
+ * Keyset pagination: one pass over the stack keeps only the best LIST_PAGE_SIZE
+ * candidates, so memory stays flat no matter how many supplies exist
+ */
+SupplyPage MedicalSupplyManager::querySupplies(const SupplyQuery& query, const std::string& cursor) const {
+    SupplyPage page;
+    std::string keys[LIST_PAGE_SIZE]; // Sort keys of the page items, kept in ascending order
+
+    // The cursor is "<sort key id>:<last key>", a cursor from another ordering restarts the listing
+    std::string sortPrefix = std::to_string(static_cast<int>(query.sort_key)) + ":";
+    std::string afterKey;
+    if (cursor.rfind(sortPrefix, 0) == 0) {
+        afterKey = cursor.substr(sortPrefix.size());
+    }
+
+    int matchesAfterCursor = 0;
+    for (int i = stack.getTopIndex(); i >= 0; --i) {
+        Supply s = stack.getSupplyAt(i);
+        if (!supplyMatchesQuery(s, query)) continue;
+
+        std::string key = buildSupplySortKey(s, i, query.sort_key);
+        if (!afterKey.empty() && key <= afterKey) continue;
+        matchesAfterCursor++;
+
+        // Bounded insertion: keep only the smallest LIST_PAGE_SIZE keys
+        if (page.count == LIST_PAGE_SIZE && key >= keys[page.count - 1]) continue;
+
+        int pos = (page.count < LIST_PAGE_SIZE) ? page.count : LIST_PAGE_SIZE - 1;
+        while (pos > 0 && keys[pos - 1] > key) {
+            keys[pos] = keys[pos - 1];
+            page.items[pos] = page.items[pos - 1];
+            pos--;
+        }
+        keys[pos] = key;
+        page.items[pos] = s;
+        if (page.count < LIST_PAGE_SIZE) page.count++;
+    }
+
+    page.has_more = matchesAfterCursor > page.count;
+    if (page.has_more) {
+        page.next_cursor = sortPrefix + keys[page.count - 1];
+    }
+    return page;
+}
+
+/**
+ * @brief Prints the query results one page at a time
+ */
+void MedicalSupplyManager::printSuppliesPaged(const SupplyQuery& query, const std::string& title) const {
+    std::string cursor;
+    int shown = 0;
+    while (true) {
+        SupplyPage page = querySupplies(query, cursor);
+        if (page.count == 0) break;
+
+        if (shown == 0) {
+            std::cout << "\n" << title << "\n";
+        }
+        printSupplyHeader();
+        for (int i = 0; i < page.count; ++i) {
+            printSupplyRow(page.items[i]);
+        }
+        shown += page.count;
+
+        if (!promptNextPage(page.has_more)) break;
+        cursor = page.next_cursor;
+    }
+
+    if (shown == 0) {
+        MessageHandler::info("No matching supplies found.");
+    }
+}
+
+/**
+ * @brief Prompts for filters and displays matching supplies page by page
+ */
+void MedicalSupplyManager::searchSupplies() {
+    if (stack.isStackEmpty()) {
+        MessageHandler::warning("No supplies available.");
+        return;
+    }
+
+    SupplyQuery query;
+    std::cout << "\nSEARCH SUPPLIES (leave a field empty to skip that filter)\n";
+
+    std::cout << "Status (Available/Expired): ";
+    std::getline(std::cin, query.status);
+    query.status = trim(query.status);
+
+    query.supply_type = getValidatedInput(
+        "Supply type (MED/EQP/PPE): ",
+        [](const std::string& input) {
+            std::string type = toUpper(trim(input));
+            return type.empty() || type == "MED" || type == "EQP" || type == "PPE";
+        },
+        "Invalid supply type. Must be MED, EQP, PPE or empty."
+    );
+    query.supply_type = trim(query.supply_type);
+
+    std::cout << "Supply name: ";
+    std::getline(std::cin, query.name);
+    query.name = trim(query.name);
+
+    std::cout << "Expiring from (YYYY-MM-DD): ";
+    std::getline(std::cin, query.expiry_from);
+    query.expiry_from = trim(query.expiry_from);
+
+    std::cout << "Expiring to (YYYY-MM-DD): ";
+    std::getline(std::cin, query.expiry_to);
+    query.expiry_to = trim(query.expiry_to);
+
+    std::string sortChoice = getValidatedInput(
+        "Sort by (1 = Newest, 2 = Expiry Date, 3 = Name): ",
+        [](const std::string& input) { return input == "1" || input == "2" || input == "3"; },
+        "Please enter 1, 2 or 3."
+    );
+    if (sortChoice == "2") query.sort_key = SORT_SUPPLIES_BY_EXPIRY;
+    else if (sortChoice == "3") query.sort_key = SORT_SUPPLIES_BY_NAME;
+    else query.sort_key = SORT_SUPPLIES_NEWEST_FIRST;
+
+    printSuppliesPaged(query, "SUPPLY SEARCH RESULTS");
 }
 
 void MedicalSupplyManager::viewExpiredSupply() {
@@ -192,61 +403,15 @@ void MedicalSupplyManager::viewMedicineSupply() {
         return;
     }
 
-    SupplyStack medicineStack;
-    bool found = false;
+    SupplyQuery query;
+    query.supply_type = "MED";
+    query.sort_key = SORT_SUPPLIES_NEWEST_FIRST;
 
-    for (int i = 0; i <= stack.getTopIndex(); ++i) {
-        Supply s = stack.getSupplyAt(i);
-        if (s.supply_type == "MED") {
-            medicineStack.push(s);
-            found = true;
-        }
-    }
-
-    if (!found) {
+    if (querySupplies(query, "").count == 0) {
         MessageHandler::info("No medicine supplies found.");
         return;
     }
-
-    std::cout << "\nMEDICINE SUPPLY INVENTORY\n";
-
-    constexpr int wBatchID = 20, wName = 25, wType = 15, wQuantity = 10,
-                  wStatus = 16, wSupplierName = 32, wTimestampAdded = 25, wExpiryDate = 18;
-
-    // Table header
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
-    std::cout << std::left
-              << std::setw(wBatchID) << "Supply Batch ID"
-              << std::setw(wName) << "Name"
-              << std::setw(wType) << "Supply Type"
-              << std::setw(wQuantity) << "Quantity"
-              << std::setw(wStatus) << "Status"
-              << std::setw(wSupplierName) << "Supplier Name"
-              << std::setw(wTimestampAdded) << "Timestamp Added"
-              << std::setw(wExpiryDate) << "Expiry Date" << "\n";
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
-
-    // Print each medicine supply
-    for (int i = medicineStack.getTopIndex(); i >= 0; --i) {
-        Supply s = medicineStack.getSupplyAt(i);
-        std::cout << std::left
-                  << std::setw(wBatchID) << s.supply_batch_id
-                  << std::setw(wName) << s.name
-                  << std::setw(wType) << s.supply_type
-                  << std::setw(wQuantity) << s.quantity;
-        
-        if (s.status == "Available") {
-            std::cout << "\033[32m" << std::setw(wStatus) << s.status << "\033[0m"; // Green
-        } else if (s.status == "Expired") {
-            std::cout << "\033[31m" << std::setw(wStatus) << s.status << "\033[0m"; // Red
-        } else {
-            std::cout << std::setw(wStatus) << s.status; // No color
-        }
-
-        std::cout << std::setw(wSupplierName) << s.supplier_name
-                  << std::setw(wTimestampAdded) << s.timestamp_added
-                  << std::setw(wExpiryDate) << s.expiry_date << "\n";
-    }
+    printSuppliesPaged(query, "MEDICINE SUPPLY INVENTORY");
 }
 
 void MedicalSupplyManager::viewEquipmentSupply() {
@@ -255,61 +420,15 @@ void MedicalSupplyManager::viewEquipmentSupply() {
         return;
     }
 
-    SupplyStack equipmentStack;
-    bool found = false;
-
-    for (int i = 0; i <= stack.getTopIndex(); ++i) {
-        Supply s = stack.getSupplyAt(i);
-        if (s.supply_type == "EQP") {
-            equipmentStack.push(s);
-            found = true;
-        }
-    }
+    SupplyQuery query;
+    query.supply_type = "EQP";
+    query.sort_key = SORT_SUPPLIES_NEWEST_FIRST;
 
-    if (!found) {
+    if (querySupplies(query, "").count == 0) {
         MessageHandler::info("No equipment supplies found.");
         return;
     }
-
-    std::cout << "\nEQUIPMENT SUPPLY INVENTORY\n";
-
-    constexpr int wBatchID = 20, wName = 25, wType = 15, wQuantity = 10,
-                  wStatus = 16, wSupplierName = 32, wTimestampAdded = 25, wExpiryDate = 18;
-
-    // Table header
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
-    std::cout << std::left
-              << std::setw(wBatchID) << "Supply Batch ID"
-              << std::setw(wName) << "Name"
-              << std::setw(wType) << "Supply Type"
-              << std::setw(wQuantity) << "Quantity"
-              << std::setw(wStatus) << "Status"
-              << std::setw(wSupplierName) << "Supplier Name"
-              << std::setw(wTimestampAdded) << "Timestamp Added"
-              << std::setw(wExpiryDate) << "Expiry Date" << "\n";
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
-
-    // Print each equipment supply
-    for (int i = equipmentStack.getTopIndex(); i >= 0; --i) {
-        Supply s = equipmentStack.getSupplyAt(i);
-        std::cout << std::left
-                  << std::setw(wBatchID) << s.supply_batch_id
-                  << std::setw(wName) << s.name
-                  << std::setw(wType) << s.supply_type
-                  << std::setw(wQuantity) << s.quantity;
-        
-        if (s.status == "Available") {
-            std::cout << "\033[32m" << std::setw(wStatus) << s.status << "\033[0m"; // Green
-        } else if (s.status == "Expired") {
-            std::cout << "\033[31m" << std::setw(wStatus) << s.status << "\033[0m"; // Red
-        } else {
-            std::cout << std::setw(wStatus) << s.status; // No color
-        }
-
-        std::cout << std::setw(wSupplierName) << s.supplier_name
-                  << std::setw(wTimestampAdded) << s.timestamp_added
-                  << std::setw(wExpiryDate) << s.expiry_date << "\n";
-    }
+    printSuppliesPaged(query, "EQUIPMENT SUPPLY INVENTORY");
 }
 
 void MedicalSupplyManager::viewPPESupply() {
@@ -318,61 +437,15 @@ void MedicalSupplyManager::viewPPESupply() {
         return;
     }
 
-    SupplyStack ppeStack;
-    bool found = false;
-
-    for (int i = 0; i <= stack.getTopIndex(); ++i) {
-        Supply s = stack.getSupplyAt(i);
-        if (s.supply_type == "PPE") {
-            ppeStack.push(s);
-            found = true;
-        }
-    }
+    SupplyQuery query;
+    query.supply_type = "PPE";
+    query.sort_key = SORT_SUPPLIES_NEWEST_FIRST;
 
-    if (!found) {
+    if (querySupplies(query, "").count == 0) {
         MessageHandler::info("No PPE supplies found.");
         return;
     }
-
-    std::cout << "\nPPE SUPPLY INVENTORY\n";
-
-    constexpr int wBatchID = 20, wName = 25, wType = 15, wQuantity = 10,
-                  wStatus = 16, wSupplierName = 32, wTimestampAdded = 25, wExpiryDate = 18;
-
-    // Table header
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
-    std::cout << std::left
-              << std::setw(wBatchID) << "Supply Batch ID"
-              << std::setw(wName) << "Name"
-              << std::setw(wType) << "Supply Type"
-              << std::setw(wQuantity) << "Quantity"
-              << std::setw(wStatus) << "Status"
-              << std::setw(wSupplierName) << "Supplier Name"
-              << std::setw(wTimestampAdded) << "Timestamp Added"
-              << std::setw(wExpiryDate) << "Expiry Date" << "\n";
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate, '-') << "\n";
-
-    // Print each PPE supply
-    for (int i = ppeStack.getTopIndex(); i >= 0; --i) {
-        Supply s = ppeStack.getSupplyAt(i);
-        std::cout << std::left
-                  << std::setw(wBatchID) << s.supply_batch_id
-                  << std::setw(wName) << s.name
-                  << std::setw(wType) << s.supply_type
-                  << std::setw(wQuantity) << s.quantity;
-        
-        if (s.status == "Available") {
-            std::cout << "\033[32m" << std::setw(wStatus) << s.status << "\033[0m"; // Green
-        } else if (s.status == "Expired") {
-            std::cout << "\033[31m" << std::setw(wStatus) << s.status << "\033[0m"; // Red
-        } else {
-            std::cout << std::setw(wStatus) << s.status; // No color
-        }
-
-        std::cout << std::setw(wSupplierName) << s.supplier_name
-                  << std::setw(wTimestampAdded) << s.timestamp_added
-                  << std::setw(wExpiryDate) << s.expiry_date << "\n";
-    }
+    printSuppliesPaged(query, "PPE SUPPLY INVENTORY");
 }
 
 void MedicalSupplyManager::viewToBeExpiredSupply() {
@@ -432,7 +505,7 @@ void MedicalSupplyManager::viewToBeExpiredSupply() {
 }
 
 /**
- * @brief Displays all supplies in the stack
+ * @brief Displays all supplies in the stack, newest first, one page at a time
  */
 void MedicalSupplyManager::viewAllSupply() {
     if (stack.isStackEmpty()) {
@@ -440,65 +513,9 @@ void MedicalSupplyManager::viewAllSupply() {
         return;
     }
 
-    std::cout << "\nCURRENT SUPPLY INVENTORY\n";
-
-    constexpr  int wBatchID = 20;
-    constexpr int wName    = 25;
-    constexpr int wType    = 15;
-    constexpr int wQuantity= 10;
-    // constexpr int wMaxCap  = 12;
-    constexpr int wStatus  = 16;
-    constexpr int wSupplierName= 32;
-    constexpr int wTimestampAdded= 25;
-    constexpr int wExpiryDate= 18;
-
-    std::cout << std::string(
-        wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate,
-        '-') << "\n";
-
-    // Print table header to match CSV header from add_supply.cpp
-    std::cout << std::left
-              << std::setw(wBatchID) << "Supply Batch ID"
-              << std::setw(wName)    << "Name"
-              << std::setw(wType)    << "Supply Type"
-              << std::setw(wQuantity)<< "Quantity"
-              // << std::setw(wMaxCap)  << "Max_Capacity"
-              << std::setw(wStatus)  << "Status"
-              << std::setw(wSupplierName)<< "Supplier Name"
-              << std::setw(wTimestampAdded)<< "Timestamp Added"
-              << std::setw(wExpiryDate)<< "Expiry Date"
-              << "\n";
-
-    // Print line separator
-    std::cout << std::string(
-        wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate,
-        '-') << "\n";
-
-    // Print each supply record from top (newest) to bottom (oldest)
-    for (int i = stack.getTopIndex(); i >= 0; --i) {
-        Supply s = stack.getSupplyAt(i);
-
-        std::cout << std::left
-                  << std::setw(wBatchID) << s.supply_batch_id
-                  << std::setw(wName)    << s.name
-                  << std::setw(wType)    << s.supply_type
-                  << std::setw(wQuantity)<< s.quantity;
-                  // << std::setw(wMaxCap)  << s.max_capacity;
-
-        // Apply color based on status
-        if (s.status == "Available") {
-            std::cout << "\033[32m" << std::setw(wStatus) << s.status << "\033[0m"; // Green
-        } else if (s.status == "Expired") {
-            std::cout << "\033[31m" << std::setw(wStatus) << s.status << "\033[0m"; // Red
-        } else {
-            std::cout << std::setw(wStatus) << s.status; // No color
-        }
-
-        std::cout << std::setw(wSupplierName)   << s.supplier_name
-                  << std::setw(wTimestampAdded) << s.timestamp_added
-                  << std::setw(wExpiryDate)     << s.expiry_date
-                  << "\n";
-    }
+    SupplyQuery query;
+    query.sort_key = SORT_SUPPLIES_NEWEST_FIRST;
+    printSuppliesPaged(query, "CURRENT SUPPLY INVENTORY");
 }
 
 void MedicalSupplyManager::viewRemovedSupplies() {
@@ -522,23 +539,34 @@ void MedicalSupplyManager::viewRemovedSupplies() {
     constexpr int wBatchID = 20, wName = 25, wType = 15, wQuantity = 10,
                   wStatus = 16, wSupplierName = 32, wTimestampAdded = 25, wExpiryDate = 18, wRemovedOn = 25;
 
-    // Table header
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate + wRemovedOn, '-') << "\n";
-    std::cout << std::left
-              << std::setw(wBatchID) << "Supply Batch ID"
-              << std::setw(wName) << "Name"
-              << std::setw(wType) << "Supply Type"
-              << std::setw(wQuantity) << "Quantity"
-              << std::setw(wStatus) << "Status"
-              << std::setw(wSupplierName) << "Supplier Name"
-              << std::setw(wTimestampAdded) << "Timestamp Added"
-              << std::setw(wExpiryDate) << "Expiry Date"
-              << std::setw(wRemovedOn) << "Removed On" << "\n";
-    std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate + wRemovedOn, '-') << "\n";
-
+    // Table header, repeated at the top of every page
+    auto printHeader = [&]() {
+        std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate + wRemovedOn, '-') << "\n";
+        std::cout << std::left
+                  << std::setw(wBatchID) << "Supply Batch ID"
+                  << std::setw(wName) << "Name"
+                  << std::setw(wType) << "Supply Type"
+                  << std::setw(wQuantity) << "Quantity"
+                  << std::setw(wStatus) << "Status"
+                  << std::setw(wSupplierName) << "Supplier Name"
+                  << std::setw(wTimestampAdded) << "Timestamp Added"
+                  << std::setw(wExpiryDate) << "Expiry Date"
+                  << std::setw(wRemovedOn) << "Removed On" << "\n";
+        std::cout << std::string(wBatchID + wName + wType + wQuantity + wStatus + wSupplierName + wTimestampAdded + wExpiryDate + wRemovedOn, '-') << "\n";
+    };
+    printHeader();
+
+    // Rows are streamed from the file, so only one page is ever held in memory
     bool found = false;
+    int rowsOnPage = 0;
     while (std::getline(file, line)) {
+        if (rowsOnPage == LIST_PAGE_SIZE) {
+            if (!promptNextPage(true)) break;
+            printHeader();
+            rowsOnPage = 0;
+        }
         found = true;
+        rowsOnPage++;
         std::stringstream ss(line);
         std::string field;
         
@@ -593,6 +621,8 @@ void MedicalSupplyManager::displaySupplyUsageLogMenu() {
 
         std::cin.ignore();
 
+        refreshSupplyUsageLog(); // Pick up usage logged by the ED officer since the last look
+
         switch (choice) {
             case 1:
                 viewAllSupplyUsageLog();
@@ -708,38 +738,39 @@ void MedicalSupplyManager::deductSupplyFromUsageLog() {
     for (int i = 0; i < usage_logs.getSize(); ++i) {
         SupplyUsageLog log = usage_logs.getElementAt(i);
         if (log.status == "Not Deducted") {
-            // Find the supply in the main stack and deduct
-            SupplyStack temp_stack;
+            // Find the supply in the main stack and deduct in place, the running totals follow
             bool supply_found = false;
 
-            while(!stack.isStackEmpty()){
-                Supply s = stack.pop();
+            for (int j = 0; j <= stack.getTopIndex(); ++j) {
+                Supply s = stack.getSupplyAt(j);
                 if (s.supply_batch_id == log.supply_batch_id) {
                     supply_found = true;
                     if (s.quantity >= log.quantity_used) {
-                        s.quantity -= log.quantity_used;
+                        stack.setQuantityAt(j, s.quantity - log.quantity_used);
+                        if (log.quantity_used != 0) {
+                            supplies_dirty = true;
+                            RollupStore::instance().add(ROLLUP_SUPPLY_DEDUCTED, RollupStore::todayBucket(), log.supply_name, log.quantity_used);
+                        }
                     } else {
                         MessageHandler::error("Not enough quantity to deduct for " + s.name + ". Skipping.");
                     }
                 }
-                temp_stack.push(s);
-            }
-
-            while(!temp_stack.isStackEmpty()){
-                stack.push(temp_stack.pop());
             }
 
             if(supply_found){
                  // Update the usage log status
                 log.status = "Deducted";
                 usage_logs.setElementAt(i, log);
+                usage_log_dirty = true;
             }
         }
     }
 
-    // Save both files
+    // Save whichever files changed, published by one group commit, each file atomically
+    DurableWriter::beginGroup();
     saveToCSV("medical_supply.csv");
     saveSupplyUsageLog();
+    DurableWriter::commitGroup();
 
     MessageHandler::info("All non-deducted logs have been processed.");
 }
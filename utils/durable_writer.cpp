@@ -0,0 +1,259 @@
+#include <filesystem>
+#include <system_error>
+
+#include "config.hpp"
+#include "durable_writer.hpp"
+#include "dynamic_array.hpp"
+#include "message_handler.hpp"
+
+#ifdef OS_WINDOWS
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr size_t WRITE_BUFFER_SIZE = 1 << 20; // 1 MiB, a typical dataset is written in a handful of syscalls
+
+    int groupDepth = 0; // Nesting level of beginGroup()/commitGroup()
+
+    // Final paths whose temp files are waiting for the outermost commitGroup()
+    DynamicArray& stagedPaths() {
+        static DynamicArray paths;
+        return paths;
+    }
+
+    // Drops a path whose staged temp file is no longer valid, the group keeps its previous file
+    void unstage(const std::string& path) {
+        DynamicArray& staged = stagedPaths();
+        DynamicArray kept;
+        for (int i = 0; i < staged.getSize(); i++) {
+            if (staged.getElementAt(i) != path) kept.appendArray(staged.getElementAt(i));
+        }
+        staged.clearArray();
+        for (int i = 0; i < kept.getSize(); i++) staged.appendArray(kept.getElementAt(i));
+    }
+
+    // Flushes stdio buffers and forces the file contents to stable storage
+    bool syncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef OS_WINDOWS
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // Re-opens a closed file just to fsync it
+    bool syncPath(const std::string& path) {
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        if (!file) return false;
+        bool ok = syncFile(file);
+        std::fclose(file);
+        return ok;
+    }
+
+    // Makes a rename inside the directory durable (no-op where directories cannot be synced)
+    void syncDirectory(const fs::path& directory) {
+#ifndef OS_WINDOWS
+        int fd = open(directory.empty() ? "." : directory.string().c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            close(fd);
+        }
+#else
+        (void)directory;
+#endif
+    }
+
+    // Atomically replaces path with its temp file
+    bool publish(const std::string& tempPath, const std::string& path) {
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec) {
+            MessageHandler::error("Failed to replace " + path + ": " + ec.message());
+            return false;
+        }
+        return true;
+    }
+}
+
+DurableWriter::DurableWriter(const std::string& filePath)
+    : path(filePath), temp_path(filePath + ".tmp"), file(nullptr), buffer(nullptr), failed(false), finished(false), written(0) {
+    file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        MessageHandler::error("Failed to open " + temp_path + " for writing.");
+        failed = true;
+        return;
+    }
+    buffer = new char[WRITE_BUFFER_SIZE];
+    std::setvbuf(file, buffer, _IOFBF, WRITE_BUFFER_SIZE);
+}
+
+DurableWriter::~DurableWriter() {
+    if (!finished) {
+        // Never committed, leave the original file untouched
+        closeFile();
+        std::error_code ec;
+        fs::remove(temp_path, ec);
+    }
+    delete[] buffer;
+}
+
+bool DurableWriter::isOpen() const {
+    return file != nullptr && !failed;
+}
+
+void DurableWriter::write(const char* data, size_t length) {
+    if (!file || failed) return;
+    if (std::fwrite(data, 1, length, file) != length) {
+        failed = true;
+        return;
+    }
+    written += length;
+}
+
+void DurableWriter::closeFile() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+DurableWriter& DurableWriter::operator<<(const std::string& value) {
+    write(value.data(), value.size());
+    return *this;
+}
+
+DurableWriter& DurableWriter::operator<<(const char* value) {
+    write(value, std::char_traits<char>::length(value));
+    return *this;
+}
+
+DurableWriter& DurableWriter::operator<<(char value) {
+    write(&value, 1);
+    return *this;
+}
+
+bool DurableWriter::commit() {
+    if (finished) return !failed;
+    finished = true;
+
+    if (!file || failed) {
+        MessageHandler::error("Failed to write " + path + ". The previous file was kept.");
+        closeFile();
+        if (groupDepth > 0) unstage(path);
+        std::error_code ec;
+        fs::remove(temp_path, ec);
+        return false;
+    }
+
+    if (groupDepth > 0) {
+        // Staged: the data is in the temp file, durability and rename happen at commitGroup()
+        if (std::fflush(file) != 0) failed = true;
+        closeFile();
+        if (failed) {
+            MessageHandler::error("Failed to write " + path + ". The previous file was kept.");
+            unstage(path); // An earlier save of this file in the group was overwritten by the torn one
+            std::error_code ec;
+            fs::remove(temp_path, ec);
+            return false;
+        }
+        if (!stagedPaths().isInArray(path)) {
+            stagedPaths().appendArray(path);
+        }
+        return true;
+    }
+
+    bool synced = syncFile(file);
+    closeFile();
+    if (!synced) {
+        MessageHandler::error("Failed to flush " + temp_path + " to disk. The previous file was kept.");
+        return false;
+    }
+
+    if (!publish(temp_path, path)) return false;
+    syncDirectory(fs::path(path).parent_path());
+    return true;
+}
+
+void DurableWriter::beginGroup() {
+    groupDepth++;
+}
+
+bool DurableWriter::commitGroup() {
+    if (groupDepth == 0) return true;
+    groupDepth--;
+    if (groupDepth > 0) return true;
+
+    DynamicArray& staged = stagedPaths();
+    DynamicArray directories;
+    bool ok = true;
+
+    for (int i = 0; i < staged.getSize(); i++) {
+        std::string target = staged.getElementAt(i);
+        std::string tempPath = target + ".tmp";
+
+        if (!syncPath(tempPath)) {
+            MessageHandler::error("Failed to flush " + tempPath + " to disk. The previous file was kept.");
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            ok = false;
+            continue;
+        }
+        if (!publish(tempPath, target)) {
+            ok = false;
+            continue;
+        }
+
+        std::string directory = fs::path(target).parent_path().string();
+        if (!directories.isInArray(directory)) {
+            directories.appendArray(directory.empty() ? "." : directory);
+        }
+    }
+
+    // One directory sync covers every rename in that directory
+    for (int i = 0; i < directories.getSize(); i++) {
+        syncDirectory(directories.getElementAt(i));
+    }
+
+    staged.clearArray();
+    return ok;
+}
+
+bool appendDurably(const std::string& path, const std::string& text) {
+    bool needsNewline = false;
+    {
+        std::FILE* existing = std::fopen(path.c_str(), "rb");
+        if (existing) {
+            if (std::fseek(existing, -1, SEEK_END) == 0) {
+                needsNewline = std::fgetc(existing) != '\n';
+            }
+            std::fclose(existing);
+        }
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    if (!file) return false;
+
+    bool ok = true;
+    if (needsNewline && std::fputc('\n', file) == EOF) ok = false;
+    if (ok && std::fwrite(text.data(), 1, text.size(), file) != text.size()) ok = false;
+    if (ok && !syncFile(file)) ok = false;
+    std::fclose(file);
+    return ok;
+}
+
+bool overwriteDurably(const std::string& path, unsigned long long offset, const std::string& text) {
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    if (!file) return false;
+
+    bool ok = std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+    if (ok && std::fwrite(text.data(), 1, text.size(), file) != text.size()) ok = false;
+    if (ok && !syncFile(file)) ok = false;
+    std::fclose(file);
+    return ok;
+}
@@ -0,0 +1,128 @@
+#ifndef DURABLE_WRITER_HPP
+#define DURABLE_WRITER_HPP
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief Crash-safe file writing shared by every CSV writer
+ *
+ * @details
+ * - A DurableWriter streams into "<path>.tmp" through a large stdio buffer
+ * - commit() flushes and fsyncs the temp file, renames it over the original and fsyncs
+ *   the parent directory, so readers only ever see the old or the new file, never a torn one
+ * - Between beginGroup() and commitGroup(), commits are staged instead: repeated saves of the
+ *   same file overwrite the same temp file, and the fsync/rename work happens once at commitGroup()
+ * - Each file of a group is replaced atomically, the group as a whole is not: the files are
+ *   renamed one after another, so a failure or crash partway through commitGroup() can leave
+ *   some of them published and the others at their previous content
+ * - Every failure is reported here, once, through MessageHandler; callers only check the result
+ * - appendDurably() is the append-only counterpart for log style files
+ *
+ * @usage
+ *      DurableWriter file(filePath);
+ *      file << "Header\n";
+ *      file << value << "," << other << "\n";
+ *      if (!file.commit()) { ...the original file is left untouched... }
+ */
+class DurableWriter {
+private:
+    std::string path;       /// Final destination
+    std::string temp_path;  /// "<path>.tmp", renamed over path on commit
+    std::FILE* file;
+    char* buffer;           /// Large stdio buffer so rows are written in big chunks
+    bool failed;
+    bool finished;
+    unsigned long long written; /// Bytes written so far
+    std::ostringstream scratch; /// Formats non-string values exactly like std::ostream does
+
+    void write(const char* data, size_t length);
+    void closeFile();
+
+public:
+    /**
+     * @brief Opens "<path>.tmp" for writing
+     * @param filePath The file that will be replaced on commit
+     */
+    explicit DurableWriter(const std::string& filePath);
+
+    /**
+     * @brief Discards the temp file if commit() was never called
+     */
+    ~DurableWriter();
+
+    DurableWriter(const DurableWriter&) = delete;
+    DurableWriter& operator=(const DurableWriter&) = delete;
+
+    /**
+     * @brief Checks if the temp file was opened successfully
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Number of bytes the file will contain once committed
+     */
+    unsigned long long bytesWritten() const { return written; }
+
+    DurableWriter& operator<<(const std::string& value);
+    DurableWriter& operator<<(const char* value);
+    DurableWriter& operator<<(char value);
+
+    template <typename T>
+    DurableWriter& operator<<(const T& value) {
+        scratch.str("");
+        scratch << value;
+        const std::string formatted = scratch.str();
+        write(formatted.data(), formatted.size());
+        return *this;
+    }
+
+    /**
+     * @brief Makes the new content durable and visible
+     * @return true if the file was replaced (or staged inside a group), false on any I/O error
+     */
+    bool commit();
+
+    /**
+     * @brief Starts coalescing commits until the matching commitGroup()
+     * @details Groups may be nested, only the outermost commitGroup() publishes the files
+     */
+    static void beginGroup();
+
+    /**
+     * @brief Publishes every file staged since beginGroup(), one rename per file
+     * @return true if all staged files were replaced successfully. On false, the files that
+     *         failed kept their previous content and the others were still published
+     */
+    static bool commitGroup();
+};
+
+/**
+ * @brief Appends text to a file and fsyncs it before returning
+ *
+ * @details
+ * If the file does not end with a newline, one is inserted first so the appended
+ * text always starts on its own line
+ *
+ * @param path File to append to (created if missing)
+ * @param text Text to append, normally one or more complete CSV lines
+ * @return true if the text reached stable storage, callers report failures in their own words
+ */
+bool appendDurably(const std::string& path, const std::string& text);
+
+/**
+ * @brief Overwrites bytes in place at a given offset and fsyncs the file before returning
+ *
+ * @details
+ * Only for fixed-width fields that were reserved when the row was written, the file size
+ * never changes
+ *
+ * @param path Existing file
+ * @param offset Byte offset of the first byte to replace
+ * @param text Replacement bytes, must not run past the reserved field
+ * @return true if the bytes reached stable storage
+ */
+bool overwriteDurably(const std::string& path, unsigned long long offset, const std::string& text);
+
+#endif // DURABLE_WRITER_HPP
@@ -47,10 +47,9 @@ void DynamicArray::appendArray(std::string inputString) {
     if (capacity == size) {
         growArray();
     }
-    if (inputString.length() > 0) {
-        array[size] = inputString;
-        size++;
-    }
+    // Empty strings are kept, split() relies on them to leave blank CSV fields in their column
+    array[size] = inputString;
+    size++;
 }
 
 void DynamicArray::popArray() {
@@ -118,7 +118,7 @@ struct Ambulance {
     int medicine_units;
     std::string last_service_date;
     std::string location;
-    DynamicArray shift_history;
+    int latest_shift_index = -1; /// Newest shift of this ambulance in the dispatcher's shift log, -1 if none
 };
 
 
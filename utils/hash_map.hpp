@@ -0,0 +1,165 @@
+#ifndef HASH_MAP_HPP
+#define HASH_MAP_HPP
+
+#include <string>
+
+/**
+ * @brief Separate-chaining hash map keyed by std::string
+ *
+ * @details
+ * - Keys are hashed with FNV-1a, the bucket table doubles once the load factor passes 0.75
+ * - Entries are individually allocated and never move when the table grows, so pointers
+ *   returned by find() stay valid until that key is erased
+ * - Header-only because it is a template; V must be default-constructible and copyable
+ *
+ * @usage
+ *      StringHashMap<Node*> index;
+ *      index.insertOrAssign("PAT-0001", node);
+ *      if (Node** found = index.find("PAT-0001")) { ... }
+ *      index.erase("PAT-0001");
+ */
+template <typename V>
+class StringHashMap {
+private:
+    struct Entry {
+        std::string key;
+        V value;
+        Entry* next;
+    };
+
+    Entry** buckets;
+    int bucketCount;
+    int size;
+
+    static unsigned long long hashKey(const std::string& key) {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (unsigned char c : key) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    int bucketOf(const std::string& key) const {
+        return static_cast<int>(hashKey(key) % static_cast<unsigned long long>(bucketCount));
+    }
+
+    void rehash(int newBucketCount) {
+        Entry** newBuckets = new Entry*[newBucketCount]();
+        for (int i = 0; i < bucketCount; i++) {
+            Entry* entry = buckets[i];
+            while (entry) {
+                Entry* next = entry->next;
+                int target = static_cast<int>(hashKey(entry->key) % static_cast<unsigned long long>(newBucketCount));
+                entry->next = newBuckets[target];
+                newBuckets[target] = entry;
+                entry = next;
+            }
+        }
+        delete[] buckets;
+        buckets = newBuckets;
+        bucketCount = newBucketCount;
+    }
+
+public:
+    explicit StringHashMap(int initialBuckets = 16)
+        : buckets(nullptr), bucketCount(initialBuckets > 0 ? initialBuckets : 16), size(0) {
+        buckets = new Entry*[bucketCount]();
+    }
+
+    ~StringHashMap() {
+        clear();
+        delete[] buckets;
+    }
+
+    StringHashMap(const StringHashMap&) = delete;
+    StringHashMap& operator=(const StringHashMap&) = delete;
+
+    int getSize() const { return size; }
+
+    /**
+     * @brief Returns a pointer to the value stored for key, or nullptr if absent
+     */
+    V* find(const std::string& key) {
+        Entry* entry = buckets[bucketOf(key)];
+        while (entry) {
+            if (entry->key == key) return &entry->value;
+            entry = entry->next;
+        }
+        return nullptr;
+    }
+
+    const V* find(const std::string& key) const {
+        return const_cast<StringHashMap*>(this)->find(key);
+    }
+
+    bool contains(const std::string& key) const {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Returns the value for key, inserting a default-constructed one if absent
+     */
+    V& getOrInsert(const std::string& key) {
+        if (V* existing = find(key)) return *existing;
+
+        if ((size + 1) * 4 > bucketCount * 3) {
+            rehash(bucketCount * 2);
+        }
+        int bucket = bucketOf(key);
+        Entry* entry = new Entry{key, V(), buckets[bucket]};
+        buckets[bucket] = entry;
+        size++;
+        return entry->value;
+    }
+
+    void insertOrAssign(const std::string& key, const V& value) {
+        getOrInsert(key) = value;
+    }
+
+    /**
+     * @brief Removes key
+     * @return true if the key was present
+     */
+    bool erase(const std::string& key) {
+        Entry** link = &buckets[bucketOf(key)];
+        while (*link) {
+            if ((*link)->key == key) {
+                Entry* removed = *link;
+                *link = removed->next;
+                delete removed;
+                size--;
+                return true;
+            }
+            link = &(*link)->next;
+        }
+        return false;
+    }
+
+    void clear() {
+        for (int i = 0; i < bucketCount; i++) {
+            Entry* entry = buckets[i];
+            while (entry) {
+                Entry* next = entry->next;
+                delete entry;
+                entry = next;
+            }
+            buckets[i] = nullptr;
+        }
+        size = 0;
+    }
+
+    /**
+     * @brief Calls visit(key, value) for every entry, in no particular order
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (int i = 0; i < bucketCount; i++) {
+            for (Entry* entry = buckets[i]; entry; entry = entry->next) {
+                visit(entry->key, entry->value);
+            }
+        }
+    }
+};
+
+#endif // HASH_MAP_HPP
@@ -0,0 +1,97 @@
+#include <fstream>
+#include <sstream>
+
+#include "id_allocator.hpp"
+#include "durable_writer.hpp"
+#include "message_handler.hpp"
+#include "path_utils.hpp"
+#include "string_utils.hpp"
+
+IdAllocator::IdAllocator() : loaded(false) {}
+
+IdAllocator& IdAllocator::instance() {
+    static IdAllocator allocator;
+    return allocator;
+}
+
+// Reads the sidecar on first use, the data root is settled by then
+void IdAllocator::loadLocked() {
+    if (loaded) return;
+    loaded = true;
+    path = getDataFilePath(ID_SEQUENCE_FILE);
+
+    std::ifstream file(path);
+    if (!file.is_open()) return; // First run, datasets seed the namespaces through observe()
+
+    std::string line;
+    std::getline(file, line); // Skip CSV header
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string name, highWater;
+        if (!std::getline(ss, name, ',') || !std::getline(ss, highWater)) continue;
+
+        try {
+            const long long value = std::stoll(trim(highWater));
+            long long &issued = highWaters.getOrInsert(trim(name));
+            if (value > issued) issued = value;
+        } catch (const std::exception&) {
+            MessageHandler::warning("Skipping malformed row in " + path + ": " + line);
+        }
+    }
+}
+
+bool IdAllocator::persistLocked() {
+    if (path.empty()) return false;
+
+    DurableWriter file(path); // Replaces the file atomically on commit
+    if (!file.isOpen()) return false;
+    file << "Namespace,High_Water\n";
+    highWaters.forEach([&file](const std::string& name, long long issued) {
+        file << name << "," << issued << "\n";
+    });
+    return file.commit();
+}
+
+long long IdAllocator::next(const std::string& name) {
+    return reserve(name, 1);
+}
+
+long long IdAllocator::reserve(const std::string& name, long long count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    loadLocked();
+    long long &issued = highWaters.getOrInsert(name);
+    const long long first = issued + 1;
+    if (count < 1) return first; // Empty block, nothing claimed
+
+    issued += count;
+    if (!persistLocked()) {
+        // The datasets still record every ID handed out, observe() catches up on the next load
+        MessageHandler::warning("Could not save ID sequences to " + path + ".");
+    }
+    return first;
+}
+
+void IdAllocator::observe(const std::string& name, long long value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    loadLocked();
+    long long &issued = highWaters.getOrInsert(name);
+    if (value > issued) issued = value;
+}
+
+void IdAllocator::observeId(const std::string& name, const std::string& id) {
+    if (id.size() <= name.size() + 1 || id.size() > name.size() + 19) return; // 18 digits always fit a long long
+    if (id.compare(0, name.size(), name) != 0 || id[name.size()] != '-') return;
+
+    long long value = 0;
+    for (std::string::size_type i = name.size() + 1; i < id.size(); i++) {
+        if (id[i] < '0' || id[i] > '9') return; // Not a generated ID, it cannot collide with one
+        value = value * 10 + (id[i] - '0');
+    }
+    observe(name, value);
+}
+
+std::string IdAllocator::format(const std::string& name, long long number, int width) {
+    std::string digits = std::to_string(number);
+    if (static_cast<int>(digits.size()) < width) digits.insert(0, width - digits.size(), '0');
+    return name + "-" + digits;
+}
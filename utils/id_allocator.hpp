@@ -0,0 +1,79 @@
+#ifndef ID_ALLOCATOR_HPP
+#define ID_ALLOCATOR_HPP
+
+#include <mutex>
+#include <string>
+#include "hash_map.hpp"
+
+#define ID_SEQUENCE_FILE "id_sequences.csv"
+
+// Namespaces double as the ID prefixes: PAT-0001, CASE-3351, SHIFT-2001
+#define PATIENT_ID_NAMESPACE "PAT"
+#define CASE_ID_NAMESPACE "CASE"
+#define SHIFT_ID_NAMESPACE "SHIFT"
+
+/**
+ * @brief Hands out monotonic numeric IDs per namespace, never reusing one across runs
+ *
+ * @details
+ * - Each namespace keeps a high-water mark, the last number issued, persisted in id_sequences.csv
+ *   (Namespace,High_Water) in the data root. The mark is written durably before the numbers are
+ *   returned, so a crash can only skip numbers, never repeat them, and a restart resumes above it
+ * - reserve() claims a whole block for bulk inserts with one counter bump and one sidecar write,
+ *   whatever its size
+ * - observe() raises a namespace past IDs already present in a dataset (files written before the
+ *   sidecar existed, or edited by hand), callers feed it the IDs they load
+ * - All calls are serialized by a mutex and safe from any thread
+ *
+ * @usage
+ *      IdAllocator &ids = IdAllocator::instance();
+ *      ids.observeId(PATIENT_ID_NAMESPACE, "PAT-0257");                            // While loading
+ *      std::string id = IdAllocator::format(PATIENT_ID_NAMESPACE, ids.next(PATIENT_ID_NAMESPACE), 4); // "PAT-0258"
+ *      long long first = ids.reserve(SHIFT_ID_NAMESPACE, 42);                      // first .. first + 41
+ */
+class IdAllocator {
+private:
+    StringHashMap<long long> highWaters; /// Namespace -> last number handed out or observed
+    std::mutex mutex;
+    std::string path;
+    bool loaded;
+
+    IdAllocator();
+
+    void loadLocked();
+    bool persistLocked();
+
+public:
+    IdAllocator(const IdAllocator&) = delete;
+    IdAllocator& operator=(const IdAllocator&) = delete;
+
+    static IdAllocator& instance();
+
+    /**
+     * @brief Returns the next number of a namespace
+     */
+    long long next(const std::string& name);
+
+    /**
+     * @brief Claims count consecutive numbers
+     * @return The first number of the block, the block is [first, first + count)
+     */
+    long long reserve(const std::string& name, long long count);
+
+    /**
+     * @brief Makes sure numbers up to value are never handed out
+     */
+    void observe(const std::string& name, long long value);
+
+    /**
+     * @brief observe() for a formatted ID such as "PAT-0042", IDs with another prefix are ignored
+     */
+    void observeId(const std::string& name, const std::string& id);
+
+    /**
+     * @brief Builds "<name>-<number>", the number zero padded to width digits
+     */
+    static std::string format(const std::string& name, long long number, int width = 0);
+};
+
+#endif // ID_ALLOCATOR_HPP
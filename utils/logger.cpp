@@ -0,0 +1,271 @@
+#include "logger.hpp"
+#include "config.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <utility>
+
+#define LOG_WORKER_IDLE_MS 50 // Upper bound on how long a missed wake-up can delay the sinks
+
+static_assert((LOG_RING_CAPACITY & (LOG_RING_CAPACITY - 1)) == 0, "LOG_RING_CAPACITY must be a power of two");
+
+static const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error: return "ERROR";
+        default: return "OFF";
+    }
+}
+
+// "YYYY-MM-DD HH:MM:SS.mmm" in local time
+static std::string formatTimestamp(long long timestampMs) {
+    const std::time_t seconds = static_cast<std::time_t>(timestampMs / 1000);
+    std::tm tmStruct{};
+#ifdef OS_WINDOWS
+    localtime_s(&tmStruct, &seconds);
+#else
+    localtime_r(&seconds, &tmStruct);
+#endif
+    char buffer[32];
+    const std::size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tmStruct);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%03d", static_cast<int>(timestampMs % 1000));
+    return buffer;
+}
+
+// Escapes a message for a JSON string literal
+static std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size() + 8);
+    for (unsigned char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", c);
+                    escaped += code;
+                } else {
+                    escaped += static_cast<char>(c);
+                }
+        }
+    }
+    return escaped;
+}
+
+Logger::Logger()
+    : ring(new Slot[LOG_RING_CAPACITY]), enqueuePos(0), dequeuePos(0), drained(0), accepted(0), dropped(0),
+      consoleLevel(LogLevel::Info), fileLevel(LogLevel::Off), jsonlLevel(LogLevel::Off),
+      stopping(false), workerSleeping(false) {
+    for (std::size_t i = 0; i < LOG_RING_CAPACITY; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    configureFromEnvironment();
+}
+
+Logger::~Logger() {
+    if (worker.joinable()) {
+        stopping.store(true);
+        wakeUp.notify_one();
+        worker.join(); // The worker drains the ring before it returns
+    }
+    if (dropped.load() > 0) {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        const std::string note = std::to_string(dropped.load()) + " log messages dropped, the log ring was full";
+        if (fileSink.is_open()) fileSink << note << "\n";
+    }
+    delete[] ring;
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+bool Logger::parseLevel(const std::string& name, LogLevel& level) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "debug") level = LogLevel::Debug;
+    else if (lower == "info") level = LogLevel::Info;
+    else if (lower == "warning" || lower == "warn") level = LogLevel::Warning;
+    else if (lower == "error") level = LogLevel::Error;
+    else if (lower == "off" || lower == "none") level = LogLevel::Off;
+    else return false;
+    return true;
+}
+
+void Logger::configureFromEnvironment() {
+    const char* level = std::getenv(LOG_LEVEL_ENV_VAR);
+    if (level != nullptr && *level != '\0') {
+        LogLevel parsed;
+        if (parseLevel(level, parsed)) consoleLevel = parsed;
+    }
+
+    const char* filePath = std::getenv(LOG_FILE_ENV_VAR);
+    if (filePath != nullptr && *filePath != '\0') openFile(filePath);
+
+    const char* jsonlPath = std::getenv(LOG_JSONL_ENV_VAR);
+    if (jsonlPath != nullptr && *jsonlPath != '\0') openJsonl(jsonlPath);
+}
+
+bool Logger::openFile(const std::string& path, LogLevel level) {
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        if (fileSink.is_open()) fileSink.close();
+        fileSink.open(path, std::ios::app);
+        if (!fileSink.is_open()) return false;
+    }
+    fileLevel.store(level);
+    startWorker();
+    return true;
+}
+
+bool Logger::openJsonl(const std::string& path, LogLevel level) {
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        if (jsonlSink.is_open()) jsonlSink.close();
+        jsonlSink.open(path, std::ios::app);
+        if (!jsonlSink.is_open()) return false;
+    }
+    jsonlLevel.store(level);
+    startWorker();
+    return true;
+}
+
+void Logger::startWorker() {
+    if (worker.joinable()) return;
+    worker = std::thread([this]() {
+        while (!stopping.load()) {
+            drain();
+
+            // Producers notify only when they see the flag, the timeout covers a wake-up lost in between
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            workerSleeping.store(true);
+            wakeUp.wait_for(lock, std::chrono::milliseconds(LOG_WORKER_IDLE_MS));
+            workerSleeping.store(false);
+        }
+        drain();
+    });
+}
+
+void Logger::log(LogLevel level, LogStyle style, const std::string& message) {
+    if (level >= consoleLevel && consoleLevel != LogLevel::Off) {
+#ifdef OS_WINDOWS
+        (void)style; // Legacy consoles get no colors
+        std::cout << message << '\n';
+#else
+        const char* color = style == LogStyle::Info    ? "\033[32m"  // Green
+                          : style == LogStyle::Warning ? "\033[33m"  // Yellow
+                          : style == LogStyle::Error   ? "\033[31m"  // Red
+                          :                              "\033[36m"; // Cyan
+        std::cout << color << message << "\033[0m" << '\n';
+#endif
+    }
+
+    const bool toFile = fileLevel.load(std::memory_order_relaxed) != LogLevel::Off &&
+                        level >= fileLevel.load(std::memory_order_relaxed);
+    const bool toJsonl = jsonlLevel.load(std::memory_order_relaxed) != LogLevel::Off &&
+                         level >= jsonlLevel.load(std::memory_order_relaxed);
+    if (!toFile && !toJsonl) return;
+
+    LogEntry entry;
+    entry.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    entry.level = level;
+    entry.style = style;
+    entry.message = message;
+
+    if (!push(std::move(entry))) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (workerSleeping.load()) wakeUp.notify_one();
+}
+
+// Producer side of the ring: claim a slot whose sequence equals the position, fill it, publish it
+bool Logger::push(LogEntry&& entry) {
+    std::size_t position = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring[position & (LOG_RING_CAPACITY - 1)];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const long long difference = static_cast<long long>(sequence) - static_cast<long long>(position);
+        if (difference == 0) {
+            if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.entry = std::move(entry);
+                slot.sequence.store(position + 1, std::memory_order_release);
+                accepted.fetch_add(1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false; // Full, the consumer has not freed this slot yet
+        } else {
+            position = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Consumer side, only called from the worker thread
+bool Logger::pop(LogEntry& entry) {
+    Slot& slot = ring[dequeuePos & (LOG_RING_CAPACITY - 1)];
+    const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != dequeuePos + 1) {
+        return false; // Empty, or the producer of this slot has not published yet
+    }
+    entry = std::move(slot.entry);
+    slot.sequence.store(dequeuePos + LOG_RING_CAPACITY, std::memory_order_release);
+    dequeuePos++;
+    return true;
+}
+
+void Logger::drain() {
+    LogEntry entry;
+    std::size_t written = 0;
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        while (pop(entry)) {
+            writeToFiles(entry);
+            written++;
+        }
+        if (written > 0) {
+            if (fileSink.is_open()) fileSink.flush();
+            if (jsonlSink.is_open()) jsonlSink.flush();
+        }
+    }
+    if (written > 0) drained.fetch_add(written, std::memory_order_release);
+}
+
+void Logger::writeToFiles(const LogEntry& entry) {
+    const LogLevel toFile = fileLevel.load(std::memory_order_relaxed);
+    const LogLevel toJsonl = jsonlLevel.load(std::memory_order_relaxed);
+
+    if (fileSink.is_open() && toFile != LogLevel::Off && entry.level >= toFile) {
+        fileSink << formatTimestamp(entry.timestamp_ms) << " [" << levelName(entry.level) << "] "
+                 << entry.message << "\n";
+    }
+    if (jsonlSink.is_open() && toJsonl != LogLevel::Off && entry.level >= toJsonl) {
+        jsonlSink << "{\"ts\":\"" << formatTimestamp(entry.timestamp_ms) << "\",\"level\":\""
+                  << levelName(entry.level) << "\",\"msg\":\"" << jsonEscape(entry.message) << "\"}\n";
+    }
+}
+
+void Logger::flush() {
+    std::cout.flush();
+    if (!worker.joinable()) return;
+    const std::size_t target = accepted.load(std::memory_order_acquire);
+    while (drained.load(std::memory_order_acquire) < target) {
+        wakeUp.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
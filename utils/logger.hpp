@@ -0,0 +1,137 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#define LOG_RING_CAPACITY 4096 // Must be a power of two
+#define LOG_LEVEL_ENV_VAR "HOSPITAL_LOG_LEVEL"
+#define LOG_FILE_ENV_VAR "HOSPITAL_LOG_FILE"
+#define LOG_JSONL_ENV_VAR "HOSPITAL_LOG_JSONL"
+
+/**
+ * @brief Severity of a message, messages below a sink's level are dropped before any I/O
+ */
+enum class LogLevel { Debug, Info, Warning, Error, Off };
+
+/**
+ * @brief Console color of a message, Custom is cyan Info
+ */
+enum class LogStyle { Info, Warning, Error, Custom };
+
+/**
+ * @struct LogEntry
+ * @brief One message on its way to the sinks
+ */
+struct LogEntry {
+    long long timestamp_ms = 0; /// Milliseconds since the epoch, taken by the caller
+    LogLevel level = LogLevel::Info;
+    LogStyle style = LogStyle::Info;
+    std::string message;
+};
+
+/**
+ * @brief Leveled logging backend behind MessageHandler
+ *
+ * @details
+ * - Three sinks: console (colored as before), plain-text file and JSON Lines file, each with
+ *   its own minimum level
+ * - The file sinks are asynchronous: callers push entries into a bounded lock-free MPSC ring
+ *   (one sequence number per slot, producers claim slots with a CAS) and a background thread
+ *   drains it. A full ring drops the entry and counts it instead of blocking the caller
+ * - The console sink stays on the caller's thread so messages keep their place between the
+ *   menus and prompts the roles print with std::cout. It does not flush per line: std::cin
+ *   is tied to std::cout, so pending output appears before every prompt, and flush() or
+ *   program exit pushes out the rest. Batch runs silence it, or keep only errors, with
+ *   HOSPITAL_LOG_LEVEL / --log-level
+ * - Configured from HOSPITAL_LOG_LEVEL (debug, info, warning, error, off), HOSPITAL_LOG_FILE
+ *   and HOSPITAL_LOG_JSONL on first use; main() forwards the matching command line flags
+ * - The background thread only starts once a file sink is opened and is joined, after
+ *   draining the ring, when the program exits
+ *
+ * @usage
+ *      Logger::instance().openJsonl("/var/log/hospital.jsonl", LogLevel::Warning);
+ *      Logger::instance().log(LogLevel::Warning, LogStyle::Warning, "Skipping malformed row 42");
+ */
+class Logger {
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        LogEntry entry;
+    };
+
+    Slot* ring;
+    std::atomic<std::size_t> enqueuePos;
+    std::size_t dequeuePos;             /// Only touched by the background thread
+    std::atomic<std::size_t> drained;   /// Entries fully written, flush() waits on it
+    std::atomic<std::size_t> accepted;  /// Entries pushed into the ring
+    std::atomic<unsigned long long> dropped;
+
+    LogLevel consoleLevel;
+    std::atomic<LogLevel> fileLevel;
+    std::atomic<LogLevel> jsonlLevel;
+    std::ofstream fileSink;
+    std::ofstream jsonlSink;
+    std::mutex sinkMutex;               /// Guards the sink streams against being reopened mid-write
+
+    std::thread worker;
+    std::atomic<bool> stopping;
+    std::atomic<bool> workerSleeping;
+    std::mutex wakeMutex;
+    std::condition_variable wakeUp;
+
+    Logger();
+    ~Logger();
+
+    void configureFromEnvironment();
+    void startWorker();
+    bool push(LogEntry&& entry);
+    bool pop(LogEntry& entry);
+    void drain();
+    void writeToFiles(const LogEntry& entry);
+
+public:
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    static Logger& instance();
+
+    /**
+     * @brief Sends one message to every sink whose level it reaches
+     */
+    void log(LogLevel level, LogStyle style, const std::string& message);
+
+    void setConsoleLevel(LogLevel level) { consoleLevel = level; }
+
+    /**
+     * @brief Appends plain-text lines "YYYY-MM-DD HH:MM:SS.mmm [LEVEL] message" to path
+     * @return false if the file cannot be opened
+     */
+    bool openFile(const std::string& path, LogLevel level = LogLevel::Info);
+
+    /**
+     * @brief Appends one JSON object per message ({"ts":..., "level":..., "msg":...}) to path
+     * @return false if the file cannot be opened
+     */
+    bool openJsonl(const std::string& path, LogLevel level = LogLevel::Info);
+
+    /**
+     * @brief Flushes the console and blocks until every message logged so far has reached the file sinks
+     */
+    void flush();
+
+    unsigned long long getDroppedCount() const { return dropped.load(); }
+
+    /**
+     * @brief Parses "debug", "info", "warning", "error" or "off" (case-insensitive)
+     * @return false if the name is not a level
+     */
+    static bool parseLevel(const std::string& name, LogLevel& level);
+};
+
+#endif // LOGGER_HPP
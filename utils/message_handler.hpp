@@ -4,11 +4,14 @@
 #include <iostream>
 #include <string>
 #include "config.hpp" // Required for OS detection macros
+#include "logger.hpp"
 
 /**
  * @brief Message handling utility for all roles
  *
  * @details
+ * - Messages go through Logger: shown on the console and, when configured, also written to a
+ *   log file or JSON Lines file by a background thread (see logger.hpp)
  * - Uses ANSI escape codes for macOS and Linux
  * - On Windows:
  *      - Modern terminals (Windows 10+ / Windows Terminal / PowerShell) support ANSI colors
@@ -23,44 +26,28 @@ public:
      * @brief Display an informational message (green)
      */
     static void info(const std::string& msg) {
-#ifdef OS_WINDOWS
-        std::cout << msg << std::endl;
-#else
-        std::cout << "\033[32m" << msg << "\033[0m" << std::endl;
-#endif
+        Logger::instance().log(LogLevel::Info, LogStyle::Info, msg);
     }
 
     /**
      * @brief Display a warning message (yellow)
      */
     static void warning(const std::string& msg) {
-#ifdef OS_WINDOWS
-        std::cout << msg << std::endl;
-#else
-        std::cout << "\033[33m" << msg << "\033[0m" << std::endl;
-#endif
+        Logger::instance().log(LogLevel::Warning, LogStyle::Warning, msg);
     }
 
     /**
      * @brief Display an error message (red)
      */
     static void error(const std::string& msg) {
-#ifdef OS_WINDOWS
-        std::cout << msg << std::endl;
-#else
-        std::cout << "\033[31m" << msg << "\033[0m" << std::endl;
-#endif
+        Logger::instance().log(LogLevel::Error, LogStyle::Error, msg);
     }
 
     /**
      * @brief Display a custom message (cyan)
      */
     static void custom(const std::string& msg) {
-#ifdef OS_WINDOWS
-        std::cout << msg << std::endl;
-#else
-        std::cout << "\033[36m" << msg << "\033[0m" << std::endl;
-#endif
+        Logger::instance().log(LogLevel::Info, LogStyle::Custom, msg);
     }
 };
 
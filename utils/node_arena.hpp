@@ -0,0 +1,126 @@
+#ifndef NODE_ARENA_HPP
+#define NODE_ARENA_HPP
+
+#define NODE_ARENA_FIRST_CHUNK 64
+#define NODE_ARENA_MAX_CHUNK 65536
+
+/**
+ * @brief Monotonic chunked storage for the nodes of one linked list
+ *
+ * @details
+ * - Nodes are handed out back to back from chunks that double in size (64, 128, ... 65536),
+ *   so loading n rows costs O(log n) allocations and nodes created together sit together
+ * - Every node lives until the arena is destroyed; the whole list is torn down chunk by chunk
+ *   instead of node by node
+ * - recycle() keeps a node that was unlinked from its list for the next allocate(),
+ *   reset() makes every node reusable at once while keeping the chunks for the next load
+ * - Nodes are default-constructed with their chunk and handed out as is: callers assign every
+ *   field, a recycled node still holds its previous values
+ * - Header-only because it is a template; T must be default-constructible
+ *
+ * @usage
+ *      NodeArena<Node> nodes;
+ *      Node* node = nodes.allocate();
+ *      node->data = ec;
+ *      node->next = head;
+ *      head = node;
+ */
+template <typename T>
+class NodeArena {
+private:
+    struct Chunk {
+        T* nodes;
+        int capacity;
+        int used;
+        Chunk* next;
+    };
+
+    Chunk* first;       /// Oldest chunk
+    Chunk* current;     /// Chunk nodes are currently taken from
+    T** freeList;       /// Recycled nodes, reused before fresh ones
+    int freeCount;
+    int freeCapacity;
+
+    void advance() {
+        if (current != nullptr && current->next != nullptr) {
+            // Chunks kept by reset() are reused before allocating more
+            current = current->next;
+            current->used = 0;
+            return;
+        }
+
+        int capacity = NODE_ARENA_FIRST_CHUNK;
+        if (current != nullptr) {
+            capacity = current->capacity < NODE_ARENA_MAX_CHUNK ? current->capacity * 2 : NODE_ARENA_MAX_CHUNK;
+        }
+        Chunk* chunk = new Chunk{new T[capacity], capacity, 0, nullptr};
+        if (current == nullptr) {
+            first = chunk;
+        }
+        else {
+            current->next = chunk;
+        }
+        current = chunk;
+    }
+
+public:
+    NodeArena() : first(nullptr), current(nullptr), freeList(nullptr), freeCount(0), freeCapacity(0) {}
+
+    ~NodeArena() {
+        while (first != nullptr) {
+            Chunk* next = first->next;
+            delete[] first->nodes;
+            delete first;
+            first = next;
+        }
+        delete[] freeList;
+    }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    /**
+     * @brief Returns a node owned by the arena
+     */
+    T* allocate() {
+        if (freeCount > 0) {
+            return freeList[--freeCount];
+        }
+        if (current == nullptr || current->used == current->capacity) {
+            advance();
+        }
+        return &current->nodes[current->used++];
+    }
+
+    /**
+     * @brief Hands a node that is no longer linked anywhere back for reuse
+     */
+    void recycle(T* node) {
+        if (node == nullptr) return;
+        if (freeCount == freeCapacity) {
+            int newCapacity = freeCapacity == 0 ? 16 : freeCapacity * 2;
+            T** newFreeList = new T*[newCapacity];
+            for (int i = 0; i < freeCount; i++) {
+                newFreeList[i] = freeList[i];
+            }
+            delete[] freeList;
+            freeList = newFreeList;
+            freeCapacity = newCapacity;
+        }
+        freeList[freeCount++] = node;
+    }
+
+    /**
+     * @brief Forgets every node at once, the chunks are kept for the next allocations
+     * @note Any list head pointing into the arena must be cleared by the caller
+     */
+    void reset() {
+        current = first;
+        if (current != nullptr) {
+            current->used = 0;
+        }
+        freeCount = 0;
+    }
+};
+
+#endif // NODE_ARENA_HPP
@@ -0,0 +1,99 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#define CACHE_LINE_SIZE 64
+
+/**
+ * @brief Slab allocator with a free list for fixed-type nodes
+ *
+ * @details
+ * - Nodes are carved out of slabs of SLAB_SIZE objects; a slab is only allocated when the
+ *   free list runs dry, so steady-state acquire()/release() never touch the heap
+ * - Released nodes stay constructed and go back on the free list. Their std::string members
+ *   keep their buffers, so refilling a recycled node usually does not allocate either
+ * - CACHE_ALIGNED pads every node to a cache-line boundary so neighbouring nodes never share a line
+ * - Slabs are freed when the pool is destroyed, memory is bounded by the peak number of live nodes
+ * - Header-only because it is a template; T must be default-constructible
+ *
+ * @usage
+ *      NodePool<Node> pool;
+ *      Node* node = pool.acquire();   // Fields still hold the previous occupant's values
+ *      ...
+ *      pool.release(node);
+ */
+template <typename T, int SLAB_SIZE = 64, bool CACHE_ALIGNED = false>
+class NodePool {
+private:
+    struct alignas(CACHE_ALIGNED ? CACHE_LINE_SIZE : alignof(T)) Slot {
+        T value;
+    };
+
+    struct Slab {
+        Slot slots[SLAB_SIZE];
+        Slab* next;
+    };
+
+    Slab* slabs;        /// Every slab ever allocated, newest first
+    T** freeList;       /// Stack of released nodes
+    int freeCount;
+    int capacity;       /// Nodes across all slabs, also the size of freeList
+
+    void grow() {
+        Slab* slab = new Slab();
+        slab->next = slabs;
+        slabs = slab;
+
+        T** newFreeList = new T*[capacity + SLAB_SIZE];
+        for (int i = 0; i < freeCount; i++) {
+            newFreeList[i] = freeList[i];
+        }
+        delete[] freeList;
+        freeList = newFreeList;
+        capacity += SLAB_SIZE;
+
+        // Pushed in reverse so the slab is handed out front to back
+        for (int i = SLAB_SIZE - 1; i >= 0; i--) {
+            freeList[freeCount++] = &slab->slots[i].value;
+        }
+    }
+
+public:
+    NodePool() : slabs(nullptr), freeList(nullptr), freeCount(0), capacity(0) {}
+
+    ~NodePool() {
+        while (slabs != nullptr) {
+            Slab* next = slabs->next;
+            delete slabs;
+            slabs = next;
+        }
+        delete[] freeList;
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * @brief Hands out a node, allocating a new slab only when none is free
+     * @note The node is recycled as is, callers assign every field they rely on
+     */
+    T* acquire() {
+        if (freeCount == 0) {
+            grow();
+        }
+        return freeList[--freeCount];
+    }
+
+    /**
+     * @brief Returns a node obtained from acquire() to the free list
+     */
+    void release(T* node) {
+        if (node != nullptr) {
+            freeList[freeCount++] = node;
+        }
+    }
+
+    int getCapacity() const { return capacity; }
+    int getInUse() const { return capacity - freeCount; }
+};
+
+#endif // NODE_POOL_HPP
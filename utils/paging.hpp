@@ -0,0 +1,40 @@
+#ifndef PAGING_HPP
+#define PAGING_HPP
+
+#include <iostream>
+#include <string>
+
+#include "string_utils.hpp"
+
+/**
+ * @brief Shared paging helpers for the listing menus
+ *
+ * @note
+ * - Every paged listing shows at most LIST_PAGE_SIZE rows before asking the user to continue
+ * - Query APIs (EmergencyManager::queryCases, MedicalSupplyManager::querySupplies) materialize
+ *   one page at a time, so memory stays bounded by LIST_PAGE_SIZE regardless of dataset size
+ */
+
+#define LIST_PAGE_SIZE 50 // Rows shown per page in listing menus
+
+/**
+ * @brief Asks the user whether the next page should be displayed
+ * @param hasMore Whether there are more rows after the current page
+ * @return true if the next page should be shown, false to stop listing
+ */
+inline bool promptNextPage(bool hasMore) {
+    if (!hasMore) {
+        return false;
+    }
+
+    std::cout << "\n-- More results available. Press Enter for the next page, or 'q' to stop: ";
+    std::string input;
+    if (!std::getline(std::cin, input)) {
+        return false;
+    }
+
+    input = trim(input);
+    return !(input == "q" || input == "Q");
+}
+
+#endif // PAGING_HPP
@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <filesystem>
 
 #include "path_utils.hpp"
@@ -5,37 +6,66 @@
 
 namespace fs = std::filesystem;
 
-std::string getDataFilePath(const std::string& filename) {
-    fs::path currentPath = fs::current_path();
-    fs::path projectRoot;
+static std::string dataRoot;        // Resolved root, with a trailing separator
+static bool dataRootResolved = false;
+
+// Creates the directory if needed, returns it with a trailing separator or "" on failure
+static std::string prepareDataDirectory(const fs::path& dataDir) {
+    std::error_code ec;
+    if (!fs::exists(dataDir, ec)) {
+        if (!fs::create_directories(dataDir, ec)) {
+            MessageHandler::error("Failed to create data directory: " + dataDir.string());
+            return "";
+        }
+    } else if (!fs::is_directory(dataDir, ec)) {
+        MessageHandler::error("Path exists but is not a directory: " + dataDir.string());
+        return "";
+    }
+
+    std::string root = dataDir.string();
+    if (root.back() != fs::path::preferred_separator && root.back() != '/') {
+        root += fs::path::preferred_separator;
+    }
+    return root;
+}
 
-    // Traverse up the directory tree to find the project root (where CMakeLists.txt is located)
-    fs::path tempPath = currentPath;
+// Traverses up the directory tree to find the project root (where CMakeLists.txt is located)
+static std::string searchProjectDataDirectory() {
+    fs::path tempPath = fs::current_path();
     while (tempPath.has_parent_path()) {
         if (fs::exists(tempPath / "CMakeLists.txt")) {
-            projectRoot = tempPath;
-            break;
+            return prepareDataDirectory(tempPath / "data");
         }
+        if (tempPath == tempPath.parent_path()) break;
         tempPath = tempPath.parent_path();
     }
 
-    if (projectRoot.empty()) {
-        MessageHandler::error("Could not find project root (CMakeLists.txt not found in parent directories).");
-        return "";
-    }
+    MessageHandler::error("Could not find project root (CMakeLists.txt not found in parent directories).");
+    return "";
+}
 
-    fs::path dataDir = projectRoot / "data";
+void setDataRoot(const std::string& directory) {
+    dataRoot = prepareDataDirectory(fs::absolute(directory));
+    dataRootResolved = true;
+}
 
-    if (!fs::exists(dataDir)) {
-        if (!fs::create_directories(dataDir)) {
-            MessageHandler::error("Failed to create data directory: " + dataDir.string());
-            return "";
+const std::string& getDataRoot() {
+    if (!dataRootResolved) {
+        const char* fromEnv = std::getenv(DATA_DIR_ENV_VAR);
+        if (fromEnv != nullptr && *fromEnv != '\0') {
+            dataRoot = prepareDataDirectory(fs::absolute(fromEnv));
+        } else {
+            dataRoot = searchProjectDataDirectory();
         }
-    } else if (!fs::is_directory(dataDir)) {
-        MessageHandler::error("Path exists but is not a directory: " + dataDir.string());
-        return "";
+        dataRootResolved = true;
     }
+    return dataRoot;
+}
 
-    fs::path filePath = dataDir / filename;
-    return filePath.string();
+std::string getDataFilePath(const std::string& filename) {
+    const std::string& root = getDataRoot();
+    if (root.empty()) {
+        return "";
+    }
+    return root + filename;
 }
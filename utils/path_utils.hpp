@@ -3,6 +3,39 @@
 
 #include <string>
 
+#define DATA_DIR_ENV_VAR "HOSPITAL_DATA_DIR"
+
+/**
+ * @brief Locates the directory holding every CSV dataset
+ *
+ * @details
+ * - The data root is resolved once per run and cached, in this order:
+ *   1. A directory passed to setDataRoot() (main() forwards the --data-dir flag)
+ *   2. The HOSPITAL_DATA_DIR environment variable
+ *   3. The "data" directory next to the project's CMakeLists.txt, searched upwards from the
+ *      working directory
+ * - The directory is created if missing
+ * - After the first call getDataFilePath() is a string concatenation, no filesystem access
+ *
+ * @usage
+ *      setDataRoot("/mnt/fast/hospital");                 // Optional, before the first lookup
+ *      std::string path = getDataFilePath("queue.csv");   // "<root>/queue.csv"
+ */
+
+/**
+ * @brief Overrides the data root, takes precedence over the environment variable and the search
+ * @note Call before the first getDataFilePath(), a root already resolved is replaced
+ */
+void setDataRoot(const std::string& directory);
+
+/**
+ * @brief Returns the resolved data root, empty if it could not be resolved
+ */
+const std::string& getDataRoot();
+
+/**
+ * @brief Returns the full path of a file in the data root, empty if the root could not be resolved
+ */
 std::string getDataFilePath(const std::string& filename);
 
 #endif
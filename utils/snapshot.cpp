@@ -0,0 +1,286 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include "config.hpp"
+#include "durable_writer.hpp"
+#include "snapshot.hpp"
+
+#ifndef OS_WINDOWS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char SNAPSHOT_MAGIC[8] = {'H', 'M', 'S', 'S', 'N', 'A', 'P', '\0'};
+    constexpr uint32_t SNAPSHOT_VERSION = 1;
+    constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304; // Reads back differently on a foreign-endian machine
+    constexpr size_t CELL_SIZE = 8;
+
+    // On-disk header, every field is naturally aligned so the struct has no padding
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t column_count;
+        uint32_t reserved;
+        uint64_t row_count;
+        uint64_t heap_size;
+        uint64_t source_size;   /// Size of the CSV this snapshot mirrors
+        uint64_t checksum;      /// FNV-1a over the columns followed by the heap
+        char column_types[SNAPSHOT_MAX_COLUMNS];
+    };
+
+    uint64_t fnv1a(const unsigned char* bytes, size_t count, uint64_t hash = 14695981039346656037ULL) {
+        for (size_t i = 0; i < count; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool isValidLayout(const std::string& columnTypes) {
+        if (columnTypes.empty() || columnTypes.size() > SNAPSHOT_MAX_COLUMNS) return false;
+        for (char type : columnTypes) {
+            if (type != 'S' && type != 'I' && type != 'D') return false;
+        }
+        return true;
+    }
+}
+
+std::string snapshotPathFor(const std::string& csvPath) {
+    return csvPath + ".snap";
+}
+
+// ---------------------------------------------------------------- writer
+
+SnapshotWriter::SnapshotWriter(const std::string& columnTypes)
+    : columns(columnTypes), rows(0), column(0), valid(isValidLayout(columnTypes)) {}
+
+bool SnapshotWriter::nextColumnIs(char type) {
+    if (!valid) return false;
+    if (columns[column] != type) {
+        valid = false; // Caller and layout disagree, never write a snapshot that would load wrong values
+        return false;
+    }
+    return true;
+}
+
+void SnapshotWriter::appendCell(const void* value) {
+    cells[column].append(static_cast<const char*>(value), CELL_SIZE);
+    column++;
+    if (column == static_cast<int>(columns.size())) {
+        column = 0;
+        rows++;
+    }
+}
+
+SnapshotWriter& SnapshotWriter::addString(const std::string& value) {
+    if (!nextColumnIs('S')) return *this;
+    if (heap.size() + value.size() > UINT32_MAX) {
+        valid = false;
+        return *this;
+    }
+    uint32_t location[2] = {static_cast<uint32_t>(heap.size()), static_cast<uint32_t>(value.size())};
+    heap.append(value);
+    appendCell(location);
+    return *this;
+}
+
+SnapshotWriter& SnapshotWriter::addInt(long long value) {
+    if (!nextColumnIs('I')) return *this;
+    int64_t stored = value;
+    appendCell(&stored);
+    return *this;
+}
+
+SnapshotWriter& SnapshotWriter::addDouble(double value) {
+    if (!nextColumnIs('D')) return *this;
+    appendCell(&value);
+    return *this;
+}
+
+bool SnapshotWriter::save(const std::string& csvPath, unsigned long long csvSize) {
+    if (!valid || column != 0) return false; // Layout mismatch or half-written row
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byte_order = SNAPSHOT_BYTE_ORDER;
+    header.column_count = static_cast<uint32_t>(columns.size());
+    header.row_count = static_cast<uint64_t>(rows);
+    header.heap_size = heap.size();
+    header.source_size = csvSize;
+    std::memcpy(header.column_types, columns.data(), columns.size());
+
+    uint64_t checksum = fnv1a(nullptr, 0);
+    for (size_t c = 0; c < columns.size(); c++) {
+        checksum = fnv1a(reinterpret_cast<const unsigned char*>(cells[c].data()), cells[c].size(), checksum);
+    }
+    checksum = fnv1a(reinterpret_cast<const unsigned char*>(heap.data()), heap.size(), checksum);
+    header.checksum = checksum;
+
+    DurableWriter file(snapshotPathFor(csvPath));
+    if (!file.isOpen()) return false;
+
+    file << std::string(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (size_t c = 0; c < columns.size(); c++) {
+        file << cells[c];
+    }
+    file << heap;
+    return file.commit();
+}
+
+bool SnapshotWriter::save(const std::string& csvPath) {
+    std::error_code ec;
+    const uintmax_t csvSize = fs::file_size(csvPath, ec);
+    if (ec) return false;
+    return save(csvPath, static_cast<unsigned long long>(csvSize));
+}
+
+// ---------------------------------------------------------------- reader
+
+SnapshotReader::SnapshotReader(const std::string& csvPath, const std::string& columnTypes, bool allowAppended)
+    : data(nullptr), length(0), mapped(false), cells(nullptr), heap(nullptr), rowCount(0), sourceSize(0), valid(false) {
+    const std::string snapPath = snapshotPathFor(csvPath);
+
+    // Cheap checks first: both files exist and the snapshot is not older than the CSV
+    // (appending makes the CSV newer, so that check waits for the sizes when appends are allowed)
+    std::error_code ec;
+    const fs::file_time_type csvTime = fs::last_write_time(csvPath, ec);
+    if (ec) return;
+    const fs::file_time_type snapTime = fs::last_write_time(snapPath, ec);
+    if (ec || (!allowAppended && snapTime < csvTime)) return;
+    const uintmax_t csvSize = fs::file_size(csvPath, ec);
+    if (ec) return;
+
+#ifdef OS_WINDOWS
+    std::ifstream in(snapPath, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return;
+    const std::streamoff fileSize = in.tellg();
+    if (fileSize < static_cast<std::streamoff>(sizeof(SnapshotHeader))) return;
+    unsigned char* buffer = new unsigned char[static_cast<size_t>(fileSize)];
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(buffer), fileSize)) {
+        delete[] buffer;
+        return;
+    }
+    data = buffer;
+    length = static_cast<size_t>(fileSize);
+#else
+    int fd = open(snapPath.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        close(fd);
+        return;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (mapping == MAP_FAILED) return;
+    data = static_cast<const unsigned char*>(mapping);
+    length = static_cast<size_t>(info.st_size);
+    mapped = true;
+#endif
+
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const size_t columnCount = columnTypes.size();
+    bool usable = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0
+               && header.version == SNAPSHOT_VERSION
+               && header.byte_order == SNAPSHOT_BYTE_ORDER
+               && isValidLayout(columnTypes)
+               && header.column_count == columnCount
+               && std::memcmp(header.column_types, columnTypes.data(), columnCount) == 0
+               // Same size: the CSV must not have been touched since the snapshot, an equal mtime
+               // is not proof on coarse-grained filesystems. Grown: only an append-only source
+               && (header.source_size == csvSize ? snapTime > csvTime
+                                                 : allowAppended && header.source_size < csvSize);
+
+    // Sizes must add up exactly before any cell is touched
+    const uint64_t body = length - sizeof(header);
+    if (usable && (header.row_count > body / (CELL_SIZE * columnCount)
+                   || header.row_count * CELL_SIZE * columnCount + header.heap_size != body)) {
+        usable = false;
+    }
+    if (usable) {
+        const unsigned char* start = data + sizeof(header);
+        usable = fnv1a(start, static_cast<size_t>(body)) == header.checksum;
+    }
+    if (!usable) {
+        release();
+        return;
+    }
+
+    cells = data + sizeof(header);
+    heap = reinterpret_cast<const char*>(cells + header.row_count * CELL_SIZE * columnCount);
+    rowCount = static_cast<long long>(header.row_count);
+    sourceSize = header.source_size;
+
+    // Every string cell must point inside the heap
+    for (size_t c = 0; c < columnCount && usable; c++) {
+        if (columnTypes[c] != 'S') continue;
+        for (long long row = 0; row < rowCount; row++) {
+            uint32_t location[2];
+            std::memcpy(location, cellAt(row, static_cast<int>(c)), sizeof(location));
+            if (static_cast<uint64_t>(location[0]) + location[1] > header.heap_size) {
+                usable = false;
+                break;
+            }
+        }
+    }
+    if (!usable) {
+        release();
+        return;
+    }
+
+    valid = true;
+}
+
+SnapshotReader::~SnapshotReader() {
+    release();
+}
+
+void SnapshotReader::release() {
+    if (data) {
+#ifdef OS_WINDOWS
+        delete[] data;
+#else
+        if (mapped) munmap(const_cast<unsigned char*>(data), length);
+#endif
+    }
+    data = nullptr;
+    length = 0;
+    mapped = false;
+    valid = false;
+}
+
+const unsigned char* SnapshotReader::cellAt(long long row, int column) const {
+    return cells + (static_cast<size_t>(column) * static_cast<size_t>(rowCount) + static_cast<size_t>(row)) * CELL_SIZE;
+}
+
+std::string SnapshotReader::getString(long long row, int column) const {
+    uint32_t location[2];
+    std::memcpy(location, cellAt(row, column), sizeof(location));
+    return std::string(heap + location[0], location[1]);
+}
+
+long long SnapshotReader::getInt(long long row, int column) const {
+    int64_t value;
+    std::memcpy(&value, cellAt(row, column), sizeof(value));
+    return static_cast<long long>(value);
+}
+
+double SnapshotReader::getDouble(long long row, int column) const {
+    double value;
+    std::memcpy(&value, cellAt(row, column), sizeof(value));
+    return value;
+}
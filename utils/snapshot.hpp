@@ -0,0 +1,138 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Binary snapshots of the CSV datasets for fast cold start
+ *
+ * @details
+ * - A snapshot "<file>.csv.snap" is a typed, pre-parsed image of one CSV file and lives next to it
+ * - Layout: versioned header, then one fixed-width 8-byte column per CSV column (column-major),
+ *   then a string heap. String cells hold (offset, length) into the heap, numeric cells hold
+ *   the value itself. A checksum over the columns and heap guards against torn or stale files
+ * - The header records the size of the CSV it mirrors. A snapshot is only used when that size
+ *   still matches and the snapshot is strictly newer than the CSV (an equal mtime is rejected),
+ *   or, for append-only files, when the CSV only grew. Otherwise loaders fall back to the CSV
+ *   and rebuild the snapshot while parsing
+ * - Snapshots are a cache: CSV stays the interchange format and deleting a .snap is always safe
+ *
+ * @usage
+ *      SnapshotReader snapshot(filePath, CASE_SNAPSHOT_COLUMNS);
+ *      if (snapshot.isValid()) {
+ *          for (long long row = 0; row < snapshot.getRowCount(); row++) {
+ *              ec.case_id = snapshot.getString(row, 0);
+ *              ec.priority_level = static_cast<int>(snapshot.getInt(row, 3));
+ *          }
+ *      }
+ *
+ *      SnapshotWriter writer(CASE_SNAPSHOT_COLUMNS);
+ *      writer.addString(ec.case_id).addString(ec.patient_id)...addInt(ec.priority_level)...;
+ *      writer.save(filePath, csvSize);
+ */
+
+#define SNAPSHOT_MAX_COLUMNS 16
+
+// Column layouts, one character per CSV column: 'S' string, 'I' 64-bit integer, 'D' double
+#define PATIENT_SNAPSHOT_COLUMNS   "SSSSSSSSSSSS" // patient_data.csv
+#define QUEUE_SNAPSHOT_COLUMNS     "SSSSS"        // queue.csv
+#define CASE_SNAPSHOT_COLUMNS      "SSSISSSS"     // emergency_cases.csv
+#define SUPPLY_SNAPSHOT_COLUMNS    "SSSISSSS"     // medical_supply.csv
+#define USAGE_LOG_SNAPSHOT_COLUMNS "SSSSIS"       // supply_usage_log.csv
+#define AMBULANCE_SNAPSHOT_COLUMNS "SSSSSISSSIIISS" // ambulance_schedule.csv
+#define SHIFT_SNAPSHOT_COLUMNS     "SSSSSISIDIIS" // shift_history.csv
+
+/**
+ * @brief Returns the snapshot path that belongs to a CSV file
+ */
+std::string snapshotPathFor(const std::string& csvPath);
+
+/**
+ * @brief Builds a snapshot row by row, cells are added left to right
+ */
+class SnapshotWriter {
+private:
+    std::string columns;                        /// Column layout, e.g. CASE_SNAPSHOT_COLUMNS
+    std::string cells[SNAPSHOT_MAX_COLUMNS];    /// Fixed-width cell bytes of each column
+    std::string heap;                           /// Bytes of every string cell
+    long long rows;                             /// Completed rows
+    int column;                                 /// Column of the next cell in the current row
+    bool valid;                                 /// Cleared on a layout mismatch, the snapshot is then not saved
+
+    bool nextColumnIs(char type);
+    void appendCell(const void* value);
+
+public:
+    /**
+     * @param columnTypes One of the *_SNAPSHOT_COLUMNS layouts
+     */
+    explicit SnapshotWriter(const std::string& columnTypes);
+
+    SnapshotWriter& addString(const std::string& value);
+    SnapshotWriter& addInt(long long value);
+    SnapshotWriter& addDouble(double value);
+
+    /**
+     * @brief Writes "<csvPath>.snap" through DurableWriter
+     * @param csvPath The CSV file this snapshot mirrors
+     * @param csvSize Size in bytes of that CSV once it is on disk
+     * @return true if the snapshot was written (or staged inside a DurableWriter group)
+     */
+    bool save(const std::string& csvPath, unsigned long long csvSize);
+
+    /**
+     * @brief Same as above, for a CSV file that is already on disk in its final form
+     */
+    bool save(const std::string& csvPath);
+};
+
+/**
+ * @brief Maps a snapshot into memory and exposes its cells without parsing
+ */
+class SnapshotReader {
+private:
+    const unsigned char* data;      /// Whole snapshot file
+    size_t length;
+    bool mapped;                    /// data came from mmap rather than new[]
+    const unsigned char* cells;     /// Start of the fixed-width columns
+    const char* heap;               /// Start of the string heap
+    long long rowCount;
+    unsigned long long sourceSize;
+    bool valid;
+
+    void release();
+    const unsigned char* cellAt(long long row, int column) const;
+
+public:
+    /**
+     * @brief Opens the snapshot of csvPath if it is present, intact and up to date
+     * @param csvPath The CSV file the snapshot mirrors
+     * @param columnTypes Expected column layout, snapshots with another layout are ignored
+     * @param allowAppended Also accept a CSV that grew past getSourceSize() (append-only logs).
+     *        The caller must then confirm the prefix is unchanged and parse the rest itself
+     */
+    SnapshotReader(const std::string& csvPath, const std::string& columnTypes, bool allowAppended = false);
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    /**
+     * @brief Checks if the snapshot can be used instead of parsing the CSV
+     */
+    bool isValid() const { return valid; }
+
+    long long getRowCount() const { return rowCount; }
+
+    /**
+     * @brief Size of the CSV file when the snapshot was written
+     */
+    unsigned long long getSourceSize() const { return sourceSize; }
+
+    std::string getString(long long row, int column) const;
+    long long getInt(long long row, int column) const;
+    double getDouble(long long row, int column) const;
+};
+
+#endif // SNAPSHOT_HPP
@@ -72,6 +72,22 @@ inline std::string toUpper(std::string s) {
     return s;
 }
 
+/**
+ * @brief Convert a string to lowercase
+ *
+ * @param s The input string to convert
+ * @return A new string with all characters converted to lowercase
+ *
+ * @note
+ * Non-alphabetic characters are not affected. Works with ASCII characters
+ */
+inline std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c){ return static_cast<char>(std::tolower(c)); }
+                  );
+    return s;
+}
+
 
 /**
  * @brief Split a string into substrings using a delimiter and store them in a DynamicArray
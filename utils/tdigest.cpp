@@ -0,0 +1,179 @@
+#include "tdigest.hpp"
+
+#include <cmath>
+
+#define TDIGEST_PI 3.14159265358979323846
+
+TDigest::TDigest(double compressionFactor)
+    : compression(compressionFactor < 10 ? 10 : compressionFactor), centroidCount(0), bufferCount(0),
+      totalWeight(0.0), valueCount(0), minValue(0.0), maxValue(0.0) {
+    // The arcsine scale allows at most compression + 1 centroids, the margin covers rounding
+    centroidCapacity = static_cast<int>(2 * compression) + 8;
+    bufferCapacity = static_cast<int>(5 * compression);
+    centroids = new Centroid[centroidCapacity];
+    buffer = new Centroid[bufferCapacity];
+}
+
+TDigest::~TDigest() {
+    delete[] centroids;
+    delete[] buffer;
+}
+
+TDigest::TDigest(const TDigest& other)
+    : compression(other.compression), centroidCount(other.centroidCount), centroidCapacity(other.centroidCapacity),
+      bufferCount(other.bufferCount), bufferCapacity(other.bufferCapacity), totalWeight(other.totalWeight),
+      valueCount(other.valueCount), minValue(other.minValue), maxValue(other.maxValue) {
+    centroids = new Centroid[centroidCapacity];
+    buffer = new Centroid[bufferCapacity];
+    for (int i = 0; i < centroidCount; i++) centroids[i] = other.centroids[i];
+    for (int i = 0; i < bufferCount; i++) buffer[i] = other.buffer[i];
+}
+
+TDigest& TDigest::operator=(const TDigest& other) {
+    if (this == &other) return *this;
+
+    Centroid* newCentroids = new Centroid[other.centroidCapacity];
+    Centroid* newBuffer = new Centroid[other.bufferCapacity];
+    for (int i = 0; i < other.centroidCount; i++) newCentroids[i] = other.centroids[i];
+    for (int i = 0; i < other.bufferCount; i++) newBuffer[i] = other.buffer[i];
+    delete[] centroids;
+    delete[] buffer;
+
+    centroids = newCentroids;
+    buffer = newBuffer;
+    compression = other.compression;
+    centroidCount = other.centroidCount;
+    centroidCapacity = other.centroidCapacity;
+    bufferCount = other.bufferCount;
+    bufferCapacity = other.bufferCapacity;
+    totalWeight = other.totalWeight;
+    valueCount = other.valueCount;
+    minValue = other.minValue;
+    maxValue = other.maxValue;
+    return *this;
+}
+
+// k1 scale function: a centroid may span at most one unit of k, units are narrow near the tails
+double TDigest::scale(double q) const {
+    if (q <= 0.0) q = 0.0;
+    if (q >= 1.0) q = 1.0;
+    return compression / (2.0 * TDIGEST_PI) * std::asin(2.0 * q - 1.0);
+}
+
+// Bottom-up merge sort, stable so equal means keep their order
+void TDigest::sortByMean(Centroid* items, int count, Centroid* temp) {
+    for (int runLength = 1; runLength < count; runLength *= 2) {
+        for (int left = 0; left < count - runLength; left += 2 * runLength) {
+            const int middle = left + runLength;
+            const int right = middle + runLength < count ? middle + runLength : count;
+            int i = left, j = middle, k = left;
+            while (i < middle && j < right) {
+                temp[k++] = items[j].mean < items[i].mean ? items[j++] : items[i++];
+            }
+            while (i < middle) temp[k++] = items[i++];
+            while (j < right) temp[k++] = items[j++];
+            for (k = left; k < right; k++) items[k] = temp[k];
+        }
+    }
+}
+
+void TDigest::append(double mean, double weight) {
+    if (bufferCount == bufferCapacity) compress();
+    buffer[bufferCount++] = Centroid{mean, weight};
+}
+
+void TDigest::add(double value) {
+    if (valueCount == 0 || value < minValue) minValue = value;
+    if (valueCount == 0 || value > maxValue) maxValue = value;
+    valueCount++;
+    append(value, 1.0);
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.valueCount == 0) return;
+
+    if (valueCount == 0 || other.minValue < minValue) minValue = other.minValue;
+    if (valueCount == 0 || other.maxValue > maxValue) maxValue = other.maxValue;
+    valueCount += other.valueCount;
+
+    for (int i = 0; i < other.centroidCount; i++) append(other.centroids[i].mean, other.centroids[i].weight);
+    for (int i = 0; i < other.bufferCount; i++) append(other.buffer[i].mean, other.buffer[i].weight);
+}
+
+// Sorts the centroids and the buffer together and greedily merges neighbours within one k unit
+void TDigest::compress() {
+    if (bufferCount == 0) return;
+
+    const int total = centroidCount + bufferCount;
+    Centroid* items = new Centroid[total];
+    Centroid* temp = new Centroid[total];
+    for (int i = 0; i < centroidCount; i++) items[i] = centroids[i];
+    for (int i = 0; i < bufferCount; i++) items[centroidCount + i] = buffer[i];
+    sortByMean(items, total, temp);
+
+    double weight = 0.0;
+    for (int i = 0; i < total; i++) weight += items[i].weight;
+
+    centroidCount = 0;
+    double weightBefore = 0.0; // Weight of the centroids already emitted
+    Centroid current = items[0];
+    double kLimit = scale(0.0) + 1.0;
+    for (int i = 1; i < total; i++) {
+        const double q = (weightBefore + current.weight + items[i].weight) / weight;
+        if (scale(q) <= kLimit || centroidCount == centroidCapacity - 1) {
+            current.weight += items[i].weight;
+            current.mean += (items[i].mean - current.mean) * items[i].weight / current.weight;
+        } else {
+            centroids[centroidCount++] = current;
+            weightBefore += current.weight;
+            kLimit = scale(weightBefore / weight) + 1.0;
+            current = items[i];
+        }
+    }
+    centroids[centroidCount++] = current;
+
+    totalWeight = weight;
+    bufferCount = 0;
+    delete[] items;
+    delete[] temp;
+}
+
+// Interpolates between centroid centers, with the exact min and max as the outer anchors
+double TDigest::quantile(double q) {
+    if (valueCount == 0) return 0.0;
+    compress();
+    if (q <= 0.0) return minValue;
+    if (q >= 1.0) return maxValue;
+    if (centroidCount == 1) return centroids[0].mean;
+
+    const double index = q * totalWeight;
+    double result;
+
+    double center = centroids[0].weight / 2.0;
+    if (index < center) {
+        result = minValue + (centroids[0].mean - minValue) * (index / center);
+    } else {
+        bool between = false;
+        for (int i = 0; i + 1 < centroidCount; i++) {
+            const double nextCenter = center + (centroids[i].weight + centroids[i + 1].weight) / 2.0;
+            if (index < nextCenter) {
+                const double t = (index - center) / (nextCenter - center);
+                result = centroids[i].mean + t * (centroids[i + 1].mean - centroids[i].mean);
+                between = true;
+                break;
+            }
+            center = nextCenter;
+        }
+        if (!between) {
+            // Past the last center, head towards the maximum
+            const double halfLast = centroids[centroidCount - 1].weight / 2.0;
+            const double t = halfLast > 0.0 ? (index - center) / halfLast : 1.0;
+            result = centroids[centroidCount - 1].mean;
+            result += (maxValue - result) * (t > 1.0 ? 1.0 : t);
+        }
+    }
+
+    if (result < minValue) result = minValue;
+    if (result > maxValue) result = maxValue;
+    return result;
+}
@@ -0,0 +1,72 @@
+#ifndef TDIGEST_HPP
+#define TDIGEST_HPP
+
+#define TDIGEST_COMPRESSION 100 // Higher keeps more centroids, tails stay accurate to about 1/compression
+
+/**
+ * @brief Mergeable streaming quantile sketch (merging t-digest)
+ *
+ * @details
+ * - Values are clustered into weighted centroids. Centroids near the median may hold many values,
+ *   centroids near q = 0 and q = 1 stay small (arcsine scale function), so p99 remains accurate
+ * - add() appends to a small buffer, a full buffer is sorted and merged into the centroids.
+ *   Memory is fixed at construction whatever the number of values
+ * - Two digests merge into one that summarizes both streams, per-group digests can be combined
+ *   into totals without seeing the values again
+ * - count(), min() and max() are exact
+ *
+ * @usage
+ *      TDigest latency;
+ *      latency.add(12.5);
+ *      double p90 = latency.quantile(0.90);
+ *      total.merge(latency);
+ */
+class TDigest {
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    double compression;
+    Centroid* centroids;
+    int centroidCount;
+    int centroidCapacity;
+    Centroid* buffer;       /// Values added since the last compress()
+    int bufferCount;
+    int bufferCapacity;
+    double totalWeight;     /// Weight of the centroids, the buffer excluded
+    long long valueCount;
+    double minValue;
+    double maxValue;
+
+    void compress();
+    void append(double mean, double weight);
+    double scale(double q) const;
+    static void sortByMean(Centroid* items, int count, Centroid* temp);
+
+public:
+    explicit TDigest(double compressionFactor = TDIGEST_COMPRESSION);
+    ~TDigest();
+
+    TDigest(const TDigest& other);
+    TDigest& operator=(const TDigest& other);
+
+    void add(double value);
+
+    /**
+     * @brief Folds another digest into this one
+     */
+    void merge(const TDigest& other);
+
+    /**
+     * @brief Estimated value at quantile q (0..1), 0 for an empty digest
+     */
+    double quantile(double q);
+
+    long long count() const { return valueCount; }
+    double min() const { return minValue; }
+    double max() const { return maxValue; }
+};
+
+#endif // TDIGEST_HPP
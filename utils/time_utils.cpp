@@ -85,3 +85,37 @@ bool isDateExpiringSoon(const std::string& expiryDate, int days) {
     // Check if the expiry date is in the future and within the specified number of days
     return difference_days >= 0 && difference_days <= days;
 }
+
+long long parseDatetime(const std::string& datetime) {
+    std::tm tm = {};
+    std::istringstream ss(datetime);
+    ss >> std::get_time(&tm, "%Y-%m-%d");
+    if (ss.fail()) {
+        return -1;
+    }
+    ss >> std::ws;
+    if (!ss.eof()) {
+        ss >> std::get_time(&tm, "%H:%M");
+        if (ss.fail()) {
+            return -1;
+        }
+    }
+
+    tm.tm_isdst = -1; // Let mktime work out daylight saving time
+    const std::time_t t = std::mktime(&tm);
+    return t == static_cast<std::time_t>(-1) ? -1 : static_cast<long long>(t);
+}
+
+std::string formatDatetime(long long epochSeconds) {
+    const std::time_t t = static_cast<std::time_t>(epochSeconds);
+    std::tm tmStruct{};
+#ifdef _WIN32
+    localtime_s(&tmStruct, &t);
+#else
+    localtime_r(&t, &tmStruct);
+#endif
+
+    std::ostringstream oss;
+    oss << std::put_time(&tmStruct, "%Y-%m-%d %H:%M");
+    return oss.str();
+}
@@ -31,4 +31,16 @@ bool isDateExpired(const std::string& expiryDate);
  */
 bool isDateExpiringSoon(const std::string& expiryDate, int days);
 
+/**
+ * @brief Parses a local "YYYY-MM-DD HH:MM" datetime into seconds since the epoch
+ * @param datetime The datetime string, a date alone ("YYYY-MM-DD") means midnight
+ * @return Seconds since the epoch, or -1 if the string is not a valid datetime
+ */
+long long parseDatetime(const std::string& datetime);
+
+/**
+ * @brief Formats seconds since the epoch as a local "YYYY-MM-DD HH:MM" datetime
+ */
+std::string formatDatetime(long long epochSeconds);
+
 #endif // TIME_UTILS_HPP